@@ -15,7 +15,8 @@ from Basilisk.architecture.swig_common_model import *
 
 %feature("director") SysModel;
 %feature("pythonappend") SysModel::SysModel %{
-    self.__super_init_called__ = True%}
+    self.__super_init_called__ = True
+    self.requiresPython = True%}
 %rename("_SysModel") SysModel;
 %include "sys_model.i"
 
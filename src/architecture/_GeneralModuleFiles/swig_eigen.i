@@ -441,6 +441,12 @@ void fillPyObjList<Eigen::Quaterniond>(PyObject *input, const Eigen::Quaterniond
     if (PyErr_Occurred()) SWIG_fail;
 }
 
+%typemap(out, fragment="fillPyObjList") const type & {
+    $result = PyList_New(0);
+    fillPyObjList<type>($result, *$1);
+    if (PyErr_Occurred()) SWIG_fail;
+}
+
 %typemap(out, fragment="fillPyObjList") type * {
     if(!($1))
     {
@@ -50,6 +50,7 @@ public:
     uint64_t CallCounts = 0;       //!< -- Counts on the model being called
     uint32_t RNGSeed = 0x1badcad1; //!< -- Giving everyone a random seed for ease of MC
     int64_t moduleID;              //!< -- Module ID for this module  (handed out by module_id_generator)
+    bool requiresPython = false;   //!< -- Flag indicating that the module is implemented in Python
 };
 
 // The following code helps users who defined their own module classes
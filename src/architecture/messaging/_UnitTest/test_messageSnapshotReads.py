@@ -0,0 +1,78 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+from Basilisk.architecture import messaging
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def test_messageWriteCount():
+    """
+    testing the write count and the snapshot reads of a C++ message
+    """
+    msg = messaging.CModuleTemplateMsg()
+    reader = msg.addSubscriber()
+    assert reader.writeCount() == 0
+
+    payload = messaging.CModuleTemplateMsgPayload()
+    payload.dataVector = [1., 2., 3.]
+    msg.write(payload)
+    msg.write(payload)
+    assert reader.writeCount() == 2
+
+    reader.setSnapshotReads(True)
+    assert reader.snapshotReadsEnabled()
+    assert reader().dataVector == [1., 2., 3.]
+
+
+def test_messageSnapshotReadsAcrossThreads():
+    """
+    testing a message written on one simulation thread and read with snapshot reads on another
+    """
+    scSim = SimulationBaseClass.SimBaseClass()
+    writerProcess = scSim.CreateNewProcess("writerProcess")
+    writerProcess.addTask(scSim.CreateNewTask("writerTask", macros.sec2nano(1.)))
+    readerProcess = scSim.CreateNewProcess("readerProcess")
+    readerProcess.addTask(scSim.CreateNewTask("readerTask", macros.sec2nano(1.)))
+
+    writer = cppModuleTemplate.CppModuleTemplate()
+    writer.ModelTag = "writer"
+    scSim.AddModelToTask("writerTask", writer)
+
+    reader = cppModuleTemplate.CppModuleTemplate()
+    reader.ModelTag = "reader"
+    reader.dataInMsg.setSnapshotReads(True)
+    reader.dataInMsg.subscribeTo(writer.dataOutMsg)
+    scSim.AddModelToTask("readerTask", reader)
+    assert reader.dataInMsg.snapshotReadsEnabled()
+
+    # the two processes are assigned to the two threads in a round-robin fashion
+    scSim.TotalSim.resetThreads(2)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(10.))
+    scSim.ExecuteSimulation()
+
+    # the writer updates at t = 0, 1, ..., 10 s
+    assert reader.dataInMsg.writeCount() == 11
+
+
+if __name__ == "__main__":
+    test_messageWriteCount()
+    test_messageSnapshotReadsAcrossThreads()
@@ -0,0 +1,102 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+
+import numpy as np
+from Basilisk.architecture import messaging
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def setupSimulation(recordColumns):
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("dynamicsProcess")
+    proc.addTask(scSim.CreateNewTask("dynamicsTask", macros.sec2nano(1.)))
+
+    module = cppModuleTemplate.CppModuleTemplate()
+    module.ModelTag = "cppModule"
+    scSim.AddModelToTask("dynamicsTask", module)
+
+    recorder = module.dataOutMsg.recorder()
+    if recordColumns:
+        recorder.addColumn("dataVector")
+    scSim.AddModelToTask("dynamicsTask", recorder)
+
+    scSim.InitializeSimulation()
+    return scSim, recorder
+
+
+def test_recorderColumns():
+    """
+    testing that a column recorder stores the same samples as a complete payload recorder
+    """
+    stopTime = macros.sec2nano(20.)
+    scSim, recorder = setupSimulation(recordColumns=True)
+    recorder.reserveUntil(stopTime)
+    scSim.ConfigureStopTime(stopTime)
+    scSim.ExecuteSimulation()
+
+    referenceSim, reference = setupSimulation(recordColumns=False)
+    referenceSim.ConfigureStopTime(stopTime)
+    referenceSim.ExecuteSimulation()
+
+    dataVector = recorder.column("dataVector")
+    assert dataVector.shape == (21, 3)
+    assert dataVector.dtype == np.float64
+    np.testing.assert_array_equal(dataVector, reference.dataVector)
+    np.testing.assert_array_equal(recorder.dataVector, reference.dataVector)
+    np.testing.assert_array_equal(recorder.times(), reference.times())
+
+    # all samples fit in the reserved block, so the array is a view of the recorder memory
+    assert np.shares_memory(dataVector, recorder.column("dataVector"))
+
+    # unreserved samples are stored in new blocks and concatenated
+    recorder.setBlockSamples(4)
+    scSim.ConfigureStopTime(macros.sec2nano(30.))
+    scSim.ExecuteSimulation()
+    np.testing.assert_array_equal(recorder.column("dataVector")[:, 0], np.arange(1., 32.))
+
+    # the exported view owns its block, so it stays valid after the recorder is cleared and destroyed
+    recorder.clear()
+    assert recorder.column("dataVector").shape == (0, 3)
+    np.testing.assert_array_equal(dataVector[:, 0], np.arange(1., 22.))
+    del scSim, recorder
+    np.testing.assert_array_equal(dataVector[:, 0], np.arange(1., 22.))
+
+
+def test_recorderColumnErrors():
+    """
+    testing the fields that cannot be recorded column-wise
+    """
+    recorder = messaging.CModuleTemplateMsg().recorder()
+    try:
+        recorder.addColumn("notAField")
+        assert False, "addColumn should reject an unknown field"
+    except ValueError:
+        pass
+    try:
+        recorder.column("dataVector")
+        assert False, "column should reject a field that is not recorded"
+    except ValueError:
+        pass
+
+
+if __name__ == "__main__":
+    test_recorderColumns()
+    test_recorderColumnErrors()
@@ -23,6 +23,74 @@ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
 #include "architecture/utilities/bskLogging.h"
 #include <typeinfo>
 #include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <cstring>
+#include <memory>
+
+#ifndef SWIG
+/*! Returns the write sequence of a message header as an atomic counter */
+inline std::atomic<uint64_t>* msgWriteSequence(MsgHeader *header){
+    static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "atomic counter must fit the header field");
+    return reinterpret_cast<std::atomic<uint64_t>*>(&header->writeSequence);
+}
+
+/*! Marks the start of a message write.  The write sequence stays odd until endMsgWrite is called. */
+inline void beginMsgWrite(MsgHeader *header){
+    std::atomic<uint64_t>* sequence = msgWriteSequence(header);
+    sequence->store(sequence->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+/*! Publishes a message write, making the new payload visible to snapshot readers on other threads */
+inline void endMsgWrite(MsgHeader *header){
+    std::atomic<uint64_t>* sequence = msgWriteSequence(header);
+    sequence->store(sequence->load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+/*! Copies a message payload that may be written concurrently by another thread.
+    The copy is retried until the write sequence is even and did not change during the copy,
+    so that the destination never holds a partially written payload.  This is a sequence lock:
+    writers never wait, but a reader spins while a write is in progress, so reads are not wait-free.
+    A double or triple buffer would not fit the messages, whose single payload is written in place
+    by the C and C++ write functors and read in place by the subscribers not using snapshots. */
+template<typename messageType>
+void readMsgSnapshot(MsgHeader *header, const messageType *source, messageType *destination){
+    std::atomic<uint64_t>* sequence = msgWriteSequence(header);
+    while (true) {
+        uint64_t before = sequence->load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            *destination = *source;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence->load(std::memory_order_relaxed) == before) {
+                return;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+/*! Storage of the copy returned by snapshot reads.  The payload is only allocated when a snapshot
+    is first read, and copies of the buffer start empty, as it only holds the result of the last read. */
+template<typename messageType>
+class MsgSnapshotBuffer{
+private:
+    std::unique_ptr<messageType> payload;   //!< copy of the message payload, allocated on the first read
+public:
+    MsgSnapshotBuffer() = default;
+    MsgSnapshotBuffer(const MsgSnapshotBuffer&){};
+    MsgSnapshotBuffer& operator=(const MsgSnapshotBuffer&){return *this;};
+
+    //! return the payload copy, allocating it if needed
+    messageType* get(){
+        if (!this->payload) {
+            this->payload = std::make_unique<messageType>();
+        }
+        return this->payload.get();
+    };
+};
+#endif
 
 /*! forward-declare sim message for use by read functor */
 template<typename messageType>
@@ -38,6 +106,10 @@ private:
     messageType* payloadPointer;    //!< -- pointer to the incoming msg data
     MsgHeader *headerPointer;      //!< -- pointer to the incoming msg header
     bool initialized;               //!< -- flag indicating if the input message is connect to another message
+    bool snapshotReads = false;     //!< -- flag indicating if reads copy a consistent snapshot of the message
+#ifndef SWIG
+    MsgSnapshotBuffer<messageType> snapshotPayload; //!< -- copy of the message payload returned by snapshot reads
+#endif
 
 public:
     //!< -- BSK Logging
@@ -57,6 +129,11 @@ public:
             messageType var;
             bskLogger.bskLog(BSK_ERROR, "In C++ read functor, you are trying to read an un-connected message of type %s\nThis program is about to self destruct.",  typeid(var).name());
         }
+        if (this->snapshotReads) {
+            messageType* snapshot = this->snapshotPayload.get();
+            readMsgSnapshot(this->headerPointer, this->payloadPointer, snapshot);
+            return *snapshot;
+        }
         return *this->payloadPointer;
 
     };
@@ -64,6 +141,22 @@ public:
     //! check if this msg has been connected to
     bool isLinked(){return this->initialized;};  // something that can be checked so that uninitialized messages aren't read.
 
+    //! read the message through a private snapshot, so that a message written by a process on another thread is never read while partially written
+    void setSnapshotReads(bool enable){this->snapshotReads = enable;};
+
+    //! check if the message is read through a private snapshot
+    bool snapshotReadsEnabled(){return this->snapshotReads;};
+
+    //! return the number of times the message has been written
+    uint64_t writeCount(){
+        if (!this->initialized) {
+            messageType var;
+            bskLogger.bskLog(BSK_ERROR, "In C++ read functor, you are requesting the write count of an unconnected msg of type %s.", typeid(var).name());
+            return 0;
+        }
+        return msgWriteSequence(this->headerPointer)->load(std::memory_order_acquire) / 2;
+    };
+
     //! check if the message has been ever written to
     bool isWritten(){
         if (this->initialized) {
@@ -118,7 +211,9 @@ public:
 
     //! Subscribe to a C++ message
     void subscribeTo(Message<messageType> *source){
+        bool snapshotReads = this->snapshotReads;
         *this = source->addSubscriber();
+        this->snapshotReads = snapshotReads;
         this->initialized = true;
     };
 
@@ -161,10 +256,12 @@ public:
     WriteFunctor(messageType* payloadPointer, MsgHeader *headerPointer) : payloadPointer(payloadPointer), headerPointer(headerPointer){};
     //! write functor constructor
     void operator()(messageType *payload, int64_t moduleID, uint64_t callTime){
+        beginMsgWrite(this->headerPointer);
         *this->payloadPointer = *payload;
         this->headerPointer->isWritten = 1;
         this->headerPointer->timeWritten = callTime;
         this->headerPointer->moduleID = moduleID;
+        endMsgWrite(this->headerPointer);
         return;
     }
 };
@@ -231,6 +328,76 @@ messageType* Message<messageType>::getMsgPointers(MsgHeader **msgPtr){
     return &this->payload;
 }
 
+/*! One storage block of a recorder column shared with Python.
+    The block memory is freed once the recorder and every handle to the block are gone. */
+class RecorderColumnBlock{
+public:
+    RecorderColumnBlock() = default;                    //!< constructor
+#ifndef SWIG
+    //! constructor
+    explicit RecorderColumnBlock(std::shared_ptr<std::vector<char>> data) : data(std::move(data)){};
+#endif
+
+    //! return the address of the block memory
+    uint64_t getAddress() const {return this->data ? (uint64_t) (uintptr_t) this->data->data() : 0;};
+
+private:
+#ifndef SWIG
+    std::shared_ptr<std::vector<char>> data;            //!< block memory
+#endif
+};
+
+#ifndef SWIG
+/*! One payload field recorded column-wise by a Recorder.
+    The samples are stored in blocks that are never reallocated, so that the memory of a
+    block can be shared with Python (numpy) arrays while recording continues. */
+class RecorderColumn{
+public:
+    //! constructor
+    RecorderColumn(const std::string& name, size_t offset, size_t size) : name(name), offset(offset), size(size){};
+
+    //! copy the field of a payload into the column
+    void append(const void* payload, size_t blockSamples){
+        if (this->blocks.empty() || this->blockLengths.back() == this->blockCapacities.back()) {
+            this->addBlock(blockSamples);
+        }
+        std::memcpy(this->blocks.back()->data() + this->blockLengths.back() * this->size,
+                    static_cast<const char*>(payload) + this->offset, this->size);
+        this->blockLengths.back()++;
+    };
+
+    //! make sure that the next numberSamples samples are stored contiguously, without allocating
+    void reserve(size_t numberSamples){
+        size_t available = this->blocks.empty() ? 0 : this->blockCapacities.back() - this->blockLengths.back();
+        if (available < numberSamples) {
+            this->addBlock(numberSamples);
+        }
+    };
+
+    //! drop all samples.  Blocks still shared with Python are freed when their last array is gone
+    void clear(){
+        this->blocks.clear();
+        this->blockLengths.clear();
+        this->blockCapacities.clear();
+    };
+
+    std::string name;                           //!< name of the payload field
+    size_t offset;                              //!< [bytes] offset of the field in the payload
+    size_t size;                                //!< [bytes] size of the field
+    std::vector<std::shared_ptr<std::vector<char>>> blocks; //!< sample storage, one contiguous array per block
+    std::vector<size_t> blockLengths;           //!< number of samples stored in each block
+    std::vector<size_t> blockCapacities;        //!< number of samples that fit in each block
+
+private:
+    //! start a new block
+    void addBlock(size_t numberSamples){
+        this->blocks.push_back(std::make_shared<std::vector<char>>(numberSamples * this->size));
+        this->blockLengths.push_back(0);
+        this->blockCapacities.push_back(numberSamples);
+    };
+};
+#endif
+
 /*! Keep a time history of messages accessible to users from python */
 template<typename messageType>
 class Recorder : public SysModel{
@@ -278,15 +445,20 @@ public:
         if (CurrentSimNanos >= this->nextUpdateTime) {
             this->msgRecordTimes.push_back(CurrentSimNanos);
             this->msgWrittenTimes.push_back(this->readMessage.timeWritten());
-            this->msgRecord.push_back(this->readMessage());
+            if (this->columns.empty()) {
+                this->msgRecord.push_back(this->readMessage());
+            } else {
+                const messageType& payload = this->readMessage();
+                for (auto& column : this->columns) {
+                    column.append(&payload, this->blockSamples);
+                }
+            }
             this->nextUpdateTime += this->timeInterval;
         }
     };
     //! Reset method
     void Reset(uint64_t CurrentSimNanos){
-        this->msgRecord.clear();    //!< -- Can only reset to 0 for now
-        this->msgRecordTimes.clear();
-        this->msgWrittenTimes.clear();
+        this->clear();    //!< -- Can only reset to 0 for now
         this->nextUpdateTime = CurrentSimNanos;
     };
     //! time recorded method
@@ -320,8 +492,76 @@ public:
         this->msgRecord.clear();
         this->msgRecordTimes.clear();
         this->msgWrittenTimes.clear();
+        for (auto& column : this->columns) {
+            column.clear();
+        }
+    };
+
+    //! preallocate the storage of the next numberSamples samples
+    void reserve(size_t numberSamples){
+        this->msgRecordTimes.reserve(this->msgRecordTimes.size() + numberSamples);
+        this->msgWrittenTimes.reserve(this->msgWrittenTimes.size() + numberSamples);
+        if (this->columns.empty()) {
+            this->msgRecord.reserve(this->msgRecord.size() + numberSamples);
+        }
+        for (auto& column : this->columns) {
+            column.reserve(numberSamples);
+        }
+    };
+
+    //! preallocate the storage of all samples recorded until the given stop time.  Requires a non-zero time interval
+    void reserveUntil(uint64_t stopTimeNanos){
+        if (this->timeInterval == 0) {
+            bskLogger.bskLog(BSK_WARNING, "Recorder %s cannot compute its number of samples without a time interval, use reserve() instead.", this->ModelTag.c_str());
+            return;
+        }
+        if (stopTimeNanos >= this->nextUpdateTime) {
+            this->reserve((stopTimeNanos - this->nextUpdateTime) / this->timeInterval + 1);
+        }
     };
 
+    //! record the payload field of the given byte offset and size column-wise.  Once a column is added, complete payloads are no longer recorded
+    void addColumn(const std::string& name, size_t offset, size_t size){
+        if (this->getColumnIndex(name) >= 0) {
+            return;
+        }
+        if (offset + size > sizeof(messageType)) {
+            bskLogger.bskLog(BSK_ERROR, "Recorder %s: column %s does not fit in the message payload.", this->ModelTag.c_str(), name.c_str());
+            return;
+        }
+        this->columns.emplace_back(name, offset, size);
+    };
+
+    //! return the index of the column of the given name, or -1 if the field is not recorded column-wise
+    int64_t getColumnIndex(const std::string& name){
+        for (size_t i = 0; i < this->columns.size(); i++) {
+            if (this->columns[i].name == name) {
+                return (int64_t) i;
+            }
+        }
+        return -1;
+    };
+
+    //! return the number of columns
+    size_t getColumnCount(){return this->columns.size();};
+
+    //! return the size in bytes of one sample of a column
+    size_t getColumnSampleSize(size_t column){return this->columns.at(column).size;};
+
+    //! return the number of storage blocks of a column
+    size_t getColumnBlockCount(size_t column){return this->columns.at(column).blocks.size();};
+
+    //! return the number of samples stored in a block of a column
+    size_t getColumnBlockLength(size_t column, size_t block){return this->columns.at(column).blockLengths.at(block);};
+
+    //! return a handle to a block of a column.  The block memory stays valid as long as the handle exists
+    RecorderColumnBlock getColumnBlock(size_t column, size_t block){
+        return RecorderColumnBlock(this->columns.at(column).blocks.at(block));
+    };
+
+    //! set the number of samples of each storage block allocated when a column is full
+    void setBlockSamples(size_t numberSamples){this->blockSamples = numberSamples > 0 ? numberSamples : 1;};
+
     BSKLogger bskLogger;                          //!< -- BSK Logging
 
     //! method to update the minimum time interval before recording the next message
@@ -335,9 +575,13 @@ private:
     std::vector<uint64_t> msgWrittenTimes;        //!< vector of times at which messages are written
     uint64_t nextUpdateTime = 0;                  //!< [ns] earliest time at which the msg is recorded again
     uint64_t timeInterval;                        //!< [ns] recording time intervale
+    size_t blockSamples = 4096;                   //!< number of samples of each column block allocated without reservation
 
 private:
     ReadFunctor<messageType> readMessage;   //!< method description
+#ifndef SWIG
+    std::vector<RecorderColumn> columns;    //!< payload fields recorded column-wise
+#endif
 };
 
 #endif
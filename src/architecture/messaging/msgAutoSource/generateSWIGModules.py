@@ -1,5 +1,64 @@
+import os
+import re
 import sys
 
+# numpy type codes of the payload field types that can be recorded column-wise or read by events
+fieldTypeCodes = {
+    'double': 'f8', 'float': 'f4',
+    'int': 'i4', 'unsigned int': 'u4',
+    'int8_t': 'i1', 'uint8_t': 'u1', 'int16_t': 'i2', 'uint16_t': 'u2',
+    'int32_t': 'i4', 'uint32_t': 'u4', 'int64_t': 'i8', 'uint64_t': 'u8',
+}
+
+
+def parsePayloadFields(headerPath, payloadName):
+    """Returns the name, numpy type code and shape of the numeric fields of a payload.
+
+    The shape is None when an array dimension is not a literal or a macro defined in the header.
+    """
+    if not os.path.isfile(headerPath):
+        headerPath = os.path.join('..', headerPath)
+    if not os.path.isfile(headerPath):
+        return []
+    with open(headerPath, 'r') as headerFile:
+        text = headerFile.read()
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.DOTALL)
+    text = re.sub(r'//.*', '', text)
+
+    macros = dict(re.findall(r'#define\s+(\w+)\s+(\d+)\s*$', text, flags=re.MULTILINE))
+    structMatch = re.search(r'typedef\s+struct\s*\w*\s*\{([^{}]*)\}\s*' + payloadName + r'\s*;', text)
+    if structMatch is None:
+        return []
+
+    fields = []
+    fieldPattern = r'^\s*(unsigned\s+int|\w+)\s+(\w+)\s*((?:\[\s*\w+\s*\])*)\s*;'
+    for fieldType, fieldName, dimensions in re.findall(fieldPattern, structMatch.group(1), flags=re.MULTILINE):
+        fieldType = ' '.join(fieldType.split())
+        if fieldType not in fieldTypeCodes:
+            continue
+        shape = []
+        for dimension in re.findall(r'\[\s*(\w+)\s*\]', dimensions):
+            dimension = macros.get(dimension, dimension)
+            if not dimension.isdigit():
+                shape = None
+                break
+            shape.append(int(dimension))
+        fields.append((fieldName, fieldTypeCodes[fieldType], None if shape is None else tuple(shape)))
+    return fields
+
+
+def generatePayloadFieldInfo(templateData, structType, fields):
+    """Fills the payload field template with the layout of the given payload fields."""
+    offsetCases = ''.join('    if (name == "{0}") return offsetof({1}Payload, {0});\n'.format(name, structType)
+                          for name, _, _ in fields)
+    sizeCases = ''.join('    if (name == "{0}") return sizeof({1}Payload::{0});\n'.format(name, structType)
+                        for name, _, _ in fields)
+    fieldTypes = '{' + ', '.join('"{0}": ("{1}", {2})'.format(name, typeCode, shape)
+                                 for name, typeCode, shape in fields) + '}'
+    return templateData.format(type=structType, offsetCases=offsetCases, sizeCases=sizeCases,
+                               fieldTypes=fieldTypes)
+
+
 if __name__ == "__main__":
      moduleOutputPath = sys.argv[1]
      headerinputPath = sys.argv[2]
@@ -8,7 +67,8 @@ if __name__ == "__main__":
      generateCInfo = sys.argv[5] == 'True'
 
      swigTemplateFile = 'msgInterfacePy.i.in'
-     swigCTemplateFile = 'cMsgCInterfacePy.i.in'     
+     swigCTemplateFile = 'cMsgCInterfacePy.i.in'
+     swigFieldsTemplateFile = 'msgPayloadFieldsPy.i.in'
 
      swigFid = open(swigTemplateFile, 'r')
      swigTemplateData = swigFid.read()
@@ -18,10 +78,15 @@ if __name__ == "__main__":
      swigCTemplateData = swigCFid.read()
      swigCFid.close()
 
+     swigFieldsFid = open(swigFieldsTemplateFile, 'r')
+     swigFieldsTemplateData = swigFieldsFid.read()
+     swigFieldsFid.close()
+
      moduleFileOut = open(moduleOutputPath, 'w')
      moduleFileOut.write(swigTemplateData.format(type=structType, baseDir=baseDir))
      if(generateCInfo):
          moduleFileOut.write(swigCTemplateData.format(type=structType))
+         # only C payloads are plain structures whose field offsets are well defined
+         moduleFileOut.write(generatePayloadFieldInfo(swigFieldsTemplateData, structType,
+                                                      parsePayloadFields(headerinputPath, structType + 'Payload')))
      moduleFileOut.close()
-
-
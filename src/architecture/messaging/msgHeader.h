@@ -25,6 +25,7 @@ typedef struct {
     int64_t isWritten;      //!< flag if the message conntent has ever been written
     uint64_t timeWritten;   //!< [ns] time the message was written
     int64_t moduleID;       //!< ID of the module who wrote the message, negative value for Python module, non-negative for C/C++ modules
+    uint64_t writeSequence; //!< incremented before and after every write, odd while the message is being written
 }MsgHeader;
 
 #endif /* msgHeader_h */
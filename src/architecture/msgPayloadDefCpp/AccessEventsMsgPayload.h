@@ -0,0 +1,39 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef ACCESS_EVENTS_MSG_PAYLOAD_H
+#define ACCESS_EVENTS_MSG_PAYLOAD_H
+
+#include <vector>
+
+/*! @brief Message listing the starts and ends of the accesses between locations and spacecraft since the previous
+ * update, with one entry per event in each vector.
+ */
+typedef struct
+//@cond DOXYGEN_IGNORE
+AccessEventsMsgPayload
+//@endcond
+{
+    std::vector<int> locationIndex;    //!< [-] Index of the location of each event
+    std::vector<int> spacecraftIndex;  //!< [-] Index of the spacecraft of each event
+    std::vector<int> hasAccess;        //!< [-] 1 if the access starts at the event, 0 if it ends
+    std::vector<double> eventTimes;    //!< [s] Simulation time of each event
+}AccessEventsMsgPayload;
+
+#endif
@@ -25,6 +25,7 @@ from Basilisk.architecture import messaging
 
 import io
 import contextlib
+import threading
 
 import numpy as np
 
@@ -84,6 +85,71 @@ def test_PySysModel():
 
     assert testResults < 1, testMessage
 
+def test_PySysModelThreads():
+    """This method tests that Python modules are called with the Python interpreter lock from
+    the simulation threads, while other Python threads run during the C++ tasks"""
+
+    scSim = SimulationBaseClass.SimBaseClass()
+
+    # the Python module runs in its own process, which the simulation assigns to a second thread
+    cppProcess = scSim.CreateNewProcess("cppProcess")
+    cppProcess.addTask(scSim.CreateNewTask("cppTask", macros.sec2nano(0.01)))
+    pyProcess = scSim.CreateNewProcess("pyProcess")
+    pyProcess.addTask(scSim.CreateNewTask("pyTask", macros.sec2nano(1.)))
+
+    cppModules = []
+    for i in range(20):
+        mod = cppModuleTemplate.CppModuleTemplate()
+        mod.ModelTag = "cppModule" + str(i)
+        scSim.AddModelToTask("cppTask", mod)
+        cppModules.append(mod)
+
+    pyMod = CountingPythonModule()
+    pyMod.ModelTag = "pythonModule"
+    scSim.AddModelToTask("pyTask", pyMod)
+    recorder = cppModules[-1].dataOutMsg.recorder()
+    scSim.AddModelToTask("pyTask", recorder)
+
+    assert pyMod.requiresPython
+    assert not cppModules[0].requiresPython
+    assert scSim.TaskList[1].TaskData.requiresPython()
+    assert not scSim.TaskList[0].TaskData.requiresPython()
+
+    scSim.TotalSim.resetThreads(2)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(10.))
+
+    # a Python thread that counts while the simulation runs, and samples how many times the
+    # first C++ module was called.  ExecuteSimulation steps the simulation in a single
+    # StepUntilStop call, so a sample strictly between the first and the last call count
+    # was taken while StepUntilStop was running.
+    stop = threading.Event()
+    counter = [0]
+    initialCallCount = cppModules[0].CallCounts
+    callCountSamples = []
+    pyMod.counter = counter
+    def count():
+        while not stop.is_set():
+            counter[0] += 1
+            callCountSamples.append(cppModules[0].CallCounts)
+    countingThread = threading.Thread(target=count)
+    countingThread.start()
+
+    try:
+        scSim.ExecuteSimulation()
+    finally:
+        stop.set()
+        countingThread.join()
+
+    assert pyMod.CallCounts == 11
+    assert pyMod.resetCalled
+    assert len(recorder.times()) == 11
+    assert cppModules[0].CallCounts == 1001
+    # the Python thread kept running while the simulation executed the C++ tasks
+    assert pyMod.counterValues[-1] > pyMod.counterValues[0]
+    assert any(initialCallCount < callCount < 1001 for callCount in callCountSamples)
+
 def test_ErrorPySysModel():
     """This method tests that exceptions happening in Python module
     Reset and UpdateState are always printed to sys.stderr"""
@@ -142,6 +208,20 @@ class PythonModule(sysModel.SysModel):
         self.dataOutMsg.write(payload, CurrentSimNanos, self.moduleID)
         self.bskLogger.bskLog(bskLogging.BSK_INFORMATION, f"Python Module ID {self.moduleID} ran Update at {CurrentSimNanos*1e-9}s")
 
+class CountingPythonModule(sysModel.SysModel):
+
+    def __init__(self, *args):
+        super().__init__(*args)
+        self.resetCalled = False
+        self.counterValues = []
+        self.counter = [0]
+
+    def Reset(self, CurrentSimNanos):
+        self.resetCalled = True
+
+    def UpdateState(self, CurrentSimNanos):
+        self.counterValues.append(self.counter[0])
+
 class ErroringPythonModule(sysModel.SysModel):
 
     def Reset(self):
@@ -152,4 +232,5 @@ class ErroringPythonModule(sysModel.SysModel):
 
 if __name__ == "__main__":
     test_PySysModel()
+    test_PySysModelThreads()
     test_ErrorPySysModel()
\ No newline at end of file
@@ -0,0 +1,163 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+import pytest
+from Basilisk.architecture import sim_model
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def runEvents(eventMode):
+    """Runs two tasks with an event disabling the second task and a terminal event.  The events are
+    written as Python strings, as native events, or as Python events with native conditions."""
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process")
+    proc.addTask(scSim.CreateNewTask("task1", macros.sec2nano(1.0)))
+    proc.addTask(scSim.CreateNewTask("task2", macros.sec2nano(1.0)))
+
+    # the output dataVector[0] of the module template counts its calls
+    scSim.modA = cppModuleTemplate.CppModuleTemplate()
+    scSim.modA.ModelTag = "modA"
+    scSim.AddModelToTask("task1", scSim.modA)
+    modB = cppModuleTemplate.CppModuleTemplate()
+    modB.ModelTag = "modB"
+    scSim.AddModelToTask("task2", modB)
+    recB = modB.dataOutMsg.recorder()
+    scSim.AddModelToTask("task2", recB)
+
+    if eventMode == "python":
+        scSim.createNewEvent("disableTask2", macros.sec2nano(2.0), True,
+                             ["self.modA.dataOutMsg.read().dataVector[0] >= 5"],
+                             ["self.disableTask('task2')", "self.setEventActivity('stop', True)"])
+        scSim.createNewEvent("stop", macros.sec2nano(1.0), False,
+                             ["self.modA.dataOutMsg.read().dataVector[0] >= 9"], [], terminal=True)
+    elif eventMode == "native":
+        scSim.createNewEvent("stop", macros.sec2nano(1.0), False,
+                             [sim_model.messageCondition(scSim.modA.dataOutMsg, "dataVector[0] >= 9")],
+                             [], terminal=True)
+        scSim.createNewEvent("disableTask2", macros.sec2nano(2.0), True,
+                             [sim_model.messageCondition(scSim.modA.dataOutMsg, "dataVector[0] >= 5")],
+                             [scSim.taskActivityAction("task2", False), scSim.eventActivityAction("stop", True)])
+        # events created with native conditions and actions are checked by TotalSim
+        assert isinstance(scSim.eventMap["disableTask2"], sim_model.SimEvent)
+    else:
+        scSim.createNewEvent("disableTask2", macros.sec2nano(2.0), True,
+                             [sim_model.messageCondition(scSim.modA.dataOutMsg, "dataVector[0] >= 5")],
+                             ["self.disableTask('task2')", "self.setEventActivity('stop', True)"])
+        scSim.createNewEvent("stop", macros.sec2nano(1.0), False,
+                             [sim_model.messageCondition(scSim.modA.dataOutMsg, "dataVector[0] >= 9")],
+                             [], terminal=True)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(20.0))
+    scSim.ExecuteSimulation()
+
+    return (list(recB.times()), scSim.TotalSim.CurrentNanos,
+            scSim.eventMap["disableTask2"].occurCounter, scSim.eventMap["stop"].occurCounter)
+
+
+@pytest.mark.parametrize("eventMode", ["native", "mixed"])
+def test_simEvents(eventMode):
+    r"""
+    **Validation Test Description**
+
+    This unit test runs the same events written as Python strings and as native events checked by the
+    C++ simulation.  An event checked every 2 seconds disables a task and activates a terminal event
+    once the output of a module reaches a threshold.
+
+    **Test Parameters**
+
+    Args:
+        eventMode (str): ``native`` for native conditions and actions, ``mixed`` for native conditions
+            with Python actions
+
+    **Description of Variables Being Tested**
+
+    The times at which the disabled task ran, the termination time and the event counters must be
+    identical to the Python events.
+    """
+    truth = runEvents("python")
+    assert truth[0] == [macros.sec2nano(t) for t in range(5)]
+    assert truth[1] == macros.sec2nano(8.0)
+    assert runEvents(eventMode) == truth
+
+
+def runSelfReactivatingEvent(eventMode):
+    """Runs an event that reactivates itself, written as Python strings or as a native event, and
+    returns the number of times it occurred."""
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process")
+    proc.addTask(scSim.CreateNewTask("task", macros.sec2nano(1.0)))
+    scSim.mod = cppModuleTemplate.CppModuleTemplate()
+    scSim.mod.ModelTag = "mod"
+    scSim.AddModelToTask("task", scSim.mod)
+
+    if eventMode == "python":
+        scSim.createNewEvent("loop", macros.sec2nano(2.0), True,
+                             ["self.mod.dataOutMsg.read().dataVector[0] >= 0"],
+                             ["self.setEventActivity('loop', True)"])
+    else:
+        scSim.createNewEvent("loop", macros.sec2nano(2.0), True,
+                             [sim_model.messageCondition(scSim.mod.dataOutMsg, "dataVector[0] >= 0")], [])
+        scSim.eventMap["loop"].addAction(scSim.eventActivityAction("loop", True))
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(10.0))
+    scSim.ExecuteSimulation()
+
+    return scSim.eventMap["loop"].occurCounter
+
+
+def test_selfReactivatingEvent():
+    r"""
+    **Validation Test Description**
+
+    This unit test runs a native event whose action reactivates the event itself.  The action only
+    refers to the event, so the event does not keep itself alive.
+
+    **Description of Variables Being Tested**
+
+    The native event must occur as many times as the same event written as Python strings, which
+    is more than once.
+    """
+    truth = runSelfReactivatingEvent("python")
+    assert truth > 1
+    assert runSelfReactivatingEvent("native") == truth
+
+
+def test_messageCondition():
+    """
+    testing the parsing of native message conditions
+    """
+    mod = cppModuleTemplate.CppModuleTemplate()
+    payload = mod.dataOutMsg.zeroMsgPayload
+    payload.dataVector = [1.0, -2.0, 3.0]
+    mod.dataOutMsg.write(payload)
+
+    assert sim_model.messageCondition(mod.dataOutMsg, "dataVector[1] < -1.5").isTrue()
+    assert not sim_model.messageCondition(mod.dataOutMsg, "dataVector[2] != 3").isTrue()
+    assert sim_model.messageCondition(mod.dataOutMsg, "dataVector[0]==1.0").readValue() == 1.0
+    for expression in ["dataVector[3] > 0", "dataVector > 0", "notAField > 0", "dataVector[0] ~ 1"]:
+        with pytest.raises(ValueError):
+            sim_model.messageCondition(mod.dataOutMsg, expression)
+
+
+if __name__ == "__main__":
+    test_simEvents("native")
+    test_selfReactivatingEvent()
+    test_messageCondition()
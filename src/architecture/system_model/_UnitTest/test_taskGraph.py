@@ -0,0 +1,102 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+import numpy as np
+import pytest
+from Basilisk.architecture import bskLogging
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def runChainedProcesses(workerCount):
+    """Runs a set of processes whose modules are chained through messages. If workerCount is
+    ``None`` the default process-to-thread execution is used, otherwise the task graph is used."""
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    scSim = SimulationBaseClass.SimBaseClass()
+
+    numProcesses = 6
+    tasks = []
+    modules = []
+    recorders = []
+    for ii in range(numProcesses):
+        # earlier processes have a higher priority so they run first in the default execution
+        proc = scSim.CreateNewProcess("proc" + str(ii), numProcesses - ii)
+        taskName = "task" + str(ii)
+        task = scSim.CreateNewTask(taskName, macros.sec2nano(1.0 + ii % 2))
+        proc.addTask(task)
+        tasks.append(task)
+
+        modA = cppModuleTemplate.CppModuleTemplate()
+        modA.ModelTag = "modA" + str(ii)
+        modB = cppModuleTemplate.CppModuleTemplate()
+        modB.ModelTag = "modB" + str(ii)
+        modB.dataInMsg.subscribeTo(modA.dataOutMsg)
+        scSim.AddModelToTask(taskName, modA, 10)
+        scSim.AddModelToTask(taskName, modB, 5)
+        rec = modB.dataOutMsg.recorder()
+        scSim.AddModelToTask(taskName, rec, 1)
+        modules.append((modA, modB))
+        recorders.append(rec)
+
+    # process 1 reads the output of process 0
+    modules[1][0].dataInMsg.subscribeTo(modules[0][1].dataOutMsg)
+
+    if workerCount is not None:
+        scSim.TotalSim.enableTaskGraph(workerCount)
+        scSim.TotalSim.addTaskDependency(tasks[0].TaskData, tasks[1].TaskData)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(5.0))
+    scSim.ExecuteSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(10.0))
+    scSim.ExecuteSimulation()
+
+    return [(rec.times(), rec.dataVector) for rec in recorders], scSim.TotalSim.CurrentNanos
+
+
+@pytest.mark.parametrize("workerCount", [1, 2, 4])
+def test_taskGraph(workerCount):
+    r"""
+    **Validation Test Description**
+
+    This unit test runs the same set of processes with the default process-to-thread execution
+    and with the work-stealing task graph execution.  Modules inside a task are chained through
+    messages, and one task reads the output of a task of another process through an explicitly
+    declared task dependency.
+
+    **Test Parameters**
+
+    Args:
+        workerCount (int): number of workers executing the task graph
+
+    **Description of Variables Being Tested**
+
+    The recorded message times and values of every process, as well as the final simulation time,
+    must be identical between the two execution modes.
+    """
+    truthData, truthTime = runChainedProcesses(None)
+    graphData, graphTime = runChainedProcesses(workerCount)
+
+    assert graphTime == truthTime
+    for (truthTimes, truthValues), (graphTimes, graphValues) in zip(truthData, graphData):
+        np.testing.assert_array_equal(graphTimes, truthTimes)
+        np.testing.assert_array_equal(graphValues, truthValues)
+
+
+if __name__ == "__main__":
+    test_taskGraph(4)
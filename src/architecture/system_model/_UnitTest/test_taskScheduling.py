@@ -0,0 +1,135 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+import random
+import time
+
+from Basilisk.architecture import sysModel
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+class CallLogger(sysModel.SysModel):
+    """Python module that logs the time and tag of each call"""
+    def __init__(self, callLog, *args):
+        super().__init__(*args)
+        self.callLog = callLog
+
+    def UpdateState(self, CurrentSimNanos):
+        self.callLog.append((CurrentSimNanos, self.ModelTag))
+
+
+def referenceOrder(taskList, stopTime):
+    """Computes the task call order of the original linear search scheduler.  Tasks are
+    inserted in the list sorted by start time and priority, then each step calls the first
+    task of the list with the earliest start time and the highest priority."""
+    schedule = []
+    for name, period, priority in taskList:
+        start = 0
+        entry = [start, priority, period, name]
+        index = len(schedule)
+        for ii, other in enumerate(schedule):
+            if other[0] > start or (other[0] == start and priority > other[1]):
+                index = ii
+                break
+        schedule.insert(index, entry)
+
+    callLog = []
+    while True:
+        fire = schedule[0]
+        for entry in schedule:
+            if entry[0] < fire[0] or (entry[0] == fire[0] and entry[1] > fire[1]):
+                fire = entry
+        if fire[0] > stopTime:
+            return callLog
+        callLog.append((fire[0], fire[3]))
+        fire[0] += fire[2]
+
+
+def test_taskSchedulingOrder():
+    r"""
+    **Validation Test Description**
+
+    This unit test checks that the task calendar of a process calls its tasks in the same
+    order as a linear search of the task list: earliest start time first, then highest task
+    priority, then the order in which the tasks were inserted in the list.  Many tasks
+    share their period and priority so that every tie-breaking rule is used.
+    The period of one task is changed between two runs.
+    """
+    random.seed(7)
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process")
+
+    callLog = []
+    taskList = []
+    for ii in range(40):
+        name = "task" + str(ii)
+        period = macros.sec2nano(random.choice([0.5, 1.0, 1.5, 2.0]))
+        priority = random.choice([-1, 0, 5])
+        proc.addTask(scSim.CreateNewTask(name, period), priority)
+        module = CallLogger(callLog)
+        module.ModelTag = name
+        scSim.AddModelToTask(name, module)
+        taskList.append((name, period, priority))
+
+    scSim.InitializeSimulation()
+    stopTime = macros.sec2nano(10.0)
+    scSim.ConfigureStopTime(stopTime)
+    scSim.ExecuteSimulation()
+
+    assert callLog == referenceOrder(taskList, stopTime)
+
+    # changing a period moves the task in the calendar
+    callLog.clear()
+    proc.updateTaskPeriod("task3", macros.sec2nano(0.25))
+    scSim.ConfigureStopTime(macros.sec2nano(12.0))
+    scSim.ExecuteSimulation()
+    task3Times = [callTime for callTime, name in callLog if name == "task3"]
+    assert len(task3Times) > 1
+    assert all(t2 - t1 == macros.sec2nano(0.25) for t1, t2 in zip(task3Times, task3Times[1:]))
+    assert callLog == sorted(callLog, key=lambda call: call[0])
+
+
+def taskSchedulingBenchmark(taskCounts=(10, 100, 1000, 10000), callCount=200000):
+    """Measures the scheduling cost per task call of a process with the given numbers of
+    empty tasks at mixed rates.  The simulated time is chosen so that every process makes
+    about the same number of task calls."""
+    results = []
+    for taskCount in taskCounts:
+        scSim = SimulationBaseClass.SimBaseClass()
+        proc = scSim.CreateNewProcess("process")
+        periods = [macros.sec2nano(0.1 * (1 + ii % 8)) for ii in range(taskCount)]
+        for ii, period in enumerate(periods):
+            proc.addTask(scSim.CreateNewTask("task" + str(ii), period), ii % 3)
+        scSim.InitializeSimulation()
+
+        callsPerSecond = sum(1e9 / period for period in periods)
+        stopTime = macros.sec2nano(max(1.0, callCount / callsPerSecond))
+        scSim.ConfigureStopTime(stopTime)
+        startTime = time.perf_counter()
+        scSim.ExecuteSimulation()
+        elapsed = time.perf_counter() - startTime
+
+        calls = sum(stopTime // period + 1 for period in periods)
+        results.append((taskCount, calls, 1e9 * elapsed / calls))
+    return results
+
+
+if __name__ == "__main__":
+    test_taskSchedulingOrder()
+    for taskCount, calls, nanosPerCall in taskSchedulingBenchmark():
+        print(f"{taskCount:6d} tasks: {calls:8d} task calls, {nanosPerCall:8.1f} ns per call")
@@ -0,0 +1,227 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "sim_event.h"
+#include <cstring>
+#include <stdexcept>
+
+/*! The field condition constructor parses the type code and the comparison.
+ @param address Address of the variable
+ @param typeCode numpy type code of the variable, with an optional byte order character
+ @param comparison Comparison of the variable with the threshold
+ @param threshold Constant the variable is compared with
+ */
+FieldCondition::FieldCondition(uint64_t address, std::string typeCode, std::string comparison, double threshold)
+{
+    this->address = reinterpret_cast<const void *>(static_cast<uintptr_t>(address));
+    this->threshold = threshold;
+
+    //! - Drop the byte order character of numpy type strings such as "<f8"
+    if(!typeCode.empty() && (typeCode[0] == '<' || typeCode[0] == '>' || typeCode[0] == '=' || typeCode[0] == '|'))
+    {
+        typeCode = typeCode.substr(1);
+    }
+    if(typeCode == "f8") {this->valueType = ValueType::Float64;}
+    else if(typeCode == "f4") {this->valueType = ValueType::Float32;}
+    else if(typeCode == "i1") {this->valueType = ValueType::Int8;}
+    else if(typeCode == "u1") {this->valueType = ValueType::UInt8;}
+    else if(typeCode == "i2") {this->valueType = ValueType::Int16;}
+    else if(typeCode == "u2") {this->valueType = ValueType::UInt16;}
+    else if(typeCode == "i4") {this->valueType = ValueType::Int32;}
+    else if(typeCode == "u4") {this->valueType = ValueType::UInt32;}
+    else if(typeCode == "i8") {this->valueType = ValueType::Int64;}
+    else if(typeCode == "u8") {this->valueType = ValueType::UInt64;}
+    else
+    {
+        throw std::invalid_argument("FieldCondition: unsupported type code " + typeCode);
+    }
+
+    if(comparison == "<") {this->comparison = Comparison::Less;}
+    else if(comparison == "<=") {this->comparison = Comparison::LessEqual;}
+    else if(comparison == ">") {this->comparison = Comparison::Greater;}
+    else if(comparison == ">=") {this->comparison = Comparison::GreaterEqual;}
+    else if(comparison == "==") {this->comparison = Comparison::Equal;}
+    else if(comparison == "!=") {this->comparison = Comparison::NotEqual;}
+    else
+    {
+        throw std::invalid_argument("FieldCondition: unsupported comparison " + comparison);
+    }
+}
+
+/*! This method reads the variable and converts it to a double.
+ @return double Current value of the variable
+ */
+double FieldCondition::readValue() const
+{
+    switch(this->valueType)
+    {
+        case ValueType::Float64: {double value; std::memcpy(&value, this->address, sizeof(value)); return value;}
+        case ValueType::Float32: {float value; std::memcpy(&value, this->address, sizeof(value)); return value;}
+        case ValueType::Int8: {int8_t value; std::memcpy(&value, this->address, sizeof(value)); return value;}
+        case ValueType::UInt8: {uint8_t value; std::memcpy(&value, this->address, sizeof(value)); return value;}
+        case ValueType::Int16: {int16_t value; std::memcpy(&value, this->address, sizeof(value)); return value;}
+        case ValueType::UInt16: {uint16_t value; std::memcpy(&value, this->address, sizeof(value)); return value;}
+        case ValueType::Int32: {int32_t value; std::memcpy(&value, this->address, sizeof(value)); return value;}
+        case ValueType::UInt32: {uint32_t value; std::memcpy(&value, this->address, sizeof(value)); return value;}
+        case ValueType::Int64: {int64_t value; std::memcpy(&value, this->address, sizeof(value)); return (double) value;}
+        case ValueType::UInt64: {uint64_t value; std::memcpy(&value, this->address, sizeof(value)); return (double) value;}
+    }
+    return 0.0;
+}
+
+/*! This method compares the variable with the threshold.
+ @return bool Result of the comparison
+ */
+bool FieldCondition::isTrue()
+{
+    double value = this->readValue();
+    switch(this->comparison)
+    {
+        case Comparison::Less: return value < this->threshold;
+        case Comparison::LessEqual: return value <= this->threshold;
+        case Comparison::Greater: return value > this->threshold;
+        case Comparison::GreaterEqual: return value >= this->threshold;
+        case Comparison::Equal: return value == this->threshold;
+        case Comparison::NotEqual: return value != this->threshold;
+    }
+    return false;
+}
+
+/*! This method enables or disables the task.
+ @return void
+ */
+void TaskActivityAction::execute()
+{
+    if(this->enable)
+    {
+        this->task->enableTask();
+    }
+    else
+    {
+        this->task->disableTask();
+    }
+}
+
+/*! This method enables or disables all tasks of the process.
+ @return void
+ */
+void ProcessTasksActivityAction::execute()
+{
+    if(this->enable)
+    {
+        this->process->enableAllTasks();
+    }
+    else
+    {
+        this->process->disableAllTasks();
+    }
+}
+
+/*! This method activates or deactivates the event.
+ @return void
+ */
+void EventActivityAction::execute()
+{
+    if (std::shared_ptr<SimEvent> event = this->event.lock())
+    {
+        event->eventActive = this->active;
+    }
+}
+
+/*! The event constructor.  Events are created inactive.
+ @param eventName Identifier of the event
+ @param eventRate [ns] Time between two checks of the event
+ */
+SimEvent::SimEvent(std::string eventName, uint64_t eventRate)
+{
+    this->eventName = eventName;
+    this->eventRate = eventRate > 0 ? eventRate : 1;
+    this->eventActive = false;
+    this->terminal = false;
+    this->occurCounter = 0;
+    this->prevTime = -1;
+}
+
+/*! This method adds a condition to the event.
+ @return void
+ @param condition Condition that must be met for the event to occur
+ */
+void SimEvent::addCondition(std::shared_ptr<EventCondition> condition)
+{
+    this->conditionList.push_back(condition);
+}
+
+/*! This method adds an action to the event.
+ @return void
+ @param action Action executed when the event occurs
+ */
+void SimEvent::addAction(std::shared_ptr<EventAction> action)
+{
+    this->actionList.push_back(action);
+}
+
+/*! This method returns the earliest time at which the event must be checked.
+ @return uint64_t [ns] Next check time, 0 if the event was never checked, and the
+                  largest representable time if the event is not active
+ */
+uint64_t SimEvent::nextCheckTime() const
+{
+    if(!this->eventActive)
+    {
+        return ~((uint64_t) 0);
+    }
+    if(this->prevTime < 0)
+    {
+        return 0;
+    }
+    uint64_t prevNanos = (uint64_t) this->prevTime;
+    return prevNanos + this->eventRate - (prevNanos % this->eventRate);
+}
+
+/*! This method checks the event at the current simulation time.  The conditions are only
+    evaluated when the event is active and the time is a multiple of the event rate, or
+    when the event was never checked.  If all conditions are met, the event is deactivated
+    and its actions are executed.
+ @return bool Flag indicating that the event occurred
+ @param currentNanos [ns] Current simulation time
+ */
+bool SimEvent::checkEvent(uint64_t currentNanos)
+{
+    if(!this->eventActive || (this->prevTime >= 0 && currentNanos % this->eventRate != 0))
+    {
+        return false;
+    }
+    this->prevTime = (int64_t) currentNanos;
+    std::vector<std::shared_ptr<EventCondition>>::iterator condIt;
+    for(condIt = this->conditionList.begin(); condIt != this->conditionList.end(); condIt++)
+    {
+        if(!(*condIt)->isTrue())
+        {
+            return false;
+        }
+    }
+    this->eventActive = false;
+    std::vector<std::shared_ptr<EventAction>>::iterator actIt;
+    for(actIt = this->actionList.begin(); actIt != this->actionList.end(); actIt++)
+    {
+        (*actIt)->execute();
+    }
+    this->occurCounter++;
+    return true;
+}
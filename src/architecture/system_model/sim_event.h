@@ -0,0 +1,161 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _SimEvent_HH_
+#define _SimEvent_HH_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <stdint.h>
+#include "architecture/system_model/sys_model_task.h"
+#include "architecture/system_model/sys_process.h"
+
+//! Condition of a native simulation event, evaluated inside the simulation stepping loop
+class EventCondition
+{
+public:
+    virtual ~EventCondition() = default;
+    virtual bool isTrue() = 0; //!< Returns true if the condition is met
+};
+
+//! Action of a native simulation event, executed when all conditions of the event are met
+class EventAction
+{
+public:
+    virtual ~EventAction() = default;
+    virtual void execute() = 0; //!< Executes the action
+};
+
+/*! Condition comparing a numeric variable with a constant threshold.  The variable is
+    read directly from memory, typically a field of a message payload, and its type is
+    given by a numpy type code such as "f8" (double) or "i4" (int32_t).  The comparison
+    is one of "<", "<=", ">", ">=", "==" or "!=".  Both are parsed once, on construction.
+ */
+class FieldCondition : public EventCondition
+{
+public:
+    FieldCondition(uint64_t address, std::string typeCode, std::string comparison, double threshold);
+    bool isTrue() override;
+    double readValue() const; //!< Returns the current value of the variable
+
+public:
+    double threshold;  //!< -- Constant the variable is compared with
+
+private:
+    enum class ValueType {Float64, Float32, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64};
+    enum class Comparison {Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual};
+    const void *address;   //!< -- Address of the variable
+    ValueType valueType;   //!< -- Type of the variable
+    Comparison comparison; //!< -- Comparison with the threshold
+};
+
+#ifndef SWIG
+//! Condition evaluating a C++ callback
+class CallbackCondition : public EventCondition
+{
+public:
+    explicit CallbackCondition(std::function<bool()> callback) : callback(std::move(callback)) {} //!< Constructor
+    bool isTrue() override {return this->callback();} //!< Returns the result of the callback
+
+private:
+    std::function<bool()> callback;  //!< -- Callback evaluating the condition
+};
+
+//! Action executing a C++ callback
+class CallbackAction : public EventAction
+{
+public:
+    explicit CallbackAction(std::function<void()> callback) : callback(std::move(callback)) {} //!< Constructor
+    void execute() override {this->callback();} //!< Calls the callback
+
+private:
+    std::function<void()> callback;  //!< -- Callback executing the action
+};
+#endif
+
+//! Action enabling or disabling a task
+class TaskActivityAction : public EventAction
+{
+public:
+    TaskActivityAction(SysModelTask *task, bool enable) : task(task), enable(enable) {} //!< Constructor
+    void execute() override;
+
+private:
+    SysModelTask *task;  //!< -- Task to enable or disable
+    bool enable;         //!< -- Flag indicating if the task is enabled or disabled
+};
+
+//! Action enabling or disabling all tasks of a process
+class ProcessTasksActivityAction : public EventAction
+{
+public:
+    ProcessTasksActivityAction(SysProcess *process, bool enable) : process(process), enable(enable) {} //!< Constructor
+    void execute() override;
+
+private:
+    SysProcess *process;  //!< -- Process whose tasks are enabled or disabled
+    bool enable;          //!< -- Flag indicating if the tasks are enabled or disabled
+};
+
+class SimEvent;
+
+/*! Action activating or deactivating a native event.  The event is not kept alive by the
+    action, so that an event reactivating itself does not own itself.  The action does nothing
+    once the event was deleted.
+ */
+class EventActivityAction : public EventAction
+{
+public:
+    EventActivityAction(const std::shared_ptr<SimEvent>& event, bool active) : event(event), active(active) {} //!< Constructor
+    void execute() override;
+
+private:
+    std::weak_ptr<SimEvent> event;  //!< -- Event to activate or deactivate
+    bool active;                    //!< -- Flag indicating if the event is activated or deactivated
+};
+
+/*! Event checked by the simulation at a fixed rate without returning to Python.  It
+    follows the rules of the Python EventHandlerClass: an active event is checked when
+    the simulation time is a multiple of its rate, and when all of its conditions are
+    met it is deactivated and its actions are executed.  A terminal event also stops
+    the simulation.
+ */
+class SimEvent
+{
+public:
+    SimEvent(std::string eventName, uint64_t eventRate); //!< Constructor
+    void addCondition(std::shared_ptr<EventCondition> condition); //!< Adds a condition, all conditions must be met
+    void addAction(std::shared_ptr<EventAction> action); //!< Adds an action
+    uint64_t nextCheckTime() const;
+    bool checkEvent(uint64_t currentNanos);
+
+public:
+    std::string eventName;    //!< -- Identifier of the event
+    uint64_t eventRate;       //!< [ns] Time between two checks of the event
+    bool eventActive;         //!< -- Flag indicating if the event is checked
+    bool terminal;            //!< -- Flag indicating that the event stops the simulation
+    uint64_t occurCounter;    //!< -- Number of times the event occurred
+    int64_t prevTime;         //!< [ns] Time of the last check, negative if never checked
+    std::vector<std::shared_ptr<EventCondition>> conditionList;  //!< -- Conditions of the event
+    std::vector<std::shared_ptr<EventAction>> actionList;        //!< -- Actions of the event
+};
+
+#endif /* _SimEvent_HH_ */
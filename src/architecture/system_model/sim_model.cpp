@@ -177,9 +177,10 @@ void SimThreadExecution::StepUntilStop()
     }
 }
 
-/*! This method is currently vestigial and needs to be populated once the message
-    sharing process between different threads is handled.
-    TODO: Make this method move messages safely between threads
+/*! This method is currently vestigial.  Messages are not moved between threads:
+    every write increments the write sequence of the message header, and readers
+    in processes on other threads can enable snapshot reads to always read a
+    consistent copy of the message (see ReadFunctor::setSnapshotReads).
  @return void
  */
 void SimThreadExecution::moveProcessMessages() {
@@ -283,24 +284,131 @@ SimModel::SimModel()
     this->CurrentNanos = 0;
     this->NextTaskTime = 0;
     this->nextProcPriority = -1;
+    this->taskGraph = nullptr;
+    this->terminateSimulation = false;
 }
 
 /*! Nothing to destroy really */
 SimModel::~SimModel()
 {
     this->deleteThreads();
+    this->disableTaskGraph();
 }
 
 /*! This method steps the simulation until the specified stop time and
- stop priority have been reached.
+ stop priority have been reached.  The native events that are due are checked
+ along the way, each time the simulation reaches a multiple of their rate.  If a
+ terminal event occurs, the simulation stops early and terminateSimulation is set.
  @param SimStopTime Nanoseconds to step the simulation for
  @param stopPri The priority level below which the sim won't go
  @return void
  */
 void SimModel::StepUntilStop(uint64_t SimStopTime, int64_t stopPri)
+{
+    this->terminateSimulation = false;
+    while(true)
+    {
+        uint64_t eventTime = this->nextEventTime();
+        if(eventTime <= this->CurrentNanos)
+        {
+            this->checkEvents();
+            if(this->terminateSimulation)
+            {
+                return;
+            }
+            eventTime = this->nextEventTime();
+        }
+        //! - Step to the next event check, which is never before the next frame
+        uint64_t chunkStopTime = eventTime > this->NextTaskTime ? eventTime : this->NextTaskTime;
+        if(chunkStopTime >= SimStopTime)
+        {
+            this->stepProcessesUntilStop(SimStopTime, stopPri);
+            return;
+        }
+        uint64_t previousNanos = this->CurrentNanos;
+        uint64_t previousNextTime = this->NextTaskTime;
+        this->stepProcessesUntilStop(chunkStopTime, -1);
+        if(this->CurrentNanos == previousNanos && this->NextTaskTime == previousNextTime)
+        {
+            //! - No task is left to execute
+            return;
+        }
+    }
+}
+
+/*! This method adds a native event to the simulation.  Events are checked in the
+    order in which they were added.
+ @param newEvent The event to add
+ @return void
+ */
+void SimModel::addEvent(std::shared_ptr<SimEvent> newEvent)
+{
+    this->eventList.push_back(newEvent);
+}
+
+/*! This method finds a native event from its name.
+ @param eventName The name of the event
+ @return std::shared_ptr<SimEvent> The event, or an empty pointer if no event has this name
+ */
+std::shared_ptr<SimEvent> SimModel::getEvent(std::string eventName)
+{
+    std::vector<std::shared_ptr<SimEvent>>::iterator it;
+    for(it = this->eventList.begin(); it != this->eventList.end(); it++)
+    {
+        if((*it)->eventName == eventName)
+        {
+            return *it;
+        }
+    }
+    return nullptr;
+}
+
+/*! This method returns the earliest time at which a native event must be checked.
+ @return uint64_t [ns] Next check time, the largest representable time if no event is active
+ */
+uint64_t SimModel::nextEventTime()
+{
+    uint64_t nextTime = ~((uint64_t) 0);
+    std::vector<std::shared_ptr<SimEvent>>::iterator it;
+    for(it = this->eventList.begin(); it != this->eventList.end(); it++)
+    {
+        uint64_t eventTime = (*it)->nextCheckTime();
+        nextTime = eventTime < nextTime ? eventTime : nextTime;
+    }
+    return nextTime;
+}
+
+/*! This method checks all native events at the current simulation time.  All events
+    are checked even if a terminal event occurs.
+ @return void
+ */
+void SimModel::checkEvents()
+{
+    std::vector<std::shared_ptr<SimEvent>>::iterator it;
+    for(it = this->eventList.begin(); it != this->eventList.end(); it++)
+    {
+        if((*it)->checkEvent(this->CurrentNanos) && (*it)->terminal)
+        {
+            this->terminateSimulation = true;
+        }
+    }
+}
+
+/*! This method steps the processes until the specified stop time and stop priority
+    have been reached, on the thread list or on the task graph.
+ @param SimStopTime Nanoseconds to step the simulation for
+ @param stopPri The priority level below which the sim won't go
+ @return void
+ */
+void SimModel::stepProcessesUntilStop(uint64_t SimStopTime, int64_t stopPri)
 {
     std::vector<SimThreadExecution*>::iterator thrIt;
     std::cout << std::flush;
+    if(this->taskGraph)
+    {
+        this->stepTaskGraphUntilStop(SimStopTime, stopPri);
+        return;
+    }
     for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
     {
         (*thrIt)->moveProcessMessages();
@@ -577,3 +685,76 @@ void SimModel::addProcessToThread(SysProcess *newProc, uint64_t threadSel)
 
 
 
+
+/*! This method switches the simulation from process-to-thread pinning over to
+    task graph execution.  Instead of each thread walking its own fixed list of
+    processes, every task that is due in a given time frame becomes a node of a
+    dependency graph that is executed on a work-stealing pool of workerCount
+    workers.  The tasks of a process keep their priority order, tasks of different
+    processes run concurrently unless addTaskDependency() is used to order them.
+    Initialization and reset are still handled by the thread list.
+ @param workerCount Number of workers executing the graph, including the calling thread
+ @return void
+ */
+void SimModel::enableTaskGraph(uint64_t workerCount)
+{
+    if(!this->taskGraph)
+    {
+        this->taskGraph = new SimTaskGraph();
+    }
+    this->taskGraph->setWorkerCount(workerCount);
+}
+
+/*! This method goes back to the default process-to-thread pinned execution.
+    Any declared task dependencies are dropped.
+ @return void
+ */
+void SimModel::disableTaskGraph()
+{
+    delete this->taskGraph;
+    this->taskGraph = nullptr;
+}
+
+/*! This method declares that downstreamTask reads messages that are written by
+    upstreamTask.  When both tasks are due in the same frame of the task graph, the
+    downstream task only starts once the upstream task has finished.
+ @param upstreamTask The task that produces the data
+ @param downstreamTask The task that consumes the data
+ @return void
+ */
+void SimModel::addTaskDependency(SysModelTask *upstreamTask, SysModelTask *downstreamTask)
+{
+    if(!this->taskGraph)
+    {
+        bskLogger.bskLog(BSK_WARNING, "addTaskDependency() only has an effect once enableTaskGraph() was called.");
+        return;
+    }
+    this->taskGraph->addTaskDependency(upstreamTask, downstreamTask);
+}
+
+/*! This method steps the simulation frame by frame through the task graph until the
+    specified stop time and stop priority have been reached.  It follows the same
+    stopping rules as SimThreadExecution::StepUntilStop().
+ @param SimStopTime Nanoseconds to step the simulation for
+ @param stopPri The priority level below which the sim won't go
+ @return void
+ */
+void SimModel::stepTaskGraphUntilStop(uint64_t SimStopTime, int64_t stopPri)
+{
+    if(!this->taskGraph->findNextFrame(this->processList, this->NextTaskTime, this->nextProcPriority))
+    {
+        return;
+    }
+    int64_t inPri = SimStopTime == this->NextTaskTime ? stopPri : -1;
+    while(this->NextTaskTime < SimStopTime || (this->NextTaskTime == SimStopTime &&
+                                               this->nextProcPriority >= stopPri))
+    {
+        this->CurrentNanos = this->NextTaskTime;
+        this->taskGraph->executeFrame(this->processList, this->CurrentNanos, inPri);
+        if(!this->taskGraph->findNextFrame(this->processList, this->NextTaskTime, this->nextProcPriority))
+        {
+            break;
+        }
+        inPri = SimStopTime == this->NextTaskTime ? stopPri : -1;
+    }
+}
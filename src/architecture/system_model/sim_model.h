@@ -27,6 +27,8 @@
 #include <condition_variable>
 #include <iostream>
 #include "architecture/system_model/sys_process.h"
+#include "architecture/system_model/sim_task_graph.h"
+#include "architecture/system_model/sim_event.h"
 #include "architecture/utilities/bskLogging.h"
 #include "architecture/utilities/bskSemaphore.h"
 
@@ -98,6 +100,12 @@ public:
     void deleteThreads();
     void assignRemainingProcs();
     uint64_t getThreadCount() {return threadList.size();} //!< returns the number of threads used
+    void enableTaskGraph(uint64_t workerCount);
+    void disableTaskGraph();
+    bool taskGraphEnabled() {return this->taskGraph != nullptr;} //!< returns true if tasks are executed as a task graph
+    void addTaskDependency(SysModelTask *upstreamTask, SysModelTask *downstreamTask);
+    void addEvent(std::shared_ptr<SimEvent> newEvent);
+    std::shared_ptr<SimEvent> getEvent(std::string eventName);
 
     BSKLogger bskLogger;                      //!< -- BSK Logging
 
@@ -108,6 +116,15 @@ public:
     uint64_t CurrentNanos;  //!< [ns] Current sim time
     uint64_t NextTaskTime;  //!< [ns] time for the next Task
     int64_t nextProcPriority;  //!< [-] Priority level for the next process
+    std::vector<std::shared_ptr<SimEvent>> eventList;  //!< -- Native events checked while stepping
+    bool terminateSimulation;  //!< -- Flag set when a terminal native event stopped the last StepUntilStop
+
+private:
+    void stepProcessesUntilStop(uint64_t SimStopTime, int64_t stopPri);
+    void stepTaskGraphUntilStop(uint64_t SimStopTime, int64_t stopPri);
+    uint64_t nextEventTime();
+    void checkEvents();
+    SimTaskGraph *taskGraph;  //!< -- Work-stealing task graph executor, null when process-to-thread pinning is used
 };
 
 #endif /* _SimModel_H_ */
@@ -19,6 +19,25 @@
 %module sim_model
 %{
    #include "sim_model.h"
+
+   /*! Releases the Python interpreter while the simulation runs.  Tasks that contain
+       Python models acquire it again through SysModelTask::enterPython. */
+   class PythonReleaseGuard
+   {
+   public:
+       PythonReleaseGuard() : state(PyEval_SaveThread()) {}
+       ~PythonReleaseGuard() {PyEval_RestoreThread(this->state);}
+   private:
+       PyThreadState *state;
+   };
+
+   static int enterPythonInterpreter() {return (int) PyGILState_Ensure();}
+   static void leavePythonInterpreter(int state) {PyGILState_Release((PyGILState_STATE) state);}
+%}
+
+%init %{
+    SysModelTask::enterPython = enterPythonInterpreter;
+    SysModelTask::leavePython = leavePythonInterpreter;
 %}
 
 %include "std_vector.i"
@@ -30,6 +49,15 @@
 %include "exception.i"
 %include "cdata.i"
 %include "swig_eigen.i"
+%include <std_shared_ptr.i>
+
+%shared_ptr(EventCondition)
+%shared_ptr(FieldCondition)
+%shared_ptr(EventAction)
+%shared_ptr(TaskActivityAction)
+%shared_ptr(ProcessTasksActivityAction)
+%shared_ptr(EventActivityAction)
+%shared_ptr(SimEvent)
 
 %array_functions(double, doubleArray);
 %array_functions(long, longArray);
@@ -73,7 +101,66 @@ namespace std {
     } 
 }
 
+// The simulation runs without holding the Python interpreter, so that stretches of C++
+// tasks do not enter Python and other Python threads can run in the meantime
+%define %releasePython(method)
+%exception method {
+    try {
+        PythonReleaseGuard releasePython;
+        $action
+    } catch (const std::exception& e) {
+        SWIG_exception(SWIG_RuntimeError, e.what());
+    } catch (const std::string& e) {
+        SWIG_exception(SWIG_RuntimeError, e.c_str());
+    }
+}
+%enddef
+%releasePython(SimModel::selfInitSimulation)
+%releasePython(SimModel::resetInitSimulation)
+%releasePython(SimModel::StepUntilStop)
+
 %include "sys_model_task.h"
 %include "sys_model.h"
 %include "sys_process.h"
+%include "sim_event.h"
+%template(EventConditionVector) std::vector<std::shared_ptr<EventCondition>>;
+%template(EventActionVector) std::vector<std::shared_ptr<EventAction>>;
+%template(SimEventVector) std::vector<std::shared_ptr<SimEvent>>;
 %include "sim_model.h"
+
+%pythoncode %{
+import re
+
+def messageCondition(message, expression):
+    """Returns a native event condition comparing a numeric field of a message with a constant.
+
+    The expression has the form ``"field op value"`` or ``"field[index] op value"``, where op is one
+    of ``<``, ``<=``, ``>``, ``>=``, ``==`` or ``!=``, for example::
+
+        messageCondition(scObject.scStateOutMsg, "r_BN_N[2] < 0.0")
+
+    The message must be a message of a C payload.  The condition reads the message payload in place,
+    so the message must outlive the event.
+    """
+    match = re.fullmatch(r"\s*(\w+)\s*((?:\[\s*\d+\s*\])*)\s*(<=|>=|==|!=|<|>)\s*(.+?)\s*", expression)
+    if match is None:
+        raise ValueError("Could not parse the event condition: " + expression)
+    fieldName, indices, comparison, threshold = match.groups()
+    fieldTypes = getattr(type(message), "_fieldTypes", {})
+    if fieldName not in fieldTypes:
+        raise ValueError("The message has no numeric field " + fieldName)
+
+    typeCode, shape = fieldTypes[fieldName]
+    itemSize = int(typeCode[1:])
+    indices = [int(index) for index in re.findall(r"\d+", indices)]
+    if shape is None:
+        shape = (message.getFieldSize(fieldName) // itemSize,) if indices else ()
+    if len(indices) != len(shape) or any(index >= size for index, size in zip(indices, shape)):
+        raise ValueError("Invalid index of the message field " + fieldName + " in: " + expression)
+    flatIndex = 0
+    for index, size in zip(indices, shape):
+        flatIndex = flatIndex * size + index
+
+    address = message.getPayloadAddress() + message.getFieldOffset(fieldName) + flatIndex * itemSize
+    return FieldCondition(address, typeCode, comparison, float(threshold))
+%}
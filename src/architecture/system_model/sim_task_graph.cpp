@@ -0,0 +1,453 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "sim_task_graph.h"
+#include <algorithm>
+
+/*! The task graph constructor.  By default only the calling thread executes tasks. */
+SimTaskGraph::SimTaskGraph()
+{
+    this->workerCount = 0;
+    this->frameNanos = 0;
+    this->pendingDepsSize = 0;
+    this->nodesCompleted = 0;
+    this->terminateWorkers = false;
+    this->frameGeneration = 0;
+    this->workersBusy = 0;
+    this->readyEpoch = 0;
+    this->setWorkerCount(1);
+}
+
+/*! The destructor joins all of the pool threads */
+SimTaskGraph::~SimTaskGraph()
+{
+    this->stopWorkers();
+}
+
+/*! This method sets the number of workers used to execute a frame.  The calling
+    thread always acts as worker 0, so workerCount-1 pool threads are created.
+ @return void
+ @param workerCount Number of concurrent workers
+ */
+void SimTaskGraph::setWorkerCount(uint64_t workerCount)
+{
+    this->stopWorkers();
+    this->workerCount = workerCount > 0 ? workerCount : 1;
+    this->workQueues.clear();
+    for(uint64_t i=0; i<this->workerCount; i++)
+    {
+        this->workQueues.push_back(std::make_unique<TaskGraphWorkQueue>());
+    }
+    //! - The threads start from the current generation, so a frame released before they run is not missed
+    std::unique_lock<std::mutex> lck(this->frameLock);
+    this->terminateWorkers = false;
+    for(uint64_t i=1; i<this->workerCount; i++)
+    {
+        this->workerThreads.emplace_back(&SimTaskGraph::workerLoop, this, i, this->frameGeneration);
+    }
+}
+
+/*! This method declares that downstreamTask consumes the output of upstreamTask.
+    Whenever both tasks are due in the same frame, the downstream task is only
+    started once the upstream task has finished.
+ @return void
+ @param upstreamTask The task that has to execute first
+ @param downstreamTask The task that has to wait on upstreamTask
+ */
+void SimTaskGraph::addTaskDependency(SysModelTask *upstreamTask, SysModelTask *downstreamTask)
+{
+    if(upstreamTask == nullptr || downstreamTask == nullptr || upstreamTask == downstreamTask)
+    {
+        bskLogger.bskLog(BSK_WARNING, "SimTaskGraph: ignoring a task dependency with a null or identical task.");
+        return;
+    }
+    this->taskDependencies.insert(std::make_pair(upstreamTask, downstreamTask));
+}
+
+/*! This method executes every task that is due at currentNanos.  Tasks that are
+    behind schedule are caught up by repeating the frame until nothing is due anymore.
+ @return void
+ @param processList The processes to step, sorted by process priority
+ @param currentNanos [ns] Time of the frame
+ @param stopPri Processes below this priority are not executed at currentNanos
+ */
+void SimTaskGraph::executeFrame(std::vector<SysProcess *> &processList, uint64_t currentNanos, int64_t stopPri)
+{
+    this->frameNanos = currentNanos;
+    while(this->buildFrame(processList, currentNanos, stopPri))
+    {
+        this->runFrame();
+    }
+}
+
+/*! This method finds the next frame time of the processes and the highest process
+    priority that is due at that time.  The process next task times are updated as well.
+ @return bool Flag indicating that at least one enabled task is scheduled
+ @param processList The processes to search
+ @param nextNanos [ns] Time of the next frame, unchanged if no task is scheduled
+ @param nextPriority Highest process priority due at nextNanos
+ */
+bool SimTaskGraph::findNextFrame(std::vector<SysProcess *> &processList, uint64_t &nextNanos, int64_t &nextPriority)
+{
+    uint64_t nextCallTime = ~((uint64_t) 0);
+    std::vector<SysProcess *>::iterator it;
+    for(it = processList.begin(); it != processList.end(); it++)
+    {
+        SysProcess *localProc = (*it);
+        if(!localProc->processEnabled() || localProc->processTasks.empty())
+        {
+            continue;
+        }
+        uint64_t procNext = ~((uint64_t) 0);
+        std::vector<ModelScheduleEntry>::iterator taskIt;
+        for(taskIt = localProc->processTasks.begin(); taskIt != localProc->processTasks.end(); taskIt++)
+        {
+            procNext = std::min(procNext, taskIt->NextTaskStart);
+        }
+        localProc->nextTaskTime = procNext;
+        //! - The graph workers update the task start times, so the process calendar is stale
+        localProc->invalidateSchedule();
+        if(procNext < nextCallTime)
+        {
+            nextCallTime = procNext;
+            nextPriority = localProc->processPriority;
+        }
+        else if(procNext == nextCallTime && localProc->processPriority > nextPriority)
+        {
+            nextPriority = localProc->processPriority;
+        }
+    }
+    if(nextCallTime == ~((uint64_t) 0))
+    {
+        return false;
+    }
+    nextNanos = nextCallTime;
+    return true;
+}
+
+/*! This method collects the due tasks into graph nodes and wires up their
+    dependencies.  Tasks of a process are chained in their scheduling order
+    (start time, then task priority), user-declared dependencies are added on top.
+ @return bool Flag indicating that at least one task is due
+ @param processList The processes to step
+ @param currentNanos [ns] Time of the frame
+ @param stopPri Processes below this priority are not executed at currentNanos
+ */
+bool SimTaskGraph::buildFrame(std::vector<SysProcess *> &processList, uint64_t currentNanos, int64_t stopPri)
+{
+    std::vector<ModelScheduleEntry *> dueEntries;
+    this->frameNodes.clear();
+    this->nodeLookup.clear();
+
+    std::vector<SysProcess *>::iterator it;
+    for(it = processList.begin(); it != processList.end(); it++)
+    {
+        SysProcess *localProc = (*it);
+        if(!localProc->processEnabled())
+        {
+            continue;
+        }
+        dueEntries.clear();
+        std::vector<ModelScheduleEntry>::iterator taskIt;
+        for(taskIt = localProc->processTasks.begin(); taskIt != localProc->processTasks.end(); taskIt++)
+        {
+            if(taskIt->NextTaskStart < currentNanos ||
+               (taskIt->NextTaskStart == currentNanos && localProc->processPriority >= stopPri))
+            {
+                dueEntries.push_back(&(*taskIt));
+            }
+        }
+        //! - Keep the serial ordering of the process: earliest start first, then highest priority
+        std::stable_sort(dueEntries.begin(), dueEntries.end(),
+                         [](const ModelScheduleEntry *a, const ModelScheduleEntry *b) {
+            return a->NextTaskStart < b->NextTaskStart ||
+                   (a->NextTaskStart == b->NextTaskStart && a->taskPriority > b->taskPriority);
+        });
+        std::vector<ModelScheduleEntry *>::iterator dueIt;
+        for(dueIt = dueEntries.begin(); dueIt != dueEntries.end(); dueIt++)
+        {
+            TaskGraphNode newNode;
+            newNode.entry = *dueIt;
+            newNode.dependencyCount = dueIt == dueEntries.begin() ? 0 : 1;
+            if(dueIt != dueEntries.begin())
+            {
+                this->frameNodes.back().successors.push_back(this->frameNodes.size());
+            }
+            this->nodeLookup[(*dueIt)->TaskPtr] = this->frameNodes.size();
+            this->frameNodes.push_back(newNode);
+        }
+    }
+    if(this->frameNodes.empty())
+    {
+        return false;
+    }
+
+    //! - Add the user-declared dependencies between tasks that are both due in this frame
+    std::vector<std::pair<size_t, size_t>> userEdges;
+    std::set<std::pair<SysModelTask *, SysModelTask *>>::iterator depIt;
+    for(depIt = this->taskDependencies.begin(); depIt != this->taskDependencies.end(); depIt++)
+    {
+        std::unordered_map<SysModelTask *, size_t>::iterator upIt = this->nodeLookup.find(depIt->first);
+        std::unordered_map<SysModelTask *, size_t>::iterator downIt = this->nodeLookup.find(depIt->second);
+        if(upIt != this->nodeLookup.end() && downIt != this->nodeLookup.end())
+        {
+            userEdges.push_back(std::make_pair(upIt->second, downIt->second));
+            this->frameNodes[upIt->second].successors.push_back(downIt->second);
+            this->frameNodes[downIt->second].dependencyCount++;
+        }
+    }
+    if(!userEdges.empty() && !this->frameIsAcyclic())
+    {
+        bskLogger.bskLog(BSK_ERROR, "SimTaskGraph: the declared task dependencies conflict with the process task "
+                                    "ordering at time %llu ns.  Ignoring them for this frame.",
+                                    (unsigned long long) currentNanos);
+        std::vector<std::pair<size_t, size_t>>::iterator edgeIt;
+        for(edgeIt = userEdges.begin(); edgeIt != userEdges.end(); edgeIt++)
+        {
+            this->frameNodes[edgeIt->first].successors.pop_back();
+            this->frameNodes[edgeIt->second].dependencyCount--;
+        }
+    }
+
+    if(this->pendingDepsSize < this->frameNodes.size())
+    {
+        this->pendingDepsSize = this->frameNodes.size();
+        this->pendingDeps.reset(new std::atomic<int64_t>[this->pendingDepsSize]);
+    }
+    return true;
+}
+
+/*! This method checks that the frame graph can be executed, i.e. that it has no cycles.
+ @return bool Flag indicating that the frame graph is acyclic
+ */
+bool SimTaskGraph::frameIsAcyclic()
+{
+    std::vector<int64_t> remaining(this->frameNodes.size());
+    std::vector<size_t> readyList;
+    for(size_t i=0; i<this->frameNodes.size(); i++)
+    {
+        remaining[i] = this->frameNodes[i].dependencyCount;
+        if(remaining[i] == 0)
+        {
+            readyList.push_back(i);
+        }
+    }
+    size_t visited = 0;
+    while(!readyList.empty())
+    {
+        size_t nodeIndex = readyList.back();
+        readyList.pop_back();
+        visited++;
+        std::vector<size_t>::iterator succIt;
+        for(succIt = this->frameNodes[nodeIndex].successors.begin();
+            succIt != this->frameNodes[nodeIndex].successors.end(); succIt++)
+        {
+            if(--remaining[*succIt] == 0)
+            {
+                readyList.push_back(*succIt);
+            }
+        }
+    }
+    return visited == this->frameNodes.size();
+}
+
+/*! This method releases the pool on the current frame graph, participates in its
+    execution as worker 0 and returns once every node of the frame has completed.
+ @return void
+ */
+void SimTaskGraph::runFrame()
+{
+    this->nodesCompleted = 0;
+    uint64_t seedWorker = 0;
+    for(size_t i=0; i<this->frameNodes.size(); i++)
+    {
+        this->pendingDeps[i] = this->frameNodes[i].dependencyCount;
+        if(this->frameNodes[i].dependencyCount == 0)
+        {
+            //! - Spread the root nodes over the workers, the rest is balanced by stealing
+            this->workQueues[seedWorker]->readyNodes.push_back(i);
+            seedWorker = (seedWorker + 1) % this->workerCount;
+        }
+    }
+    {
+        std::unique_lock<std::mutex> lck(this->frameLock);
+        this->workersBusy = this->workerThreads.size();
+        this->frameGeneration++;
+    }
+    this->frameStartVar.notify_all();
+
+    this->processNodes(0);
+
+    std::unique_lock<std::mutex> lck(this->frameLock);
+    while(this->workersBusy > 0)
+    {
+        this->frameDoneVar.wait(lck);
+    }
+}
+
+/*! This is the main loop of the pool threads.  They sleep until a frame is released,
+    help execute it and report back once all of its nodes have completed.
+ @return void
+ @param workerIndex Index of the work queue owned by the thread
+ @param seenGeneration Frame generation at the creation of the thread
+ */
+void SimTaskGraph::workerLoop(uint64_t workerIndex, uint64_t seenGeneration)
+{
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lck(this->frameLock);
+            while(!this->terminateWorkers && this->frameGeneration == seenGeneration)
+            {
+                this->frameStartVar.wait(lck);
+            }
+            if(this->terminateWorkers)
+            {
+                return;
+            }
+            seenGeneration = this->frameGeneration;
+        }
+        this->processNodes(workerIndex);
+        {
+            std::unique_lock<std::mutex> lck(this->frameLock);
+            this->workersBusy--;
+            if(this->workersBusy == 0)
+            {
+                this->frameDoneVar.notify_one();
+            }
+        }
+    }
+}
+
+/*! This method executes ready nodes until every node of the frame has completed.
+    Finishing a node releases its successors onto the queue of the executing worker.
+    A worker that finds no ready node sleeps until a node is released or the frame ends.
+ @return void
+ @param workerIndex Index of the work queue owned by the caller
+ */
+void SimTaskGraph::processNodes(uint64_t workerIndex)
+{
+    size_t nodeIndex;
+    while(this->nodesCompleted.load() < this->frameNodes.size())
+    {
+        //! - Nodes released after the epoch is read bump it, so the wait below cannot miss them
+        uint64_t epoch;
+        {
+            std::unique_lock<std::mutex> lck(this->readyLock);
+            epoch = this->readyEpoch;
+        }
+        if(!this->popReadyNode(workerIndex, nodeIndex))
+        {
+            std::unique_lock<std::mutex> lck(this->readyLock);
+            while(this->readyEpoch == epoch && this->nodesCompleted.load() < this->frameNodes.size())
+            {
+                this->readyVar.wait(lck);
+            }
+            continue;
+        }
+        TaskGraphNode &localNode = this->frameNodes[nodeIndex];
+        SysModelTask *localTask = localNode.entry->TaskPtr;
+        localTask->ExecuteTaskList(this->frameNanos);
+        localNode.entry->NextTaskStart = localTask->NextStartTime;
+        std::vector<size_t>::iterator succIt;
+        for(succIt = localNode.successors.begin(); succIt != localNode.successors.end(); succIt++)
+        {
+            if(this->pendingDeps[*succIt].fetch_sub(1) == 1)
+            {
+                this->pushReadyNode(workerIndex, *succIt);
+            }
+        }
+        if(this->nodesCompleted.fetch_add(1) + 1 == this->frameNodes.size())
+        {
+            std::unique_lock<std::mutex> lck(this->readyLock);
+            this->readyEpoch++;
+            this->readyVar.notify_all();
+        }
+    }
+}
+
+/*! This method pops the most recently released node of the caller's own queue.  If the
+    queue is empty, it tries to steal the oldest node of the other workers' queues.
+ @return bool Flag indicating that a node was found
+ @param workerIndex Index of the work queue owned by the caller
+ @param nodeIndex Index of the node to execute
+ */
+bool SimTaskGraph::popReadyNode(uint64_t workerIndex, size_t &nodeIndex)
+{
+    {
+        TaskGraphWorkQueue &ownQueue = *this->workQueues[workerIndex];
+        std::lock_guard<std::mutex> lck(ownQueue.queueLock);
+        if(!ownQueue.readyNodes.empty())
+        {
+            nodeIndex = ownQueue.readyNodes.back();
+            ownQueue.readyNodes.pop_back();
+            return true;
+        }
+    }
+    for(uint64_t i=1; i<this->workerCount; i++)
+    {
+        TaskGraphWorkQueue &victimQueue = *this->workQueues[(workerIndex + i) % this->workerCount];
+        std::lock_guard<std::mutex> lck(victimQueue.queueLock);
+        if(!victimQueue.readyNodes.empty())
+        {
+            nodeIndex = victimQueue.readyNodes.front();
+            victimQueue.readyNodes.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/*! This method pushes a node that became ready onto the caller's own queue.
+ @return void
+ @param workerIndex Index of the work queue owned by the caller
+ @param nodeIndex Index of the node that became ready
+ */
+void SimTaskGraph::pushReadyNode(uint64_t workerIndex, size_t nodeIndex)
+{
+    {
+        TaskGraphWorkQueue &ownQueue = *this->workQueues[workerIndex];
+        std::lock_guard<std::mutex> lck(ownQueue.queueLock);
+        ownQueue.readyNodes.push_back(nodeIndex);
+    }
+    std::unique_lock<std::mutex> lck(this->readyLock);
+    this->readyEpoch++;
+    this->readyVar.notify_one();
+}
+
+/*! This method asks all of the pool threads to exit and joins them.
+ @return void
+ */
+void SimTaskGraph::stopWorkers()
+{
+    {
+        std::unique_lock<std::mutex> lck(this->frameLock);
+        this->terminateWorkers = true;
+    }
+    this->frameStartVar.notify_all();
+    std::vector<std::thread>::iterator thrIt;
+    for(thrIt = this->workerThreads.begin(); thrIt != this->workerThreads.end(); thrIt++)
+    {
+        if(thrIt->joinable())
+        {
+            thrIt->join();
+        }
+    }
+    this->workerThreads.clear();
+}
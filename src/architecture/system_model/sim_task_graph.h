@@ -0,0 +1,102 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _SimTaskGraph_HH_
+#define _SimTaskGraph_HH_
+
+#include <vector>
+#include <deque>
+#include <set>
+#include <utility>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <stdint.h>
+#include "architecture/system_model/sys_process.h"
+#include "architecture/utilities/bskLogging.h"
+
+//! Node of the task graph, i.e. one process task that is due in the current frame
+typedef struct {
+    ModelScheduleEntry *entry;          //!< -- schedule entry of the task inside its process
+    std::vector<size_t> successors;     //!< -- graph nodes that can only run once this node finished
+    int64_t dependencyCount;            //!< -- number of due predecessors of this node
+}TaskGraphNode;
+
+//! Work queue of a single worker.  Owner pops from the back, thieves steal from the front.
+typedef struct {
+    std::mutex queueLock;               //!< -- lock protecting the queue
+    std::deque<size_t> readyNodes;      //!< -- indices of the graph nodes that are ready to run
+}TaskGraphWorkQueue;
+
+/*! This class executes the tasks of a set of processes as a dependency graph on a
+    work-stealing thread pool.  The simulation is advanced one frame (one time slot) at a
+    time.  Inside a frame, the tasks of a process keep their serial (priority) order, while
+    tasks of different processes are free to run concurrently unless an explicit dependency
+    has been declared between them.
+ */
+class SimTaskGraph
+{
+public:
+    SimTaskGraph();
+    ~SimTaskGraph();
+    void setWorkerCount(uint64_t workerCount);
+    uint64_t getWorkerCount() {return this->workerCount;} //!< returns the number of workers, including the calling thread
+    void addTaskDependency(SysModelTask *upstreamTask, SysModelTask *downstreamTask);
+    void clearTaskDependencies() {this->taskDependencies.clear();} //!< removes all of the user-declared dependencies
+    void executeFrame(std::vector<SysProcess *> &processList, uint64_t currentNanos, int64_t stopPri);
+    bool findNextFrame(std::vector<SysProcess *> &processList, uint64_t &nextNanos, int64_t &nextPriority);
+
+    BSKLogger bskLogger;                      //!< -- BSK Logging
+
+private:
+    bool buildFrame(std::vector<SysProcess *> &processList, uint64_t currentNanos, int64_t stopPri);
+    bool frameIsAcyclic();
+    void runFrame();
+    void workerLoop(uint64_t workerIndex, uint64_t seenGeneration);
+    void processNodes(uint64_t workerIndex);
+    bool popReadyNode(uint64_t workerIndex, size_t &nodeIndex);
+    void pushReadyNode(uint64_t workerIndex, size_t nodeIndex);
+    void stopWorkers();
+
+private:
+    uint64_t workerCount;                                  //!< -- number of workers, including the calling thread
+    uint64_t frameNanos;                                   //!< [ns] time of the frame being executed
+    std::vector<TaskGraphNode> frameNodes;                 //!< -- task nodes of the frame being executed
+    std::unique_ptr<std::atomic<int64_t>[]> pendingDeps;   //!< -- remaining dependencies of each frame node
+    size_t pendingDepsSize;                                //!< -- allocated size of pendingDeps
+    std::unordered_map<SysModelTask *, size_t> nodeLookup; //!< -- frame node index of each due task
+    std::set<std::pair<SysModelTask *, SysModelTask *>> taskDependencies; //!< -- user-declared (upstream, downstream) pairs
+    std::vector<std::unique_ptr<TaskGraphWorkQueue>> workQueues; //!< -- one work queue per worker
+    std::vector<std::thread> workerThreads;                //!< -- pool threads (worker 0 is the calling thread)
+    std::atomic<size_t> nodesCompleted;                    //!< -- number of nodes finished in the current frame
+    bool terminateWorkers;                                 //!< -- flag asking the pool threads to exit
+    uint64_t frameGeneration;                              //!< -- counter used to release the pool on a new frame
+    std::mutex frameLock;                                  //!< -- lock protecting the frame start/stop handshake
+    std::condition_variable frameStartVar;                 //!< -- wakes pool threads when a frame starts
+    std::condition_variable frameDoneVar;                  //!< -- wakes the calling thread when a frame ends
+    uint64_t workersBusy;                                  //!< -- number of pool threads still inside the frame
+    uint64_t readyEpoch;                                   //!< -- counter bumped whenever a node is released or the frame ends
+    std::mutex readyLock;                                  //!< -- lock protecting readyEpoch
+    std::condition_variable readyVar;                      //!< -- wakes idle workers when readyEpoch changes
+};
+
+#endif /* _SimTaskGraph_H_ */
@@ -19,6 +19,38 @@
 
 #include "sys_model_task.h"
 
+int (*SysModelTask::enterPython)() = nullptr;
+void (*SysModelTask::leavePython)(int) = nullptr;
+
+namespace {
+/*! Holds the Python interpreter while the models of a task that contains Python models
+    are called.  The simulation releases the interpreter while it runs, so the other
+    tasks execute without entering Python at all.
+ */
+class PythonTaskLock
+{
+public:
+    explicit PythonTaskLock(SysModelTask *task)
+    {
+        this->locked = SysModelTask::enterPython != nullptr && task->requiresPython();
+        this->state = this->locked ? SysModelTask::enterPython() : 0;
+    }
+    ~PythonTaskLock()
+    {
+        if(this->locked)
+        {
+            SysModelTask::leavePython(this->state);
+        }
+    }
+    PythonTaskLock(const PythonTaskLock &) = delete;
+    PythonTaskLock &operator=(const PythonTaskLock &) = delete;
+
+private:
+    bool locked;  //!< -- Flag indicating that the interpreter was acquired
+    int state;    //!< -- Interpreter state returned by enterPython
+};
+}
+
 /*! The task constructor.  */
 SysModelTask::SysModelTask()
 {
@@ -57,6 +89,8 @@ void SysModelTask::SelfInitTaskList()
 {
     std::vector<ModelPriorityPair>::iterator ModelPair;
     SysModel* NonIt;
+    this->updateRequiresPython();
+    PythonTaskLock pythonLock(this);
     
     //! - Loop over all models and do the self init for each
     for(ModelPair = this->TaskModels.begin(); ModelPair != this->TaskModels.end();
@@ -77,6 +111,8 @@ void SysModelTask::SelfInitTaskList()
 void SysModelTask::ResetTaskList(uint64_t CurrentSimTime)
 {
 	std::vector<ModelPriorityPair>::iterator ModelPair;
+	this->updateRequiresPython();
+	PythonTaskLock pythonLock(this);
 	for (ModelPair = this->TaskModels.begin(); ModelPair != this->TaskModels.end();
 	ModelPair++)
 	{
@@ -95,6 +131,8 @@ void SysModelTask::ExecuteTaskList(uint64_t CurrentSimNanos)
 {
     std::vector<ModelPriorityPair>::iterator ModelPair;
     SysModel* NonIt;
+    //! - Only tasks that contain Python models enter the Python interpreter
+    PythonTaskLock pythonLock(this);
     
     //! - Loop over all of the models in the simulation and call their UpdateState
     for(ModelPair = this->TaskModels.begin(); (ModelPair != this->TaskModels.end() && this->taskActive);
@@ -122,6 +160,7 @@ void SysModelTask::AddNewObject(SysModel *NewModel, int32_t Priority)
     //! - Set the local pair with the requested priority and mode
     LocalPair.CurrentModelPriority = Priority;
     LocalPair.ModelPtr = NewModel;
+    this->pythonModels = this->pythonModels || NewModel->requiresPython;
 //    SystemMessaging::GetInstance()->addModuleToProcess(NewModel->moduleID,
 //            parentProc);
     //! - Loop through the ModelPair vector and if Priority is higher than next, insert
@@ -138,6 +177,26 @@ void SysModelTask::AddNewObject(SysModel *NewModel, int32_t Priority)
     this->TaskModels.push_back(LocalPair);
 }
 
+/*! This method checks if any model of the task is implemented in Python, and caches the
+    result returned by requiresPython.  AddNewObject updates the flag for the added model, and
+    the task is rescanned when it is initialized or reset, so that models removed from
+    TaskModels directly are accounted for without scanning the models on every call.
+ @return void
+ */
+void SysModelTask::updateRequiresPython()
+{
+    std::vector<ModelPriorityPair>::iterator ModelPair;
+    this->pythonModels = false;
+    for(ModelPair = this->TaskModels.begin(); ModelPair != this->TaskModels.end(); ModelPair++)
+    {
+        if(ModelPair->ModelPtr->requiresPython)
+        {
+            this->pythonModels = true;
+            return;
+        }
+    }
+}
+
 /*! This method changes the period of a given task over to the requested period.
    It attempts to keep the same offset relative to the original offset that
    was specified at task creation.
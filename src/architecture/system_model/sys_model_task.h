@@ -49,6 +49,8 @@ public:
 	void disableTask() {this->taskActive = false;} //!< Disables the task.  I know.
     void updatePeriod(uint64_t newPeriod);
     void updateParentProc(std::string parent) {this->parentProc = parent;} //!< Allows the system to move task to a different process
+    bool requiresPython() {return this->pythonModels;} //!< Returns true if any model of the task is implemented in Python
+    void updateRequiresPython();
     
 public:
     std::vector<ModelPriorityPair> TaskModels;  //!< -- Array that has pointers to all task sysModels
@@ -58,8 +60,15 @@ public:
     uint64_t NextPickupTime;  //!< [ns] Next time read Task outputs
     uint64_t TaskPeriod;  //!< [ns] Cycle rate for Task
     uint64_t FirstTaskTime;  //!< [ns] Time to start Task for first time.  After this time the normal periodic updates resume.
+#ifndef SWIG
+    static int (*enterPython)();  //!< -- Acquires the Python interpreter, installed by the Python wrapper of the simulation
+    static void (*leavePython)(int);  //!< -- Releases the Python interpreter acquired by enterPython
+#endif
 	bool taskActive;  //!< -- Flag indicating whether the Task has been disabled
   BSKLogger bskLogger;                      //!< -- BSK Logging
+
+private:
+    bool pythonModels = false;  //!< -- Flag indicating that a model of TaskModels is implemented in Python
 };
 
 #endif /* _SysModelTask_H_ */
@@ -18,6 +18,7 @@
  */
 
 #include "sys_process.h"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -28,6 +29,7 @@ SysProcess :: SysProcess()
     this->processActive = true;
     this->processPriority = -1;
     this->processOnThread = false;
+    this->scheduleValid = false;
     this->disableProcess();
 }
 /*! Make a process AND attach a storage bucket with the provided name. Give
@@ -42,6 +44,7 @@ SysProcess::SysProcess(std::string messageContainer)
     this->processName = messageContainer;
     this->prevRouteTime = 0xFF;
     this->processOnThread = false;
+    this->scheduleValid = false;
     this->disableProcess();
 }
 
@@ -86,6 +89,7 @@ void SysProcess::resetProcess(uint64_t currentTime)
         localTask->ResetTaskList(currentTime); //! Time of reset. Models that utilize currentTime will start at this.
     }
     this->nextTaskTime = currentTime;
+    this->invalidateSchedule();
     return;
 }
 
@@ -115,52 +119,95 @@ void SysProcess::reInitProcess()
 }
 
 /*! This method steps the next task up to currentNanos
- * unless it isn't supposed to run yet.
+ * unless it isn't supposed to run yet.  The next task is the top of the task
+ * calendar, a binary heap ordered by start time, then task priority, then the
+ * order of processTasks, so that selecting it is logarithmic in the number of tasks.
  @return void
  */
 void SysProcess::singleStepNextTask(uint64_t currentNanos)
 {
-    std::vector<ModelScheduleEntry>::iterator it;
-    std::vector<ModelScheduleEntry>::iterator fireIt;
-
     //! - Check to make sure that there are models to be called.
     if(this->processTasks.begin() == this->processTasks.end())
     {
         bskLogger.bskLog(BSK_WARNING, "Received a step command on sim that has no active Tasks.");
         return;
     }
-    fireIt=this->processTasks.begin();
-    //! - If the requested time does not meet our next start time, just return
-    for(it=this->processTasks.begin(); it!=this->processTasks.end(); it++)
+    if(!this->scheduleValid)
     {
-        if(it->NextTaskStart < fireIt->NextTaskStart ||
-                (it->NextTaskStart==fireIt->NextTaskStart && it->taskPriority > fireIt->taskPriority))
-        {
-            fireIt = it;
-        }
+        this->rebuildSchedule();
     }
-    if(fireIt->NextTaskStart > currentNanos)
+    //! - If the requested time does not meet our next start time, just return
+    size_t fireIndex = this->taskSchedule.front();
+    if(this->processTasks[fireIndex].NextTaskStart > currentNanos)
     {
-        this->nextTaskTime = fireIt->NextTaskStart;
+        this->nextTaskTime = this->processTasks[fireIndex].NextTaskStart;
         return;
     }
     //! - Call the next scheduled model, and set the time to its start
-    SysModelTask *localTask = fireIt->TaskPtr;
+    SysModelTask *localTask = this->processTasks[fireIndex].TaskPtr;
     localTask->ExecuteTaskList(currentNanos);
-    fireIt->NextTaskStart = localTask->NextStartTime;
-    
-    //! - Figure out when we are going to be called next for scheduling purposes
-    fireIt=this->processTasks.begin();
-    //! - If the requested time does not meet our next start time, just return
-    for(it=this->processTasks.begin(); it!=this->processTasks.end(); it++)
+
+    //! - Move the task to its new place in the calendar
+    auto firesAfter = [this](size_t taskA, size_t taskB) {return this->firesAfter(taskA, taskB);};
+    if(this->scheduleValid)
+    {
+        std::pop_heap(this->taskSchedule.begin(), this->taskSchedule.end(), firesAfter);
+        this->processTasks[fireIndex].NextTaskStart = localTask->NextStartTime;
+        std::push_heap(this->taskSchedule.begin(), this->taskSchedule.end(), firesAfter);
+    }
+    else
     {
-        if(it->NextTaskStart < fireIt->NextTaskStart ||
-           (it->NextTaskStart==fireIt->NextTaskStart && it->taskPriority > fireIt->taskPriority))
+        //! - The task list was changed while the task executed, find the task again
+        std::vector<ModelScheduleEntry>::iterator it;
+        for(it = this->processTasks.begin(); it != this->processTasks.end(); it++)
         {
-            fireIt = it;
+            if(it->TaskPtr == localTask)
+            {
+                it->NextTaskStart = localTask->NextStartTime;
+            }
         }
+        this->rebuildSchedule();
+    }
+
+    //! - Figure out when we are going to be called next for scheduling purposes
+    this->nextTaskTime = this->processTasks[this->taskSchedule.front()].NextTaskStart;
+}
+
+/*! This method orders the task calendar.  A task fires after another one if it
+ * starts later, or at the same time with a lower priority.  Ties are broken by
+ * the order of processTasks, like a front-to-back search of the list.
+ @return bool Flag indicating that taskA fires after taskB
+ @param taskA Index of the first task in processTasks
+ @param taskB Index of the second task in processTasks
+ */
+bool SysProcess::firesAfter(size_t taskA, size_t taskB) const
+{
+    const ModelScheduleEntry &entryA = this->processTasks[taskA];
+    const ModelScheduleEntry &entryB = this->processTasks[taskB];
+    if(entryA.NextTaskStart != entryB.NextTaskStart)
+    {
+        return entryA.NextTaskStart > entryB.NextTaskStart;
+    }
+    if(entryA.taskPriority != entryB.taskPriority)
+    {
+        return entryA.taskPriority < entryB.taskPriority;
+    }
+    return taskA > taskB;
+}
+
+/*! This method rebuilds the task calendar from the start times of processTasks.
+ @return void
+ */
+void SysProcess::rebuildSchedule()
+{
+    this->taskSchedule.resize(this->processTasks.size());
+    for(size_t i = 0; i < this->taskSchedule.size(); i++)
+    {
+        this->taskSchedule[i] = i;
     }
-    this->nextTaskTime = fireIt->NextTaskStart;
+    std::make_heap(this->taskSchedule.begin(), this->taskSchedule.end(),
+                   [this](size_t taskA, size_t taskB) {return this->firesAfter(taskA, taskB);});
+    this->scheduleValid = true;
 }
 
 /*! This method adds a new task into the Task list.  Note that
@@ -191,6 +238,7 @@ void SysProcess::addNewTask(SysModelTask *newTask, int32_t taskPriority)
 void SysProcess::scheduleTask(ModelScheduleEntry & taskCall)
 {
     std::vector<ModelScheduleEntry>::iterator it;
+    this->invalidateSchedule();
     //! - Iteratre through all of the task models to find correct place
     for(it = this->processTasks.begin(); it != this->processTasks.end(); it++)
     {
@@ -253,6 +301,7 @@ void SysProcess::changeTaskPeriod(std::string taskName, uint64_t newPeriod)
 			it->TaskPtr->updatePeriod(newPeriod);
 			it->NextTaskStart = it->TaskPtr->NextStartTime;
 			it->TaskUpdatePeriod = it->TaskPtr->TaskPeriod;
+			this->invalidateSchedule();
 			return;
 		}
 	}
@@ -59,7 +59,8 @@ public:
     void enableAllTasks(); //!< class method
     bool getProcessControlStatus() {return this->processOnThread;} //!< Allows caller to see if this process is parented by a thread
     void setProcessControlStatus(bool processTaken) {processOnThread = processTaken;} //!< Provides a mechanism to say that this process is allocated to a thread
-    
+    void invalidateSchedule() {this->scheduleValid = false;} //!< Must be called when the start times of processTasks are changed outside of the process
+
 public:
     std::vector<ModelScheduleEntry> processTasks;  //!< -- Array that has pointers to all process tasks
     uint64_t nextTaskTime;  //!< [ns] time for the next Task
@@ -69,6 +70,14 @@ public:
 	bool processOnThread; //!< -- Flag indicating that the process has been added to a thread for execution
     int64_t processPriority;  //!< [-] Priority level for process (higher first)
     BSKLogger bskLogger;                      //!< -- BSK Logging
+
+private:
+    bool firesAfter(size_t taskA, size_t taskB) const; //!< Orders the task calendar
+    void rebuildSchedule(); //!< Rebuilds the task calendar from processTasks
+
+private:
+    std::vector<size_t> taskSchedule;  //!< -- Binary heap of processTasks indices, next task to call first
+    bool scheduleValid;  //!< -- Flag indicating that taskSchedule matches processTasks
 };
 
 #endif /* _SysProcess_H_ */
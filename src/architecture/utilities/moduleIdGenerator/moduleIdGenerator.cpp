@@ -47,11 +47,9 @@ ModuleIdGenerator::~ModuleIdGenerator()
  */
 ModuleIdGenerator* ModuleIdGenerator::GetInstance()
 {
-    if(TheInstance == NULL)
-    {
-        TheInstance = new ModuleIdGenerator();
-    }
-    return(TheInstance);
+    // The initialization of a static local variable is thread-safe, so modules can be created in parallel threads
+    static ModuleIdGenerator *instance = (TheInstance = new ModuleIdGenerator());
+    return(instance);
 }
 
 /*!
@@ -60,5 +58,5 @@ ModuleIdGenerator* ModuleIdGenerator::GetInstance()
  */
 int64_t ModuleIdGenerator::checkoutModuleID()
 {
-    return(this->nextModuleID++);
+    return(this->nextModuleID.fetch_add(1));
 }
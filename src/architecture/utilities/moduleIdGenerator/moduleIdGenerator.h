@@ -21,6 +21,7 @@
 #define _ModuleIdGenerator_HH_
 
 #include <inttypes.h>
+#include <atomic>
 
 /*! @brief module ID generating class */
 #ifdef _WIN32
@@ -34,7 +35,7 @@ public:
     static ModuleIdGenerator* GetInstance();  //! -- returns a pointer to the sim instance of ModuleIdGenerator
 
 private:
-    int64_t nextModuleID;  //!< the next module ID to give out when a module (SysModel sub-class) comes online
+    std::atomic<int64_t> nextModuleID;  //!< the next module ID to give out when a module (SysModel sub-class) comes online
     static ModuleIdGenerator *TheInstance;        //!< instance of simulation module
 
     ModuleIdGenerator();
@@ -0,0 +1,119 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "threadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    for (size_t i = 1; i < threadCount; i++) {
+        this->workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->wakeUp.notify_all();
+    for (auto& worker : this->workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body)
+{
+    if (this->workers.empty() || count < 2) {
+        for (size_t index = 0; index < count; index++) {
+            body(index);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->jobBody = &body;
+        this->jobCount = count;
+        this->nextIndex.store(0, std::memory_order_relaxed);
+        this->error = nullptr;
+        this->activeWorkers = this->workers.size();
+        this->jobGeneration++;
+    }
+    this->wakeUp.notify_all();
+
+    this->executeIndices();
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->jobDone.wait(lock, [this] { return this->activeWorkers == 0; });
+    this->jobBody = nullptr;
+    if (this->error) {
+        std::exception_ptr error = this->error;
+        this->error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->wakeUp.wait(lock, [&] {
+                return this->stopping || this->jobGeneration != seenGeneration;
+            });
+            if (this->stopping) {
+                return;
+            }
+            seenGeneration = this->jobGeneration;
+        }
+
+        this->executeIndices();
+
+        bool lastWorker;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            lastWorker = --this->activeWorkers == 0;
+        }
+        if (lastWorker) {
+            this->jobDone.notify_one();
+        }
+    }
+}
+
+void ThreadPool::executeIndices()
+{
+    while (true) {
+        size_t index = this->nextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (index >= this->jobCount) {
+            return;
+        }
+        try {
+            (*this->jobBody)(index);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (!this->error || index < this->errorIndex) {
+                this->error = std::current_exception();
+                this->errorIndex = index;
+            }
+        }
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** A pool of persistent worker threads used to run independent computations in parallel.
+ *
+ * The integrators and the models call the pool several times per simulation step, so the workers
+ * are kept alive between calls and wait for work instead of being created for each call.
+ * The calling thread also executes work, so a pool of `N` threads has `N - 1` workers.
+ */
+class ThreadPool {
+  public:
+    /** Creates a pool that runs work on `threadCount` threads, including the calling thread */
+    explicit ThreadPool(size_t threadCount);
+
+    /** Stops and joins the worker threads */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** Returns the number of threads that execute work, including the calling thread */
+    size_t getThreadCount() const { return this->workers.size() + 1; }
+
+    /** Calls `body(index)` for every index in `[0, count)` and returns when all calls are done.
+     *
+     * Indices are handed out one at a time, so calls of different cost are balanced between
+     * the threads. If calls throw, the exception of the lowest index is rethrown once all
+     * calls are done.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+  private:
+    /** Loop of the worker threads */
+    void workerLoop();
+
+    /** Executes indices of the current job until none is left */
+    void executeIndices();
+
+  private:
+    std::vector<std::thread> workers; /**< Worker threads */
+
+    std::mutex mutex;                   /**< Protects the job and the worker wake-up */
+    std::condition_variable wakeUp;     /**< Signals the workers that a job or stop was posted */
+    std::condition_variable jobDone;    /**< Signals the caller that all workers left the job */
+    uint64_t jobGeneration = 0;         /**< Incremented for every job */
+    size_t activeWorkers = 0;           /**< Workers that have not yet left the current job */
+    bool stopping = false;              /**< Set when the pool is destroyed */
+
+    const std::function<void(size_t)>* jobBody = nullptr; /**< Function of the current job */
+    size_t jobCount = 0;                                  /**< Number of indices of the current job */
+    std::atomic<size_t> nextIndex{0};                     /**< Next index to execute */
+
+    size_t errorIndex = 0;         /**< Index of the first call that threw, protected by mutex */
+    std::exception_ptr error;      /**< Exception of the call at errorIndex, protected by mutex */
+};
+
+#endif /* THREAD_POOL_H */
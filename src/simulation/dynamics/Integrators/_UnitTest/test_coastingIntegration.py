@@ -0,0 +1,104 @@
+# ISC License
+#
+# Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+import numpy as np
+import pytest
+from Basilisk.architecture import messaging
+from Basilisk.simulation import extForceTorque
+from Basilisk.simulation import spacecraft
+from Basilisk.simulation import svIntegrators
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import simIncludeGravBody
+
+
+def runManeuver(maximumCoastTimeStep, registerInput):
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(1.)))
+
+    scObject = spacecraft.Spacecraft()
+    scObject.ModelTag = "spacecraft"
+    scObject.hub.mHub = 750.0
+    scObject.hub.IHubPntBc_B = [[900., 0., 0.], [0., 800., 0.], [0., 0., 600.]]
+    scObject.hub.r_CN_NInit = [7000. * 1000, 0., 1000. * 1000]
+    scObject.hub.v_CN_NInit = [0., 7.5 * 1000, 0.]
+    scObject.hub.omega_BN_BInit = [[0.001], [-0.002], [0.003]]
+    scSim.AddModelToTask("simTask", scObject)
+
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createEarth()
+    earth.isCentralBody = True
+    gravFactory.addBodiesTo(scObject)
+
+    # the force command is written every task period, but only changes during the maneuver
+    cmdPayload = messaging.CmdForceInertialMsgPayload()
+    cmdMsg = messaging.CmdForceInertialMsg().write(cmdPayload)
+    extFTObject = extForceTorque.ExtForceTorque()
+    extFTObject.ModelTag = "thrust"
+    extFTObject.cmdForceInertialInMsg.subscribeTo(cmdMsg)
+    scObject.addDynamicEffector(extFTObject)
+    scSim.AddModelToTask("simTask", extFTObject)
+
+    integratorObject = svIntegrators.svIntegratorRKF45(scObject)
+    integratorObject.relTol = 1e-12
+    integratorObject.absTol = 1e-8
+    integratorObject.maximumCoastTimeStep = maximumCoastTimeStep
+    if registerInput:
+        integratorObject.addCoastInput(cmdMsg.getPayloadAddress(), cmdMsg.getPayloadSize())
+    scObject.setIntegrator(integratorObject)
+
+    scSim.InitializeSimulation()
+    for stopTime, force in [(3000., [0., 0., 0.]), (3600., [1., 0., 0.]), (7200., [0., 0., 0.])]:
+        cmdPayload.forceRequestInertial = force
+        cmdMsg.write(cmdPayload)
+        scSim.ConfigureStopTime(macros.sec2nano(stopTime))
+        scSim.ExecuteSimulation()
+
+    return np.array(scObject.scStateOutMsg.read().r_BN_N)
+
+
+@pytest.mark.parametrize("maximumCoastTimeStep", [60., 600.])
+def test_coastingIntegration(maximumCoastTimeStep):
+    r"""
+    **Validation Test Description**
+
+    With ``maximumCoastTimeStep`` set, the adaptive integrator takes steps over several task periods,
+    and restarts from the current states when a registered input message changes.  A two hour orbit
+    propagation with a one second task, including a ten minute maneuver, is compared with the same
+    propagation where steps are cut at the end of every task period.
+
+    **Test Parameters**
+
+    Args:
+        maximumCoastTimeStep (float): [s] largest step allowed when coasting
+
+    **Description of Variables Being Tested**
+
+    The final position must match the reference within one centimeter, and must miss the maneuver
+    when the force command message is not registered as an input of the integrator.
+    """
+    reference = runManeuver(0., False)
+
+    coasting = runManeuver(maximumCoastTimeStep, True)
+    np.testing.assert_allclose(coasting, reference, atol=1e-2)
+
+    unregistered = runManeuver(maximumCoastTimeStep, False)
+    assert np.linalg.norm(unregistered - reference) > 1.
+
+
+if __name__ == "__main__":
+    test_coastingIntegration(600.)
@@ -0,0 +1,115 @@
+# ISC License
+#
+# Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+import numpy as np
+import pytest
+from Basilisk.architecture import messaging
+from Basilisk.simulation import spacecraft
+from Basilisk.simulation import svIntegrators
+from Basilisk.utilities import RigidBodyKinematics as rbk
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import simIncludeGravBody
+
+
+def createSimulation(integratorCase, stepSeconds):
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(stepSeconds)))
+
+    scObject = spacecraft.Spacecraft()
+    scObject.ModelTag = "spacecraft"
+    scObject.hub.mHub = 750.0
+    scObject.hub.IHubPntBc_B = [[900., 0., 0.], [0., 800., 0.], [0., 0., 600.]]
+    scObject.hub.r_CN_NInit = [7000. * 1000, 0., 1000. * 1000]
+    scObject.hub.v_CN_NInit = [0., 7.5 * 1000, 0.]
+    scObject.hub.omega_BN_BInit = [[0.01], [-0.02], [0.03]]
+    scSim.AddModelToTask("simTask", scObject)
+
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createEarth()
+    earth.isCentralBody = True
+    gravFactory.addBodiesTo(scObject)
+
+    if integratorCase == "rk4":
+        integratorObject = svIntegrators.svIntegratorRK4(scObject)
+    else:
+        integratorObject = svIntegrators.svIntegratorRKF45(scObject)
+    scObject.setIntegrator(integratorObject)
+
+    scSim.InitializeSimulation()
+    return scSim, scObject, integratorObject, gravFactory
+
+
+@pytest.mark.parametrize("integratorCase", ["rk4", "rkf45"])
+def test_denseOutput(integratorCase):
+    r"""
+    **Validation Test Description**
+
+    With dense output enabled, the states of the spacecraft hub can be interpolated at any time
+    within the last integration step.  A spacecraft integrated with 10 second steps is sampled
+    every 0.1 seconds, and compared with a spacecraft integrated with 0.1 second steps.
+
+    **Test Parameters**
+
+    Args:
+        integratorCase (str): integrator to test
+
+    **Description of Variables Being Tested**
+
+    The interpolated position must match the reference within a millimeter and the
+    interpolated attitude within 1e-4 radians.  The interpolated states at the end of a step
+    must match the state message, and times outside of the last step must be rejected.
+    """
+    refSim, refObject, _, refGrav = createSimulation("rk4", 0.1)
+    refRecorder = refObject.scStateOutMsg.recorder()
+    refSim.AddModelToTask("simTask", refRecorder)
+    refSim.ConfigureStopTime(macros.sec2nano(60.))
+    refSim.ExecuteSimulation()
+    refTimes = refRecorder.times()
+
+    scSim, scObject, integratorObject, scGrav = createSimulation(integratorCase, 10.)
+    integratorObject.setDenseOutput(True)
+    assert integratorObject.getDenseOutput()
+
+    payload = messaging.SCStatesMsgPayload()
+    for stepEnd in np.arange(10., 61., 10.):
+        scSim.ConfigureStopTime(macros.sec2nano(stepEnd))
+        scSim.ExecuteSimulation()
+
+        for sampleTime in np.arange(stepEnd - 10., stepEnd + 0.05, 0.1):
+            sampleNanos = macros.sec2nano(sampleTime)
+            assert scObject.interpolateStates(sampleNanos, payload)
+            index = np.argmin(np.abs(refTimes - sampleNanos))
+            np.testing.assert_allclose(payload.r_BN_N, refRecorder.r_BN_N[index], atol=1e-3)
+            dcm_BR = rbk.MRP2C(payload.sigma_BN) @ rbk.MRP2C(refRecorder.sigma_BN[index]).T
+            assert np.arccos(np.clip((np.trace(dcm_BR) - 1) / 2, -1, 1)) < 1e-4
+
+        endState = scObject.scStateOutMsg.read()
+        assert scObject.interpolateStates(macros.sec2nano(stepEnd), payload)
+        np.testing.assert_allclose(payload.r_BN_N, endState.r_BN_N, atol=1e-6)
+        np.testing.assert_allclose(payload.omega_BN_B, endState.omega_BN_B, atol=1e-12)
+
+        assert not scObject.interpolateStates(macros.sec2nano(stepEnd + 1.), payload)
+
+    integratorObject.setDenseOutput(False)
+    scSim.ConfigureStopTime(macros.sec2nano(70.))
+    scSim.ExecuteSimulation()
+    assert not scObject.interpolateStates(macros.sec2nano(65.), payload)
+
+
+if __name__ == "__main__":
+    test_denseOutput("rkf45")
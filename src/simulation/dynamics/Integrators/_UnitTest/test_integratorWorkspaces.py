@@ -0,0 +1,96 @@
+# ISC License
+#
+# Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+import pytest
+from Basilisk.simulation import spacecraft
+from Basilisk.simulation import svIntegrators
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import simIncludeGravBody
+
+
+def createIntegrator(integratorCase, scObject):
+    if integratorCase == "rk4":
+        return svIntegrators.svIntegratorRK4(scObject)
+    if integratorCase == "rkf45":
+        return svIntegrators.svIntegratorRKF45(scObject)
+    if integratorCase == "rkf78":
+        return svIntegrators.svIntegratorRKF78(scObject)
+    if integratorCase == "bogackiShampine":
+        return svIntegrators.svIntegratorAdaptiveRungeKutta(
+            scObject,
+            largest_order=3,
+            a_coefficients=[
+                [0,   0,   0,   0],
+                [1/2, 0,   0,   0],
+                [0  , 3/4, 0,   0],
+                [2/9, 1/3, 4/9, 0]
+            ],
+            b_coefficients=[7/24, 1/4, 1/3, 1/8],
+            b_star_coefficients=[2/9, 1/3, 4/9, 0],
+            c_coefficients=[0, 1/2, 3/4, 1]
+        )
+
+
+@pytest.mark.parametrize("integratorCase", ["rk4", "rkf45", "rkf78", "bogackiShampine"])
+def test_integratorWorkspaces(integratorCase):
+    r"""
+    **Validation Test Description**
+
+    The Runge-Kutta integrators own their stage workspaces.  These are sized on the first
+    integration step and must be reused for the rest of the simulation.
+
+    **Test Parameters**
+
+    Args:
+        integratorCase (str): integrator to test
+
+    **Description of Variables Being Tested**
+
+    The workspace resize count of the integrator must be non-zero after the first step and
+    must not change while the simulation keeps running.  That no heap allocation is made by the
+    integration steps themselves is checked by the ``test_integratorAllocations`` C++ test.
+    """
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(10.)))
+
+    scObject = spacecraft.Spacecraft()
+    scObject.ModelTag = "spacecraftBody"
+    integratorObject = createIntegrator(integratorCase, scObject)
+    scObject.setIntegrator(integratorObject)
+    scSim.AddModelToTask("simTask", scObject)
+
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createEarth()
+    earth.isCentralBody = True
+    scObject.gravField.gravBodies = spacecraft.GravBodyVector(list(gravFactory.gravBodies.values()))
+    scObject.hub.r_CN_NInit = [7000. * 1000, 0., 0.]
+    scObject.hub.v_CN_NInit = [0., 7.5 * 1000, 0.]
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(10.))
+    scSim.ExecuteSimulation()
+    resizeCount = integratorObject.getWorkspaceResizeCount()
+    assert resizeCount > 0
+
+    scSim.ConfigureStopTime(macros.sec2nano(600.))
+    scSim.ExecuteSimulation()
+    assert integratorObject.getWorkspaceResizeCount() == resizeCount
+
+
+if __name__ == "__main__":
+    test_integratorWorkspaces("rkf45")
@@ -0,0 +1,129 @@
+# ISC License
+#
+# Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+import numpy as np
+import pytest
+from Basilisk.simulation import spacecraft
+from Basilisk.simulation import svIntegrators
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import orbitalMotion
+from Basilisk.utilities import simIncludeGravBody
+
+r0 = np.array([7000. * 1000, 0., 1000. * 1000])
+v0 = np.array([0., 7.3 * 1000, 1000.])
+
+
+def propagateOrbit(integratorCase, stepSeconds, days):
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(stepSeconds)))
+
+    scObject = spacecraft.Spacecraft()
+    scObject.ModelTag = "spacecraft"
+    scObject.hub.r_CN_NInit = r0
+    scObject.hub.v_CN_NInit = v0
+    scSim.AddModelToTask("simTask", scObject)
+
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createEarth()
+    earth.isCentralBody = True
+    gravFactory.addBodiesTo(scObject)
+
+    if integratorCase == "abm":
+        integratorObject = svIntegrators.svIntegratorAdamsBashforthMoulton(scObject)
+    elif integratorCase == "verlet":
+        integratorObject = svIntegrators.svIntegratorVerlet(scObject)
+    else:
+        integratorObject = svIntegrators.svIntegratorYoshida4(scObject)
+    scObject.setIntegrator(integratorObject)
+
+    dataLog = scObject.scStateOutMsg.recorder()
+    scSim.AddModelToTask("simTask", dataLog)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(days * 86400.))
+    scSim.ExecuteSimulation()
+
+    return integratorObject, earth.mu, dataLog
+
+
+def keplerianPosition(mu, time):
+    oe = orbitalMotion.rv2elem(mu, r0, v0)
+    n = np.sqrt(mu / oe.a**3)
+    M = orbitalMotion.E2M(orbitalMotion.f2E(oe.f, oe.e), oe.e) + n * time
+    oe.f = orbitalMotion.E2f(orbitalMotion.M2E(M % (2 * np.pi), oe.e), oe.e)
+    return np.array(orbitalMotion.elem2rv(mu, oe)[0])
+
+
+def test_adamsBashforthMoulton():
+    r"""
+    **Validation Test Description**
+
+    A low Earth orbit with point mass gravity is propagated for two days with 30 second steps by the
+    Adams-Bashforth-Moulton integrator, and compared with the Keplerian solution.
+
+    **Description of Variables Being Tested**
+
+    The final position must match the Keplerian solution within a centimeter.  The history must only
+    be started once, with as many RKF78 steps as the maximum order, and orders outside of 1 to 12
+    must be rejected.
+    """
+    integratorObject, mu, dataLog = propagateOrbit("abm", 30., 2.)
+
+    finalTime = dataLog.times()[-1] * macros.NANO2SEC
+    np.testing.assert_allclose(dataLog.r_BN_N[-1], keplerianPosition(mu, finalTime), atol=1e-2)
+    assert integratorObject.getStartupStepCount() == integratorObject.getMaximumOrder()
+    assert 1 <= integratorObject.getOrder() <= integratorObject.getMaximumOrder()
+
+    with pytest.raises(RuntimeError):
+        integratorObject.setMaximumOrder(13)
+
+
+@pytest.mark.parametrize("integratorCase, energyTolerance", [("verlet", 1e-4), ("yoshida4", 2e-6)])
+def test_symplecticIntegrators(integratorCase, energyTolerance):
+    r"""
+    **Validation Test Description**
+
+    A low Earth orbit with point mass gravity is propagated for ten days with 60 second steps by the
+    symplectic integrators, whose energy error must remain bounded instead of drifting.
+
+    **Test Parameters**
+
+    Args:
+        integratorCase (str): integrator to test
+        energyTolerance (float): largest relative energy error allowed
+
+    **Description of Variables Being Tested**
+
+    The relative energy error must stay below the tolerance, and the largest error of the last day
+    must not be larger than the largest error of the first day.
+    """
+    _, mu, dataLog = propagateOrbit(integratorCase, 60., 10.)
+
+    r = np.array(dataLog.r_BN_N)
+    v = np.array(dataLog.v_BN_N)
+    energy = 0.5 * np.sum(v * v, axis=1) - mu / np.linalg.norm(r, axis=1)
+    energyError = np.abs(energy / energy[0] - 1.)
+    assert np.max(energyError) < energyTolerance
+
+    samplesPerDay = len(energyError) // 10
+    assert np.max(energyError[-samplesPerDay:]) < 1.1 * np.max(energyError[:samplesPerDay])
+
+
+if __name__ == "__main__":
+    test_adamsBashforthMoulton()
+    test_symplecticIntegrators("yoshida4", 2e-6)
@@ -0,0 +1,101 @@
+# ISC License
+#
+# Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+import numpy as np
+import pytest
+from Basilisk import __path__
+from Basilisk.simulation import spacecraft
+from Basilisk.simulation import svIntegrators
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import simIncludeGravBody
+
+bskPath = __path__[0]
+
+
+def runFormation(integratorCase, threadCount, numberSpacecraft=8):
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(10.)))
+
+    # all spacecraft share the same gravity body
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createEarth()
+    earth.isCentralBody = True
+    earth.useSphericalHarmonicsGravityModel(bskPath + '/supportData/LocalGravData/GGM03S.txt', 10)
+
+    scObjects = []
+    recorders = []
+    for i in range(numberSpacecraft):
+        scObject = spacecraft.Spacecraft()
+        scObject.ModelTag = "spacecraft" + str(i)
+        scObject.hub.r_CN_NInit = [(7000. + 50. * i) * 1000, 0., 100. * 1000 * i]
+        scObject.hub.v_CN_NInit = [0., 7.5 * 1000 - 10. * i, 0.]
+        scObject.hub.omega_BN_BInit = [[0.001 * i], [-0.01], [0.03]]
+        gravFactory.addBodiesTo(scObject)
+        scSim.AddModelToTask("simTask", scObject)
+        recorders.append(scObject.scStateOutMsg.recorder())
+        scSim.AddModelToTask("simTask", recorders[-1])
+        scObjects.append(scObject)
+
+    if integratorCase == "rk4":
+        integratorObject = svIntegrators.svIntegratorRK4(scObjects[0])
+    else:
+        integratorObject = svIntegrators.svIntegratorRKF45(scObjects[0])
+    scObjects[0].setIntegrator(integratorObject)
+    for scObject in scObjects[1:]:
+        scObjects[0].syncDynamicsIntegration(scObject)
+    integratorObject.setThreadCount(threadCount)
+    assert integratorObject.getThreadCount() == threadCount
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(600.))
+    scSim.ExecuteSimulation()
+
+    return [(np.array(rec.r_BN_N), np.array(rec.sigma_BN), np.array(rec.omega_BN_B)) for rec in recorders]
+
+
+@pytest.mark.parametrize("integratorCase", ["rk4", "rkf45"])
+@pytest.mark.parametrize("threadCount", [2, 4])
+def test_parallelEquationsOfMotion(integratorCase, threadCount):
+    r"""
+    **Validation Test Description**
+
+    The equations of motion of spacecraft whose integration is synced can be evaluated in parallel
+    by setting the thread count of the integrator.  Each spacecraft only writes its own state
+    derivatives, so the result must not depend on the number of threads.
+
+    **Test Parameters**
+
+    Args:
+        integratorCase (str): integrator to test
+        threadCount (int): number of threads evaluating the equations of motion
+
+    **Description of Variables Being Tested**
+
+    The position, attitude and angular velocity of every spacecraft must be identical to the
+    ones obtained when the equations of motion are evaluated serially.
+    """
+    serialResults = runFormation(integratorCase, 1)
+    parallelResults = runFormation(integratorCase, threadCount)
+
+    for serial, parallel in zip(serialResults, parallelResults):
+        for serialState, parallelState in zip(serial, parallel):
+            np.testing.assert_array_equal(serialState, parallelState)
+
+
+if __name__ == "__main__":
+    test_parallelEquationsOfMotion("rk4", 4)
@@ -0,0 +1,202 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "svIntegratorAdamsBashforthMoulton.h"
+#include "svIntegratorRKF78.h"
+#include <cmath>
+#include <stdexcept>
+
+svIntegratorAdamsBashforthMoulton::svIntegratorAdamsBashforthMoulton(DynamicObject* dyn)
+    : svIntegratorRungeKutta(dyn, svIntegratorRKF78::getCoefficients())
+{
+    this->setMaximumOrder(this->maximumOrder);
+}
+
+void svIntegratorAdamsBashforthMoulton::setMaximumOrder(size_t maximumOrder)
+{
+    if (maximumOrder < 1 || maximumOrder > 12) {
+        throw std::invalid_argument("The maximum order of the Adams-Bashforth-Moulton integrator "
+                                    "must be between 1 and 12");
+    }
+
+    this->maximumOrder = maximumOrder;
+    this->order = maximumOrder;
+    this->gamma = computeCoefficients(maximumOrder + 2);
+    this->history.assign(maximumOrder + 1, Eigen::VectorXd());
+    this->backwardDifferences.assign(maximumOrder + 1, Eigen::VectorXd());
+    this->predictedDifferences.assign(maximumOrder + 2, Eigen::VectorXd());
+    this->historyNewest = 0;
+    this->historyCount = 0;
+}
+
+void svIntegratorAdamsBashforthMoulton::integrate(double currentTime, double timeStep)
+{
+    this->prepareWorkspaces();
+    this->currentState.readStates();
+    ExtendedStateVector& startDerivs = this->kValues.at(0);
+
+    // Calls that do not advance the time, such as the first update of a simulation,
+    // evaluate the equations of motion but leave the history untouched
+    if (timeStep == 0) {
+        this->computeDerivatives(currentTime, timeStep, this->currentState, startDerivs);
+        this->denseOutputSegmentCount = 0;
+        if (this->denseOutput) {
+            this->recordDenseOutputStep(currentTime, timeStep, this->currentState, startDerivs, this->currentState);
+            this->finishDenseOutput();
+        }
+        return;
+    }
+
+    if (!this->canContinueHistory(currentTime, timeStep)) {
+        this->historyCount = 0;
+        this->order = this->maximumOrder;
+    }
+
+    if (this->historyCount < this->maximumOrder) {
+        // Start-up steps are taken with the eighth order RKF78 method, whose first
+        // "k" coefficient is the derivative at the start of the step
+        this->computeKCoefficients(currentTime, timeStep, this->currentState, this->kValues);
+        this->computeNextState(timeStep, this->currentState, this->kValues, this->nextState);
+        this->pushDerivatives(startDerivs);
+        this->startupSteps++;
+    }
+    else {
+        this->computeDerivatives(currentTime, timeStep, this->currentState, startDerivs);
+        this->pushDerivatives(startDerivs);
+
+        // Backward differences of the derivatives, computed in place from the newest to the oldest
+        std::vector<Eigen::VectorXd>& differences = this->backwardDifferences;
+        const size_t differenceCount = this->historyCount;
+        for (size_t i = 0; i < differenceCount; i++) {
+            differences[i] = this->history[(this->historyNewest + this->history.size() - i) % this->history.size()];
+        }
+        for (size_t j = 1; j < differenceCount; j++) {
+            for (size_t i = differenceCount - 1; i >= j; i--) {
+                differences[i] = differences[i - 1] - differences[i];
+            }
+        }
+
+        // Predict with the Adams-Bashforth formula of the current order
+        const size_t k = this->order;
+        this->nextState = this->currentState;
+        for (size_t j = 0; j < k; j++) {
+            this->nextState.getValues() += timeStep * this->gamma[j] * differences[j];
+        }
+
+        // Evaluate the derivatives at the predicted state, and their backward differences
+        // up to those needed to estimate the error of the next higher order
+        ExtendedStateVector& predictedDerivs = this->kValues.at(1);
+        this->computeDerivatives(currentTime + timeStep, timeStep, this->nextState, predictedDerivs);
+        std::vector<Eigen::VectorXd>& predicted = this->predictedDifferences;
+        const size_t predictedCount = std::min(k + 2, this->maximumOrder + 1) + 1;
+        predicted[0] = predictedDerivs.getValues();
+        for (size_t j = 1; j < predictedCount; j++) {
+            predicted[j] = predicted[j - 1] - differences[j - 1];
+        }
+
+        // Correct with the Adams-Moulton formula, one order higher than the predictor
+        this->nextState.getValues() += timeStep * this->gamma[k] * predicted[k];
+
+        // The local error of the corrector of each order is estimated from the next backward
+        // difference, and the order with the smallest error is used for the next step
+        auto estimateError = [&](size_t estimateOrder) {
+            return std::abs(timeStep * (this->gamma[estimateOrder + 1] - this->gamma[estimateOrder])) *
+                   this->computeScaledNorm(predicted[estimateOrder + 1], this->nextState);
+        };
+        const double error = estimateError(k);
+        if (k > 1 && estimateError(k - 1) <= error) {
+            this->order = k - 1;
+        }
+        else if (k < this->maximumOrder && estimateError(k + 1) < error) {
+            this->order = k + 1;
+        }
+    }
+
+    this->nextState.setStates();
+    this->lastStates = this->nextState;
+    this->lastEndTime = currentTime + timeStep;
+    this->lastTimeStep = timeStep;
+
+    this->denseOutputSegmentCount = 0;
+    if (this->denseOutput) {
+        this->recordDenseOutputStep(currentTime, timeStep, this->currentState, startDerivs, this->nextState);
+        this->finishDenseOutput();
+    }
+}
+
+bool svIntegratorAdamsBashforthMoulton::canContinueHistory(double currentTime, double timeStep) const
+{
+    // Simulation times are integer nanoseconds, which bounds the round-off between calls
+    const double timeTolerance = 1e-9;
+    if (this->historyCount == 0 || this->lastStates.getLayout() != this->currentState.getLayout()) {
+        return false;
+    }
+    if (std::abs(currentTime - this->lastEndTime) > timeTolerance ||
+        std::abs(timeStep - this->lastTimeStep) > timeTolerance) {
+        return false;
+    }
+
+    // States modified after the last call, by an MRP switch for example, invalidate the
+    // derivatives of the previous steps, unless the derivatives do not depend on them
+    for (const auto& entry : this->currentState.getLayout()->entries) {
+        if (entry.stateData->drivesDynamics &&
+            this->currentState.at(entry) != this->lastStates.at(entry)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void svIntegratorAdamsBashforthMoulton::pushDerivatives(const ExtendedStateVector& stateDerivs)
+{
+    this->historyNewest = (this->historyNewest + 1) % this->history.size();
+    // Same size, so this copy reuses the existing storage of the history
+    this->history[this->historyNewest] = stateDerivs.getValues();
+    this->historyCount = std::min(this->historyCount + 1, this->history.size());
+}
+
+double svIntegratorAdamsBashforthMoulton::computeScaledNorm(const Eigen::VectorXd& derivDifference,
+                                                            const ExtendedStateVector& states) const
+{
+    double maxNorm = 0;
+    for (const auto& entry : states.getLayout()->entries) {
+        Eigen::Index size = entry.rows * entry.cols;
+        double stateNorm = states.getValues().segment(entry.offset, size).norm();
+        maxNorm = std::max(maxNorm, derivDifference.segment(entry.offset, size).norm() / std::max(stateNorm, 1.0));
+    }
+    return maxNorm;
+}
+
+/*! Computes the coefficients gamma_m of the Adams-Bashforth formula in backward differences,
+    y_{n+1} = y_n + h sum_m gamma_m nabla^m f_n, from the recurrence
+    sum_{j=0}^{m} gamma_j / (m + 1 - j) = 1 (Hairer, Norsett and Wanner, Solving Ordinary
+    Differential Equations I, Section III.1).
+ */
+std::vector<double> svIntegratorAdamsBashforthMoulton::computeCoefficients(size_t count)
+{
+    std::vector<double> coefficients(count, 0.0);
+    for (size_t m = 0; m < count; m++) {
+        double sum = 0;
+        for (size_t j = 0; j < m; j++) {
+            sum += coefficients[j] / double(m + 1 - j);
+        }
+        coefficients[m] = 1.0 - sum;
+    }
+    return coefficients;
+}
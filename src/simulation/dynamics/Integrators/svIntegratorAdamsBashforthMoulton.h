@@ -0,0 +1,93 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef svIntegratorAdamsBashforthMoulton_h
+#define svIntegratorAdamsBashforthMoulton_h
+
+#include "../_GeneralModuleFiles/svIntegratorRungeKutta.h"
+#include <vector>
+
+/*! @brief Variable order Adams-Bashforth-Moulton predictor-corrector integrator
+ *
+ * Each step evaluates the equations of motion twice: at the start of the step, and at the state
+ * predicted by the Adams-Bashforth formula, which is then corrected with the Adams-Moulton formula.
+ * The derivatives of the previous steps are kept, so the step must be the same on every call.
+ * The history is restarted, with RKF78 steps, on the first call, when the step or the time are not
+ * contiguous with the last call, and when states are modified between calls.
+ */
+class svIntegratorAdamsBashforthMoulton : public svIntegratorRungeKutta<13> {
+  public:
+    svIntegratorAdamsBashforthMoulton(DynamicObject* dyn); //!< class method
+
+    /** Performs the integration of the associated dynamic objects up to time currentTime+timeStep */
+    virtual void integrate(double currentTime, double timeStep) override;
+
+    /** Sets the largest order of the predictor, between 1 and 12, which restarts the history */
+    void setMaximumOrder(size_t maximumOrder);
+
+    /** Returns the largest order of the predictor */
+    size_t getMaximumOrder() const { return this->maximumOrder; }
+
+    /** Returns the order of the predictor used for the next step, the corrector is one order higher */
+    size_t getOrder() const { return this->order; }
+
+    /** Returns the number of steps taken with RKF78 to (re)start the history */
+    uint64_t getStartupStepCount() const { return this->startupSteps; }
+
+  protected:
+    /** Returns true if the history of derivatives can be used for a step from currentTime */
+    bool canContinueHistory(double currentTime, double timeStep) const;
+
+    /** Stores the derivatives at the start of the current step as the newest in the history */
+    void pushDerivatives(const ExtendedStateVector& stateDerivs);
+
+    /**
+     * Returns the largest ratio, over every state, between the norm of the given derivative
+     * difference and the norm of the state, or one if the state is smaller than one.
+     */
+    double computeScaledNorm(const Eigen::VectorXd& derivDifference, const ExtendedStateVector& states) const;
+
+    /** Adams-Bashforth coefficients of the backward differences, see computeCoefficients */
+    static std::vector<double> computeCoefficients(size_t count);
+
+  protected:
+    size_t maximumOrder = 10; /**< Largest order of the predictor */
+    size_t order = 10;        /**< Order of the predictor for the next step */
+
+    std::vector<double> gamma; /**< Adams-Bashforth coefficients of the backward differences */
+
+    /** Derivatives at the start of the last steps, newest at historyNewest */
+    std::vector<Eigen::VectorXd> history;
+    size_t historyNewest = 0; /**< Index of the newest derivatives in history */
+    size_t historyCount = 0;  /**< Number of valid derivatives in history */
+
+    /** Backward differences of the derivatives at the start of the step */
+    std::vector<Eigen::VectorXd> backwardDifferences;
+
+    /** Backward differences of the derivatives at the predicted state */
+    std::vector<Eigen::VectorXd> predictedDifferences;
+
+    ExtendedStateVector lastStates; /**< States written to the dynamic objects at the end of the last call */
+    double lastEndTime = 0;         /**< [s] Time at the end of the last call */
+    double lastTimeStep = 0;        /**< [s] Step of the last call */
+
+    uint64_t startupSteps = 0; /**< Number of RKF78 steps, see getStartupStepCount */
+};
+
+#endif /* svIntegratorAdamsBashforthMoulton_h */
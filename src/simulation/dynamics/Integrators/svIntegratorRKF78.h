@@ -28,6 +28,9 @@ class svIntegratorRKF78 : public svIntegratorAdaptiveRungeKutta<13> {
     svIntegratorRKF78(DynamicObject* dyn); //!< class method
   private:
     static RKAdaptiveCoefficients<13> getCoefficients();
+
+    // The multistep integrators take their start-up steps with the eighth order method
+    friend class svIntegratorAdamsBashforthMoulton;
 };
 
 #endif /* svIntegratorRKF78_h */
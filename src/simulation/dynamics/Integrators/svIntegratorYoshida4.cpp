@@ -0,0 +1,41 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "svIntegratorYoshida4.h"
+#include <cmath>
+
+// From Haruo Yoshida (1990) Construction of higher order symplectic integrators.
+// Physics Letters A 150, 262-268
+static const double yoshidaW1 = 1.0 / (2.0 - std::cbrt(2.0));
+static const double yoshidaW0 = -std::cbrt(2.0) / (2.0 - std::cbrt(2.0));
+
+svIntegratorYoshida4::svIntegratorYoshida4(DynamicObject* dyn)
+    : svIntegratorSymplectic(dyn, svIntegratorYoshida4::getDriftCoefficients(), svIntegratorYoshida4::getKickCoefficients())
+{
+}
+
+std::vector<double> svIntegratorYoshida4::getDriftCoefficients()
+{
+    return {yoshidaW1 / 2.0, (yoshidaW0 + yoshidaW1) / 2.0, (yoshidaW0 + yoshidaW1) / 2.0, yoshidaW1 / 2.0};
+}
+
+std::vector<double> svIntegratorYoshida4::getKickCoefficients()
+{
+    return {yoshidaW1, yoshidaW0, yoshidaW1, 0.0};
+}
@@ -0,0 +1,34 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef svIntegratorYoshida4_h
+#define svIntegratorYoshida4_h
+
+#include "../_GeneralModuleFiles/svIntegratorSymplectic.h"
+
+/*! @brief 4th order symplectic integrator of Yoshida, a composition of three Stormer-Verlet steps */
+class svIntegratorYoshida4 : public svIntegratorSymplectic {
+  public:
+    svIntegratorYoshida4(DynamicObject* dyn); //!< class method
+  private:
+    static std::vector<double> getDriftCoefficients();
+    static std::vector<double> getKickCoefficients();
+};
+
+#endif /* svIntegratorYoshida4_h */
@@ -27,6 +27,10 @@
    #include "svIntegratorRK2.h"
    #include "svIntegratorRKF45.h"
    #include "svIntegratorRKF78.h"
+   #include "svIntegratorAdamsBashforthMoulton.h"
+   #include "../_GeneralModuleFiles/svIntegratorSymplectic.h"
+   #include "svIntegratorVerlet.h"
+   #include "svIntegratorYoshida4.h"
    #include "architecture/_GeneralModuleFiles/sys_model.h"
    #include "../_GeneralModuleFiles/dynamicObject.h"
 %}
@@ -39,6 +43,17 @@ _rk_base_classes = {}
 _rk_adaptive_base_classes = {}
 %}
 
+%include "exception.i"
+
+// Invalid coefficients, orders or dynamic objects are reported as Python exceptions
+%exception {
+  try {
+    $action
+  } catch (const std::exception& e) {
+    SWIG_exception(SWIG_RuntimeError, e.what());
+  }
+}
+
 %include <std_vector.i>
 %template() std::vector<double>;
 %template() std::vector<std::vector<double>>;
@@ -53,6 +68,10 @@ _rk_adaptive_base_classes = {}
 }
 
 %include "sys_model.i"
+
+// Interpolated states are returned through an Eigen::MatrixXd reference, which is meant for C++ modules.
+// Python users read the interpolated states of a spacecraft with Spacecraft.interpolateStates.
+%ignore getInterpolatedState;
 %include "../_GeneralModuleFiles/stateVecIntegrator.h"
 
 %include "../_GeneralModuleFiles/svIntegratorRungeKutta.h"
@@ -129,6 +148,11 @@ TEMPLATE_HELPER(13)
 %include "svIntegratorRK2.h"
 %include "svIntegratorRKF45.h"
 %include "svIntegratorRKF78.h"
+%include "svIntegratorAdamsBashforthMoulton.h"
+
+%include "../_GeneralModuleFiles/svIntegratorSymplectic.h"
+%include "svIntegratorVerlet.h"
+%include "svIntegratorYoshida4.h"
 
 // The following methods allow users to create new Runge-Kutta
 // methods simply by providing their coefficients on the Python side
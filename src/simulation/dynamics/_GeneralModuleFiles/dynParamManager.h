@@ -48,6 +48,15 @@ public:
     DynParamManager();
     ~DynParamManager();
     StateData* registerState(uint32_t nRow, uint32_t nCol, std::string stateName); //!< class method
+
+    /*! Registers a state with the size of the fixed-size Eigen type T, such as Eigen::Vector3d, whose values can then
+     be accessed without copies through StateData::getStateAs<T>() */
+    template <typename T>
+    StateData* registerState(std::string stateName)
+    {
+        static_assert(T::SizeAtCompileTime != Eigen::Dynamic, "The state type must have a fixed size");
+        return this->registerState(T::RowsAtCompileTime, T::ColsAtCompileTime, stateName);
+    }
     StateData* getStateObject(std::string stateName); //!< class method
     StateVector getStateVector(); //!< class method
     void updateStateVector(const StateVector & newState); //!< class method
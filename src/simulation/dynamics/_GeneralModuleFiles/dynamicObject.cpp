@@ -56,6 +56,15 @@ void DynamicObject::syncDynamicsIntegration(DynamicObject* dynPtr)
 {
     this->integrator->dynPtrs.push_back(dynPtr);
     dynPtr->isDynamicsSynced = true;
+    dynPtr->syncedPrimary = this;
+}
+
+StateVecIntegrator* DynamicObject::getActiveIntegrator() const
+{
+    if (this->isDynamicsSynced && this->syncedPrimary) {
+        return this->syncedPrimary->getActiveIntegrator();
+    }
+    return this->integrator;
 }
 
 void DynamicObject::integrateState(double integrateToThisTime)
@@ -75,9 +75,14 @@ class DynamicObject : public SysModel {
     /** Connects the integration of a DynamicObject to the integration of this DynamicObject. */
     void syncDynamicsIntegration(DynamicObject* dynPtr);
 
+    /** Returns the integrator that propagates the states of this DynamicObject, which is the
+     * integrator of the primary DynamicObject when the integration is synced */
+    StateVecIntegrator* getActiveIntegrator() const;
+
   public:
     /** flag indicating that another spacecraft object is controlling the integration */
     bool isDynamicsSynced = false;
+    DynamicObject* syncedPrimary = nullptr; /**< DynamicObject controlling the integration, if synced */
     double timeStep;   /**< [s] integration time step */
     double timeBefore; /**< [s] prior time value */
 };
@@ -18,91 +18,189 @@
  */
 
 #include "extendedStateVector.h"
+#include <stdexcept>
+
+std::shared_ptr<const ExtendedStateLayout>
+ExtendedStateLayout::fromDynObjects(const std::vector<DynamicObject*>& dynPtrs)
+{
+    auto layout = std::make_shared<ExtendedStateLayout>();
+
+    for (size_t dynIndex = 0; dynIndex < dynPtrs.size(); dynIndex++) {
+        layout->dynObjects.push_back(dynPtrs.at(dynIndex));
+        for (auto&& [stateName, stateData] :
+             dynPtrs.at(dynIndex)->dynManager.stateContainer.stateMap) {
+            ExtendedStateLayoutEntry entry;
+            entry.id = std::make_pair(dynIndex, stateName);
+            entry.stateData = &stateData;
+            entry.offset = layout->size;
+            entry.rows = stateData.state.rows();
+            entry.cols = stateData.state.cols();
+            layout->size += entry.rows * entry.cols;
+            layout->entries.push_back(entry);
+        }
+    }
+
+    return layout;
+}
+
+bool ExtendedStateLayout::isValidFor(const std::vector<DynamicObject*>& dynPtrs) const
+{
+    if (dynPtrs.size() != this->dynObjects.size()) return false;
+
+    size_t numberStates = 0;
+    for (size_t dynIndex = 0; dynIndex < dynPtrs.size(); dynIndex++) {
+        if (dynPtrs[dynIndex] != this->dynObjects[dynIndex]) return false;
+        numberStates += dynPtrs[dynIndex]->dynManager.stateContainer.stateMap.size();
+    }
+    if (numberStates != this->entries.size()) return false;
+
+    for (const auto& entry : this->entries) {
+        if (entry.stateData->state.rows() != entry.rows ||
+            entry.stateData->state.cols() != entry.cols) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int64_t ExtendedStateLayout::findEntry(const ExtendedStateId& id) const
+{
+    for (size_t i = 0; i < this->entries.size(); i++) {
+        if (this->entries[i].id == id) return static_cast<int64_t>(i);
+    }
+    return -1;
+}
+
+ExtendedStateVector::ExtendedStateVector(std::shared_ptr<const ExtendedStateLayout> layout)
+    : layout(std::move(layout))
+{
+    this->values = Eigen::VectorXd::Zero(this->layout->size);
+}
 
 ExtendedStateVector ExtendedStateVector::fromStates(const std::vector<DynamicObject*>& dynPtrs)
 {
-    return fromStateData(dynPtrs, [](const StateData& data) { return data.getState(); });
+    ExtendedStateVector result(ExtendedStateLayout::fromDynObjects(dynPtrs));
+    result.readStates();
+    return result;
 }
 
 ExtendedStateVector ExtendedStateVector::fromStateDerivs(const std::vector<DynamicObject*>& dynPtrs)
 {
-    return fromStateData(dynPtrs, [](const StateData& data) { return data.getStateDeriv(); });
+    ExtendedStateVector result(ExtendedStateLayout::fromDynObjects(dynPtrs));
+    result.readStateDerivs();
+    return result;
+}
+
+void ExtendedStateVector::readStates()
+{
+    for (const auto& entry : this->layout->entries) {
+        this->values.segment(entry.offset, entry.rows * entry.cols) =
+            Eigen::Map<const Eigen::VectorXd>(entry.stateData->state.data(), entry.rows * entry.cols);
+    }
+}
+
+void ExtendedStateVector::readStateDerivs()
+{
+    for (const auto& entry : this->layout->entries) {
+        this->values.segment(entry.offset, entry.rows * entry.cols) =
+            Eigen::Map<const Eigen::VectorXd>(entry.stateData->stateDeriv.data(),
+                                              entry.rows * entry.cols);
+    }
 }
 
 ExtendedStateVector ExtendedStateVector::map(
-    std::function<Eigen::MatrixXd(const size_t&, const std::string&, const Eigen::MatrixXd&)>
-        functor) const
+    std::function<Eigen::MatrixXd(const size_t&,
+                                  const std::string&,
+                                  const Eigen::Ref<const Eigen::MatrixXd>&)> functor) const
 {
-    ExtendedStateVector result;
-    result.reserve(this->size());
+    ExtendedStateVector result(this->layout);
 
-    for (auto&& [extendedStateId, stateMatrix] : *this) {
-        const auto& [dynObjIndex, stateName] = extendedStateId;
-        result.emplace(extendedStateId, functor(dynObjIndex, stateName, stateMatrix));
+    for (const auto& entry : this->layout->entries) {
+        const auto& [dynObjIndex, stateName] = entry.id;
+        Eigen::Map<Eigen::MatrixXd>(result.values.data() + entry.offset, entry.rows, entry.cols) =
+            functor(dynObjIndex, stateName, this->at(entry));
     }
 
     return result;
 }
 
 void ExtendedStateVector::apply(
-    std::function<void(const size_t&, const std::string&, const Eigen::MatrixXd&)> functor) const
+    std::function<void(const size_t&, const std::string&, const Eigen::Ref<const Eigen::MatrixXd>&)>
+        functor) const
 {
-    for (auto&& [extendedStateId, stateMatrix] : *this) {
-        const auto& [dynObjIndex, stateName] = extendedStateId;
-        functor(dynObjIndex, stateName, stateMatrix);
+    for (const auto& entry : this->layout->entries) {
+        const auto& [dynObjIndex, stateName] = entry.id;
+        functor(dynObjIndex, stateName, this->at(entry));
     }
 }
 
 void ExtendedStateVector::modify(
-    std::function<void(const size_t&, const std::string&, Eigen::MatrixXd&)> functor)
+    std::function<void(const size_t&, const std::string&, Eigen::Ref<Eigen::MatrixXd>)> functor)
 {
-    for (auto&& [extendedStateId, stateMatrix] : *this) {
-        const auto& [dynObjIndex, stateName] = extendedStateId;
+    for (const auto& entry : this->layout->entries) {
+        const auto& [dynObjIndex, stateName] = entry.id;
+        Eigen::Map<Eigen::MatrixXd> stateMatrix(this->values.data() + entry.offset,
+                                                entry.rows,
+                                                entry.cols);
         functor(dynObjIndex, stateName, stateMatrix);
     }
 }
 
-ExtendedStateVector ExtendedStateVector::operator+=(const ExtendedStateVector& rhs)
+ExtendedStateVector& ExtendedStateVector::operator+=(const ExtendedStateVector& rhs)
 {
-    this->modify([&rhs](const size_t& dynObjIndex,
-                        const std::string& stateName,
-                        Eigen::MatrixXd& thisState) {
-        thisState += rhs.at({dynObjIndex, stateName});
-    });
+    this->values += rhs.values;
+    return *this;
+}
 
+ExtendedStateVector& ExtendedStateVector::addScaled(const ExtendedStateVector& rhs,
+                                                    double scaleFactor)
+{
+    this->values += scaleFactor * rhs.values;
     return *this;
 }
 
 ExtendedStateVector ExtendedStateVector::operator*(const double rhs) const
 {
-    return this->map([rhs](const size_t& dynObjIndex,
-                           const std::string& stateName,
-                           const Eigen::MatrixXd& thisState) { return thisState * rhs; });
+    ExtendedStateVector result;
+    result.layout = this->layout;
+    result.values = this->values * rhs;
+    return result;
 }
 
-void ExtendedStateVector::setStates(std::vector<DynamicObject*>& dynPtrs) const
+ExtendedStateVector& ExtendedStateVector::setScaled(const ExtendedStateVector& rhs,
+                                                    double scaleFactor)
 {
-    this->apply([&dynPtrs](const size_t& dynObjIndex,
-                                 const std::string& stateName,
-                                 const Eigen::MatrixXd& thisState) {
-        StateData& stateData =
-            dynPtrs.at(dynObjIndex)->dynManager.stateContainer.stateMap.at(stateName);
-        stateData.setState(thisState);
-    });
+    this->values.noalias() = rhs.values * scaleFactor;
+    return *this;
 }
 
-ExtendedStateVector
-ExtendedStateVector::fromStateData(const std::vector<DynamicObject*>& dynPtrs,
-                                   std::function<Eigen::MatrixXd(const StateData&)> functor)
+bool ExtendedStateVector::resize(std::shared_ptr<const ExtendedStateLayout> newLayout)
 {
-    ExtendedStateVector result;
+    if (this->layout == newLayout) return false;
 
-    for (size_t dynIndex = 0; dynIndex < dynPtrs.size(); dynIndex++) {
-        for (auto&& [stateName, stateData] :
-             dynPtrs.at(dynIndex)->dynManager.stateContainer.stateMap) {
-            result.emplace(std::make_pair(dynIndex, stateName), functor(stateData));
-        }
+    bool reallocate = this->values.size() != newLayout->size;
+    this->layout = std::move(newLayout);
+    if (reallocate) {
+        this->values = Eigen::VectorXd::Zero(this->layout->size);
     }
+    return reallocate;
+}
 
-    return result;
+void ExtendedStateVector::setStates() const
+{
+    for (const auto& entry : this->layout->entries) {
+        Eigen::Map<Eigen::VectorXd>(entry.stateData->state.data(), entry.rows * entry.cols) =
+            this->values.segment(entry.offset, entry.rows * entry.cols);
+    }
+}
+
+Eigen::Map<const Eigen::MatrixXd> ExtendedStateVector::at(const ExtendedStateId& id) const
+{
+    int64_t entryIndex = this->layout ? this->layout->findEntry(id) : -1;
+    if (entryIndex < 0) {
+        throw std::out_of_range("The ExtendedStateVector has no state named " + id.second +
+                                " for the DynamicObject of index " + std::to_string(id.first));
+    }
+    return this->at(this->layout->entries.at(entryIndex));
 }
@@ -25,6 +25,7 @@
 
 #include <Eigen/Dense>
 #include <functional>
+#include <memory>
 #include <stdint.h>
 #include <unordered_map>
 
@@ -40,12 +41,19 @@ which in practice means that all states of all DynamicObjects need to
 be integrated in parallel.
 
 In order to facilitate this task, the ExtendedStateVector was created.
-This class is a map that can hold an Eigen::MatrixXd for every state
-of every DynamicObject that we want to integrate. Thus, it can be
+This class holds the value of every state of every DynamicObject that we
+want to integrate in a single, contiguous Eigen::VectorXd. Thus, it can be
 used to store the value of the states, their derivatives, errors...
 in a single, flat object. This is similar to the behaviour of StateVector,
 except that this supports multiple DynamicObjects.
 
+Where each state lives inside the flat storage is described by an
+ExtendedStateLayout. The layout is resolved once, after the states have
+been registered, and is then shared by every ExtendedStateVector built
+for the same set of DynamicObjects. State-wise operations (addition,
+scaling...) then become single operations on the flat storage, which
+avoids hashing state names and allocating one matrix per state.
+
 ExtendedStateVector supports a series of utility functions that
 makes performing state-wise operations easier.
 */
@@ -71,15 +79,56 @@ struct ExtendedStateIdHash {
     }
 };
 
+/** Describes where a single state is stored inside the flat storage of an ExtendedStateVector */
+struct ExtendedStateLayoutEntry {
+    ExtendedStateId id;           /**< Index of the DynamicObject and name of the state */
+    StateData* stateData;         /**< State object the entry is read from and written to */
+    Eigen::Index offset;          /**< Index of the first element of the state in the flat storage */
+    Eigen::Index rows;            /**< Number of rows of the state matrix */
+    Eigen::Index cols;            /**< Number of columns of the state matrix */
+};
+
+/**
+ * Maps every state of a set of DynamicObject to a segment of a flat vector.
+ *
+ * States are laid out in order of DynamicObject, then in order of state name.
+ * Matrix states are stored column-major, like Eigen::MatrixXd.
+ */
+class ExtendedStateLayout {
+  public:
+    /** Builds the layout of all the states registered in the given dynamic objects */
+    static std::shared_ptr<const ExtendedStateLayout>
+    fromDynObjects(const std::vector<DynamicObject*>& dynPtrs);
+
+    /**
+     * Returns true if this layout still describes the states of the given
+     * dynamic objects, i.e. no state was added or resized since it was built.
+     */
+    bool isValidFor(const std::vector<DynamicObject*>& dynPtrs) const;
+
+    /** Returns the index of the entry with the given id, or -1 if there is no such state */
+    int64_t findEntry(const ExtendedStateId& id) const;
+
+    std::vector<ExtendedStateLayoutEntry> entries; /**< One entry per state */
+    Eigen::Index size = 0;                         /**< Total number of scalars of all states */
+
+  private:
+    std::vector<const DynamicObject*> dynObjects;  /**< Dynamic objects the layout was built for */
+};
+
 /**
  * Conceptually similar to StateVector, this class allows us to handle
  * the states of multiple DynamicObject with a single object.
  *
  * It also supports several utility functions.
  */
-class ExtendedStateVector
-    : public std::unordered_map<ExtendedStateId, Eigen::MatrixXd, ExtendedStateIdHash> {
+class ExtendedStateVector {
   public:
+    ExtendedStateVector() = default;
+
+    /** Builds a zero-valued ExtendedStateVector with the given layout */
+    explicit ExtendedStateVector(std::shared_ptr<const ExtendedStateLayout> layout);
+
     /**
      * Builds a ExtendedStateVector from all states in the given
      * dynamic objects
@@ -92,6 +141,12 @@ class ExtendedStateVector
      */
     static ExtendedStateVector fromStateDerivs(const std::vector<DynamicObject*>& dynPtrs);
 
+    /** Copies the current value of every state into this (layout must be set) */
+    void readStates();
+
+    /** Copies the current derivative of every state into this (layout must be set) */
+    void readStateDerivs();
+
     /**
      * This method will call the given std::function for every
      * state in the ExtendedStateVector. The arguments to the functor
@@ -101,39 +156,83 @@ class ExtendedStateVector
      * of the functor.
      */
     ExtendedStateVector
-    map(std::function<Eigen::MatrixXd(const size_t&, const std::string&, const Eigen::MatrixXd&)>
-            functor) const;
+    map(std::function<Eigen::MatrixXd(const size_t&,
+                                      const std::string&,
+                                      const Eigen::Ref<const Eigen::MatrixXd>&)> functor) const;
 
     /**
      * Similar to the map method, except that no
      * ExtendedStateVector is returned because the given functor
      * does not produce any values.
      */
-    void apply(std::function<void(const size_t&, const std::string&, const Eigen::MatrixXd&)>
-                   functor) const;
+    void apply(std::function<void(const size_t&,
+                                  const std::string&,
+                                  const Eigen::Ref<const Eigen::MatrixXd>&)> functor) const;
 
     /**
-     * Modifies each Eigen::MatrixXd stored in this object according to
+     * Modifies each state stored in this object according to
      * the given functor
      */
-    void modify(std::function<void(const size_t&, const std::string&, Eigen::MatrixXd&)> functor);
+    void modify(std::function<void(const size_t&, const std::string&, Eigen::Ref<Eigen::MatrixXd>)>
+                    functor);
 
     /** Adds the values of `rhs` to this
      *
      * This functions as a state-wise addition operation.
      */
-    ExtendedStateVector operator+=(const ExtendedStateVector& rhs);
+    ExtendedStateVector& operator+=(const ExtendedStateVector& rhs);
+
+    /** Adds the values of `rhs`, multiplied by `scaleFactor`, to this
+     *
+     * Equivalent to `*this += rhs * scaleFactor`, without building the temporary.
+     */
+    ExtendedStateVector& addScaled(const ExtendedStateVector& rhs, double scaleFactor);
 
     /** Returns a new ExtendedStateVector that is the result of multiplying each state by a constant
      */
     ExtendedStateVector operator*(const double rhs) const;
 
-    /** Calls StateData::setState for every entry in in this */
-    void setStates(std::vector<DynamicObject*>& dynPtrs) const;
+    /** Sets this to the values of `rhs` multiplied by `scaleFactor`
+     *
+     * Equivalent to `*this = rhs * scaleFactor`, but reuses the storage of this.
+     */
+    ExtendedStateVector& setScaled(const ExtendedStateVector& rhs, double scaleFactor);
+
+    /**
+     * Makes this vector use the given layout. Storage is only (re)allocated, and zeroed,
+     * when the size of the layout differs from the current size.
+     *
+     * Returns true if the storage was (re)allocated.
+     */
+    bool resize(std::shared_ptr<const ExtendedStateLayout> newLayout);
+
+    /** Writes every entry in this back into its StateData */
+    void setStates() const;
+
+    /** Returns a view of the state with the given id. Throws std::out_of_range if there is no such state */
+    Eigen::Map<const Eigen::MatrixXd> at(const ExtendedStateId& id) const;
+
+    /** Returns the view of the state described by the given layout entry */
+    Eigen::Map<const Eigen::MatrixXd> at(const ExtendedStateLayoutEntry& entry) const
+    {
+        return Eigen::Map<const Eigen::MatrixXd>(this->values.data() + entry.offset, entry.rows, entry.cols);
+    }
+
+    /** Returns the number of states stored in this */
+    size_t size() const { return this->layout ? this->layout->entries.size() : 0; }
+
+    /** Returns the layout that describes the flat storage */
+    const std::shared_ptr<const ExtendedStateLayout>& getLayout() const { return this->layout; }
+
+    /** Returns the flat storage of all states */
+    const Eigen::VectorXd& getValues() const { return this->values; }
+
+    /** Returns the flat storage of all states */
+    Eigen::VectorXd& getValues() { return this->values; }
 
   private:
-    static ExtendedStateVector fromStateData(const std::vector<DynamicObject*>& dynPtrs,
-                                             std::function<Eigen::MatrixXd(const StateData&)>);
+    std::shared_ptr<const ExtendedStateLayout> layout; /**< Location of every state in values */
+    Eigen::VectorXd values;                            /**< Flat storage of every state */
 };
 
 #endif /* extendedStateVector_h */
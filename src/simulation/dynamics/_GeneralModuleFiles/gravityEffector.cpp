@@ -65,7 +65,8 @@ void GravBodyData::initBody(int64_t moduleID)
     }
 }
 
-Eigen::Vector3d GravBodyData::computeGravityInertial(Eigen::Vector3d r_I, uint64_t simTimeNanos)
+Eigen::Matrix3d GravBodyData::computePlanetAttitude(uint64_t simTimeNanos,
+                                                    Eigen::Matrix3d& dcm_PfixN_dot)
 {
     double dt = computeDtInSeconds(simTimeNanos, this->timeWritten);
     Eigen::Matrix3d dcm_PfixN = c2DArray2EigenMatrix3d(this->localPlanet.J20002Pfix).transpose();
@@ -74,13 +75,16 @@ Eigen::Vector3d GravBodyData::computeGravityInertial(Eigen::Vector3d r_I, uint64
         dcm_PfixN = Eigen::Matrix3d::Identity();
     }
 
-    Eigen::Matrix3d dcm_PfixN_dot =
-        c2DArray2EigenMatrix3d(this->localPlanet.J20002Pfix_dot).transpose();
+    dcm_PfixN_dot = c2DArray2EigenMatrix3d(this->localPlanet.J20002Pfix_dot).transpose();
     dcm_PfixN += dcm_PfixN_dot * dt;
 
-    // store the current planet orientation and rates
-    *this->J20002Pfix = dcm_PfixN;
-    *this->J20002Pfix_dot = dcm_PfixN_dot;
+    return dcm_PfixN;
+}
+
+Eigen::Vector3d GravBodyData::computeGravityInertial(Eigen::Vector3d r_I, uint64_t simTimeNanos)
+{
+    Eigen::Matrix3d dcm_PfixN_dot;
+    Eigen::Matrix3d dcm_PfixN = this->computePlanetAttitude(simTimeNanos, dcm_PfixN_dot);
 
     // Compute position in the body-fixed reference frame and compute the gravity
     Eigen::Matrix3d dcm_NPfix = dcm_PfixN.transpose();
@@ -185,8 +189,11 @@ void GravityEffector::registerProperties(DynParamManager& statesIn)
 
     // register planet position and velocity state vectors as parameters in the
     // state engine
+    this->planetStateProperties.clear();
     for (auto&& body : this->gravBodies) {
         body->registerProperties(statesIn);
+        this->planetStateProperties.push_back(
+            {body->r_PN_N, body->v_PN_N, body->muPlanet, body->J20002Pfix, body->J20002Pfix_dot});
     }
 }
 
@@ -215,7 +222,8 @@ void GravityEffector::computeGravityField(Eigen::Vector3d r_cF_N, Eigen::Vector3
     // acceleration of CoM of s/c wrt Frame in which it is stored/integrated in spacecraft
     Eigen::Vector3d rDotDot_cF_N = Eigen::Vector3d::Zero();
 
-    for (auto&& body : this->gravBodies) {
+    for (size_t bodyIndex = 0; bodyIndex < this->gravBodies.size(); bodyIndex++) {
+        const auto& body = this->gravBodies[bodyIndex];
         // position of Planet being queried wrt N
         Eigen::Vector3d r_PN_N = getEulerSteppedGravBodyPosition(body);
         Eigen::Vector3d r_cP_N = r_cN_N - r_PN_N; // position of s/c CoM wrt planet in N
@@ -231,10 +239,16 @@ void GravityEffector::computeGravityField(Eigen::Vector3d r_cF_N, Eigen::Vector3
         // acceleration of c wrt N in N, due to P
         rDotDot_cF_N += body->computeGravityInertial(r_cP_N, systemClock);
 
-        // store planet states in the state engine parameters
-        *(body->r_PN_N) = r_PN_N;
-        *(body->v_PN_N) = cArray2EigenVector3d(body->localPlanet.VelocityVector);
-        (*(body->muPlanet))(0, 0) = body->mu;
+        // store planet states in the state engine parameters of this spacecraft
+        if (bodyIndex < this->planetStateProperties.size()) {
+            const PlanetStateProperties& properties = this->planetStateProperties[bodyIndex];
+            *(properties.r_PN_N) = r_PN_N;
+            *(properties.v_PN_N) = cArray2EigenVector3d(body->localPlanet.VelocityVector);
+            (*(properties.muPlanet))(0, 0) = body->mu;
+            Eigen::Matrix3d dcm_PfixN_dot;
+            *(properties.J20002Pfix) = body->computePlanetAttitude(systemClock, dcm_PfixN_dot);
+            *(properties.J20002Pfix_dot) = dcm_PfixN_dot;
+        }
     }
 
     *this->gravProperty = rDotDot_cF_N;
@@ -258,13 +272,34 @@ void GravityEffector::updateInertialPosAndVel(Eigen::Vector3d r_BF_N, Eigen::Vec
     }
 }
 
+void GravityEffector::computeInertialPosAndVel(const Eigen::Vector3d& r_BF_N,
+                                               const Eigen::Vector3d& rDot_BF_N,
+                                               uint64_t simTimeNanos,
+                                               Eigen::Vector3d& r_BN_N,
+                                               Eigen::Vector3d& rDot_BN_N) const
+{
+    r_BN_N = r_BF_N;
+    rDot_BN_N = rDot_BF_N;
+    if (this->centralBody) // If there is a central body
+    {
+        r_BN_N += getEulerSteppedGravBodyPosition(*this->centralBody, simTimeNanos);
+        rDot_BN_N += cArray2EigenVector3d(this->centralBody->localPlanet.VelocityVector);
+    }
+}
+
 Eigen::Vector3d
 GravityEffector::getEulerSteppedGravBodyPosition(std::shared_ptr<GravBodyData> bodyData)
 {
     uint64_t systemClock = (uint64_t)this->timeCorr->data()[0];
-    double dt = computeDtInSeconds(systemClock, bodyData->timeWritten);
-    Eigen::Vector3d r_PN_N = cArray2EigenVector3d(bodyData->localPlanet.PositionVector);
-    r_PN_N += cArray2EigenVector3d(bodyData->localPlanet.VelocityVector) * dt;
+    return getEulerSteppedGravBodyPosition(*bodyData, systemClock);
+}
+
+Eigen::Vector3d GravityEffector::getEulerSteppedGravBodyPosition(const GravBodyData& bodyData,
+                                                                 uint64_t simTimeNanos)
+{
+    double dt = computeDtInSeconds(simTimeNanos, bodyData.timeWritten);
+    Eigen::Vector3d r_PN_N = Eigen::Map<const Eigen::Vector3d>(bodyData.localPlanet.PositionVector);
+    r_PN_N += Eigen::Map<const Eigen::Vector3d>(bodyData.localPlanet.VelocityVector) * dt;
     return r_PN_N;
 }
 
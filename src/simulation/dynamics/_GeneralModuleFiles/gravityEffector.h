@@ -105,6 +105,12 @@ private:
     Eigen::MatrixXd *J20002Pfix_dot; /**< [m/s]    (state engine property) planet attitude rate [PN_dot] */
 
     uint64_t timeWritten = 0; /**< [ns]     time the input planet state message was written */
+
+    /** Computes the planet attitude [PfixN] at the given time and its rate [PfixN_dot].
+     *
+     * The body is not modified, so several spacecraft can evaluate it concurrently.
+     */
+    Eigen::Matrix3d computePlanetAttitude(uint64_t simTimeNanos, Eigen::Matrix3d& dcm_PfixN_dot);
 };
 
 /*! @brief gravity effector class */
@@ -136,6 +142,18 @@ public:
     /** Updates the inertial position and velocity properties */
     void updateInertialPosAndVel(Eigen::Vector3d r_BF_N, Eigen::Vector3d rDot_BF_N);
 
+    /** Computes the inertial position and velocity of a point given relative to the integration frame
+     *
+     *   @param r_BF_N position of the point wrt the integration frame
+     *   @param rDot_BF_N velocity of the point wrt the integration frame
+     *   @param simTimeNanos [ns] time at which the central body position is evaluated
+     *   @param r_BN_N resulting inertial position
+     *   @param rDot_BN_N resulting inertial velocity
+     */
+    void computeInertialPosAndVel(const Eigen::Vector3d& r_BF_N, const Eigen::Vector3d& rDot_BF_N,
+                                  uint64_t simTimeNanos, Eigen::Vector3d& r_BN_N,
+                                  Eigen::Vector3d& rDot_BN_N) const;
+
     /** Computes the Potential Energy Contributions from every associated `GravBodyData` */
     void updateEnergyContributions(Eigen::Vector3d r_CN_N, double &orbPotEnergyContr);
 
@@ -159,6 +177,26 @@ private:
     */
     Eigen::Vector3d getEulerSteppedGravBodyPosition(std::shared_ptr<GravBodyData> bodyData);
 
+    /**
+        Compute planet position with Euler integration at the given time
+        @param bodyData planet data
+        @param simTimeNanos [ns] time of the planet position
+    */
+    static Eigen::Vector3d getEulerSteppedGravBodyPosition(const GravBodyData& bodyData, uint64_t simTimeNanos);
+
+    /** State engine properties of the planet states of one body, registered in the dynamics
+     *  manager of the spacecraft of this effector. Bodies can be shared by several spacecraft,
+     *  so each effector keeps its own properties instead of using the ones stored in the body.
+     */
+    struct PlanetStateProperties {
+        Eigen::MatrixXd* r_PN_N;   //!< [m] planet inertial position vector
+        Eigen::MatrixXd* v_PN_N;   //!< [m/s] planet inertial velocity vector
+        Eigen::MatrixXd* muPlanet; //!< [m3/s^2] planet gravitational parameter
+        Eigen::MatrixXd* J20002Pfix;     //!< [-] planet attitude [PN]
+        Eigen::MatrixXd* J20002Pfix_dot; //!< [1/s] planet attitude rate [PN_dot]
+    };
+    std::vector<PlanetStateProperties> planetStateProperties; //!< planet state properties, in the order of gravBodies
+
     /** Writes to centralBodyOutMsg if it is linked and there is a central body */
     void writeOutputMessages(uint64_t currentSimNanos);
 
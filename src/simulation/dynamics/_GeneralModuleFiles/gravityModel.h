@@ -73,9 +73,32 @@ class GravityModel {
      * The position is given in the body-fixed reference frame.
      * Likewise, the resulting acceleration should be given in the
      * body-fixed reference frame.
+     *
+     * Once the model is initialized, implementations must not modify the
+     * model, so that several threads can evaluate the same model concurrently
+     * (for example, when integrating several spacecraft in parallel).
      */
     virtual Eigen::Vector3d computeField(const Eigen::Vector3d& position_planetFixed) const = 0;
 
+    /** Computes the gravity acceleration at several positions around this body.
+     *
+     * Each column of `positions_planetFixed` is a position in the body-fixed
+     * reference frame. On return, each column of `accelerations_planetFixed`
+     * holds the acceleration at the matching position, also given in the
+     * body-fixed reference frame.
+     *
+     * The default implementation calls computeField once per position. Models
+     * that can share work between positions should override this method.
+     */
+    virtual void computeFieldBatch(const Eigen::Matrix3Xd& positions_planetFixed,
+                                   Eigen::Matrix3Xd& accelerations_planetFixed) const
+    {
+        accelerations_planetFixed.resize(3, positions_planetFixed.cols());
+        for (Eigen::Index i = 0; i < positions_planetFixed.cols(); i++) {
+            accelerations_planetFixed.col(i) = this->computeField(positions_planetFixed.col(i));
+        }
+    }
+
     /** Returns the gravitational potential energy at a position around this body.
      *
      * The position is given relative to the body and in the inertial
@@ -84,7 +107,7 @@ class GravityModel {
     virtual double computePotentialEnergy(const Eigen::Vector3d& positionWrtPlanet_N) const = 0;
 
   public:
-    BSKLogger *bskLogger;  /*!< pointer to bsk logging instance */
+    BSKLogger *bskLogger = nullptr;  /*!< pointer to bsk logging instance */
 };
 
 #endif /* GRAVITY_MODEL_H */
@@ -81,12 +81,15 @@ void HubEffector::prependSpacecraftNameToStates()
 void HubEffector::registerStates(DynParamManager& states)
 {
     // - Register the hub states and set with initial values
-    this->posState = states.registerState(3, 1, this->nameOfHubPosition);
-    this->velocityState = states.registerState(3, 1, this->nameOfHubVelocity);
-    this->sigmaState = states.registerState(3, 1, this->nameOfHubSigma);
-    this->omegaState = states.registerState(3, 1, this->nameOfHubOmega);
-    this->gravVelocityState = states.registerState(3, 1, this->nameOfHubGravVelocity);
-    this->gravVelocityBcState = states.registerState(3, 1, this->nameOfBcGravVelocity);
+    this->posState = states.registerState<Eigen::Vector3d>(this->nameOfHubPosition);
+    this->velocityState = states.registerState<Eigen::Vector3d>(this->nameOfHubVelocity);
+    this->sigmaState = states.registerState<Eigen::Vector3d>(this->nameOfHubSigma);
+    this->omegaState = states.registerState<Eigen::Vector3d>(this->nameOfHubOmega);
+    this->gravVelocityState = states.registerState<Eigen::Vector3d>(this->nameOfHubGravVelocity);
+    this->gravVelocityBcState = states.registerState<Eigen::Vector3d>(this->nameOfBcGravVelocity);
+    // The gravity velocities are reset before every integration to accumulate the gravity DV
+    this->gravVelocityState->drivesDynamics = false;
+    this->gravVelocityBcState->drivesDynamics = false;
     /* - r_BN_N and v_BN_N of the hub is first set to r_CN_N and v_CN_N and then is corrected in spacecraft
      initializeDynamics to incorporate the fact that point B and point C are not necessarily coincident */
     this->posState->setState(this->r_CN_NInit);
@@ -134,9 +137,9 @@ void HubEffector::computeDerivatives(double integTime, Eigen::Vector3d rDDot_BN_
     Eigen::Vector3d cLocal_B;
     Eigen::Vector3d cPrimeLocal_B;
     Eigen::Vector3d gLocal_N;
-    rDotLocal_BN_N = velocityState->getState();
-    sigmaLocal_BN = (Eigen::Vector3d )sigmaState->getState();
-    omegaLocal_BN_B = omegaState->getState();
+    rDotLocal_BN_N = velocityState->getStateAs<Eigen::Vector3d>();
+    sigmaLocal_BN = sigmaState->getStateAs<Eigen::Vector3d>();
+    omegaLocal_BN_B = omegaState->getStateAs<Eigen::Vector3d>();
     gLocal_N = *this->g_N;
 
     // - Set kinematic derivative
@@ -176,7 +179,7 @@ void HubEffector::updateEnergyMomContributions(double integTime, Eigen::Vector3d
 {
     // - Get variables needed for energy momentum calcs
     Eigen::Vector3d omegaLocal_BN_B;
-    omegaLocal_BN_B = omegaState->getState();
+    omegaLocal_BN_B = omegaState->getStateAs<Eigen::Vector3d>();
 
     //  - Find rotational angular momentum contribution from hub
     Eigen::Vector3d rDot_BcB_B;
@@ -194,7 +197,7 @@ void HubEffector::modifyStates(double integTime)
 {
     // Lets switch those MRPs!!
     Eigen::Vector3d sigmaBNLoc;
-    sigmaBNLoc = (Eigen::Vector3d) this->sigmaState->getState();
+    sigmaBNLoc = this->sigmaState->getStateAs<Eigen::Vector3d>();
     if (sigmaBNLoc.norm() > 1) {
         sigmaBNLoc = -sigmaBNLoc/(sigmaBNLoc.dot(sigmaBNLoc));
         this->sigmaState->setState(sigmaBNLoc);
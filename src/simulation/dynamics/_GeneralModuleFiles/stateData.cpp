@@ -31,6 +31,7 @@ StateData::StateData(const StateData &inState)
     stateDeriv = inState.stateDeriv;
     stateName = inState.stateName;
     stateEnabled = inState.stateEnabled;
+    drivesDynamics = inState.drivesDynamics;
 }
 
 StateData::~StateData()
@@ -30,6 +30,7 @@ public:
     Eigen::MatrixXd stateDeriv;                   //!< [-] State derivative value storage
     std::string stateName;                        //!< [-] Name of the state
     bool stateEnabled;                            //!< [-] Flag indicating state is enabled
+    bool drivesDynamics = true;                   //!< [-] Flag indicating that state derivatives may depend on this state, false for states that only accumulate the others
     BSKLogger bskLogger;                          //!< -- BSK Logging
 
 public:
@@ -40,8 +41,33 @@ public:
     void setState(const Eigen::MatrixXd & newState);    //!< class method
     void propagateState(double dt);                     //!< class method
     void setDerivative(const Eigen::MatrixXd & newDeriv);   //!< class method
-    Eigen::MatrixXd getState() const {return state;}    //!< class method
-    Eigen::MatrixXd getStateDeriv() const {return stateDeriv;}  //!< class method
+    const Eigen::MatrixXd& getState() const {return state;}    //!< class method
+    const Eigen::MatrixXd& getStateDeriv() const {return stateDeriv;}  //!< class method
+
+    /*! Sets the state from an Eigen expression, such as a fixed-size vector, without a temporary MatrixXd */
+    template <typename Derived>
+    void setState(const Eigen::MatrixBase<Derived>& newState) {state = newState;}
+
+    /*! Sets the state derivative from an Eigen expression, such as a fixed-size vector, without a temporary MatrixXd */
+    template <typename Derived>
+    void setDerivative(const Eigen::MatrixBase<Derived>& newDeriv) {stateDeriv = newDeriv;}
+
+    /*! Returns a view of the state as the fixed-size Eigen type T, such as Eigen::Vector3d, which must have the size
+     of the state */
+    template <typename T>
+    Eigen::Map<const T> getStateAs() const
+    {
+        eigen_assert(state.rows() == T::RowsAtCompileTime && state.cols() == T::ColsAtCompileTime);
+        return Eigen::Map<const T>(state.data());
+    }
+
+    /*! Returns a view of the state derivative as the fixed-size Eigen type T, which must have the size of the state */
+    template <typename T>
+    Eigen::Map<const T> getStateDerivAs() const
+    {
+        eigen_assert(stateDeriv.rows() == T::RowsAtCompileTime && stateDeriv.cols() == T::ColsAtCompileTime);
+        return Eigen::Map<const T>(stateDeriv.data());
+    }
     std::string getName() const {return stateName;}     //!< class method
     uint32_t getRowSize() const {return((uint32_t)state.innerSize());}  //!< class method
     uint32_t getColumnSize() const {return((uint32_t)state.outerSize());}   //!< class method
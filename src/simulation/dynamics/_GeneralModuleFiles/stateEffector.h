@@ -36,6 +36,26 @@ struct BackSubMatrices {
     Eigen::Vector3d vecRot;              //!< -- Back-Substitution rotation vector
 };
 
+/*! hub attitude kinematics structure, computed by the spacecraft once per evaluation of the equations of motion and
+ shared by its own methods.  The effectors still receive the hub attitude and angular velocity as vectors. */
+struct HubKinematics {
+    Eigen::Vector3d sigma_BN;            //!< -- Attitude of the hub as an MRP
+    Eigen::Vector3d omega_BN_B;          //!< [rad/s] Angular velocity of the hub in B frame components
+    Eigen::Matrix3d dcm_NB;              //!< -- DCM from the B frame to the N frame
+    Eigen::Matrix3d dcm_BN;              //!< -- DCM from the N frame to the B frame
+
+    /*! Updates the kinematics from the hub attitude and angular velocity states */
+    void update(const Eigen::Vector3d& sigma, const Eigen::Vector3d& omega)
+    {
+        Eigen::MRPd sigmaLocal_BN;
+        sigmaLocal_BN = sigma;
+        this->sigma_BN = sigma;
+        this->omega_BN_B = omega;
+        this->dcm_NB = sigmaLocal_BN.toRotationMatrix();
+        this->dcm_BN = this->dcm_NB.transpose();
+    }
+};
+
 /*! @brief Abstract class that is used to implement an effector attached to the dynamicObject that has a state that
  needs to be integrated. For example: reaction wheels, flexing solar panels, fuel slosh etc */
 typedef struct {
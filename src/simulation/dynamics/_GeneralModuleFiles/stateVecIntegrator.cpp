@@ -19,6 +19,7 @@
 
 #include "stateVecIntegrator.h"
 #include "dynamicObject.h"
+#include "architecture/utilities/threadPool.h"
 
 /*! @brief Constructor */
 StateVecIntegrator::StateVecIntegrator(DynamicObject* dyn)
@@ -31,3 +32,86 @@ StateVecIntegrator::~StateVecIntegrator(void)
 {
     this->dynPtrs.clear();
 }
+
+/*! @brief Sets the number of threads that evaluate the equations of motion of the dynamic objects.
+
+    With more than one thread, the equationsOfMotion methods of the dynamic objects whose
+    integration is synced to this integrator are called in parallel in every stage of the
+    integration.  Each object only writes its own state derivatives, which are gathered in
+    the order of dynPtrs afterwards, so the results do not depend on the number of threads.
+    The dynamic objects must then not modify each other, or any object they share, in their
+    equations of motion.
+    @param threadCount Number of threads, including the thread running the simulation
+ */
+void StateVecIntegrator::setThreadCount(size_t threadCount)
+{
+    if (threadCount <= 1) {
+        this->threadPool.reset();
+    }
+    else if (!this->threadPool || this->threadPool->getThreadCount() != threadCount) {
+        this->threadPool.reset();
+        this->threadPool = std::make_unique<ThreadPool>(threadCount);
+    }
+}
+
+/*! @brief Returns the number of threads that evaluate the equations of motion
+    @return size_t Number of threads, including the thread running the simulation
+ */
+size_t StateVecIntegrator::getThreadCount() const
+{
+    return this->threadPool ? this->threadPool->getThreadCount() : 1;
+}
+
+/*! @brief Enables keeping what is needed to interpolate the states within the last integration step.
+
+    Integrators that support dense output then answer getInterpolatedState for any time between
+    the start and the end of the last call to integrate.  The Runge-Kutta integrators then evaluate
+    the equations of motion once more per call to integrate, at the end of the last step, unless
+    their last stage is already evaluated there.
+    @param enable True to enable dense output
+ */
+void StateVecIntegrator::setDenseOutput(bool enable)
+{
+    this->denseOutput = enable;
+}
+
+/*! @brief Returns true if dense output is enabled
+    @return bool Dense output flag
+ */
+bool StateVecIntegrator::getDenseOutput() const
+{
+    return this->denseOutput;
+}
+
+/*! @brief Interpolates a state of a dynamic object at a time within the last integration step.
+
+    The base class does not support dense output and always returns false.
+    @param dynObject Dynamic object integrated by this integrator
+    @param stateName Name of the state
+    @param time [s] Time at which the state is interpolated
+    @param state Set to the interpolated state when true is returned
+    @return bool True if the state could be interpolated
+ */
+bool StateVecIntegrator::getInterpolatedState(const DynamicObject& /*dynObject*/, const std::string& /*stateName*/,
+                                              double /*time*/, Eigen::MatrixXd& /*state*/) const
+{
+    return false;
+}
+
+/*! @brief Calls equationsOfMotion of every dynamic object, in parallel if more than one thread is set
+    @param t Time at which the equations of motion are evaluated
+    @param timeStep Integration time step
+ */
+void StateVecIntegrator::computeEquationsOfMotion(double t, double timeStep)
+{
+    if (!this->threadPool || this->dynPtrs.size() < 2) {
+        for (auto dynPtr : this->dynPtrs) {
+            dynPtr->equationsOfMotion(t, timeStep);
+        }
+        return;
+    }
+
+    this->threadPool->parallelFor(this->dynPtrs.size(), [&](size_t index) {
+        this->dynPtrs[index]->equationsOfMotion(t, timeStep);
+    });
+}
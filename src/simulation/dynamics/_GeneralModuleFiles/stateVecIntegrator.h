@@ -21,9 +21,13 @@
 #ifndef stateVecIntegrator_h
 #define stateVecIntegrator_h
 
+#include <Eigen/Dense>
+#include <memory>
+#include <string>
 #include <vector>
 
 class DynamicObject;
+class ThreadPool;
 
 /*! @brief state vector integrator class */
 class StateVecIntegrator
@@ -33,8 +37,22 @@ public:
     StateVecIntegrator(DynamicObject* dynIn);
     virtual ~StateVecIntegrator(void);
     virtual void integrate(double currentTime, double timeStep) = 0; //!< class method
+    void setThreadCount(size_t threadCount); //!< Sets the number of threads that evaluate the equations of motion of the dynamic objects
+    size_t getThreadCount() const; //!< Returns the number of threads that evaluate the equations of motion
+    void setDenseOutput(bool enable); //!< Enables keeping what is needed to interpolate the states within the last step
+    bool getDenseOutput() const; //!< Returns true if dense output is enabled
+    virtual bool getInterpolatedState(const DynamicObject& dynObject, const std::string& stateName,
+                                      double time, Eigen::MatrixXd& state) const; //!< Interpolates a state within the last step
     std::vector<DynamicObject*> dynPtrs; //!< This is an object that contains the method equationsOfMotion(), also known as the F function.
 
+protected:
+    void computeEquationsOfMotion(double t, double timeStep); //!< Calls equationsOfMotion of every dynamic object
+
+    bool denseOutput = false; //!< Flag indicating that the integrator keeps the data needed to interpolate the last step
+
+private:
+    std::unique_ptr<ThreadPool> threadPool; //!< Threads evaluating the equations of motion, null if serial
+
 };
 
 
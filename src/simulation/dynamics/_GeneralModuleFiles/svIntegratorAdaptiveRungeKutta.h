@@ -24,6 +24,7 @@
 #include "../_GeneralModuleFiles/dynParamManager.h"
 #include "../_GeneralModuleFiles/svIntegratorRungeKutta.h"
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <stdint.h>
@@ -173,6 +174,19 @@ class svIntegratorAdaptiveRungeKutta : public svIntegratorRungeKutta<numberStage
     std::optional<double> getAbsoluteTolerance(const DynamicObject& dynamicObject,
                                                std::string stateName);
 
+    /**
+     * Registers a message payload that the equations of motion depend on.
+     *
+     * When coasting (see maximumCoastTimeStep), a step that spans several task periods is
+     * only continued while the content of every registered payload is unchanged. The
+     * address and size are the ones returned by getPayloadAddress() and getPayloadSize()
+     * of a message.
+     */
+    void addCoastInput(uint64_t payloadAddress, size_t payloadSize);
+
+    /** Removes every payload registered with addCoastInput */
+    void clearCoastInputs();
+
     /** Maximum relative truncation error allowed.
      *
      * The relative truncation error is the absolute error of the state divided by the magnitude of
@@ -202,6 +216,20 @@ class svIntegratorAdaptiveRungeKutta : public svIntegratorRungeKutta<numberStage
      */
     double minimumFactorDecreaseForNextStepSize = 0.1;
 
+    /** [s] Largest step allowed when coasting over several task periods.
+     *
+     * When positive, steps are no longer cut at the end of the task period. The states at the
+     * end of the period are interpolated within the step that crosses it, and the next calls
+     * continue that step instead of integrating again, as long as the states and the payloads
+     * registered with addCoastInput were not modified in between. When they were, the
+     * integration restarts from the current states with a step of one task period. States
+     * whose StateData::drivesDynamics flag is false may be modified, they are offset within
+     * the step instead. The equations of motion are evaluated once at the interpolated
+     * states, so that their outputs match the states at the end of the call. Zero, the
+     * default, disables coasting.
+     */
+    double maximumCoastTimeStep = 0.0;
+
   protected:
     /**
      * Computes the absolute error of every state
@@ -216,19 +244,42 @@ class svIntegratorAdaptiveRungeKutta : public svIntegratorRungeKutta<numberStage
     double computeMaxRelativeError(
         double timeStep,
         const ExtendedStateVector& candidateNextState,
-        const typename svIntegratorRungeKutta<numberStages>::KCoefficientsValues& kVectors) const;
+        const typename svIntegratorRungeKutta<numberStages>::KCoefficientsValues& kVectors);
+
+    /** Sizes the stage workspaces and the truncation error workspace to the current state layout */
+    virtual void prepareWorkspaces() override;
+
+    /**
+     * Returns true if the last recorded step can be continued from startingTime, that is if
+     * startingTime is within the step and neither the states nor the coast inputs changed
+     * since the end of the last call to integrate.
+     */
+    bool canContinueCoasting(double startingTime);
+
+    /** Stores the current content of every coast input, and returns true if any changed */
+    bool updateCoastInputs();
+
+    /**
+     * Sets the interpolated states of currentState and evaluates the equations of motion there.
+     *
+     * When coasting, the last evaluation of the equations of motion may belong to an earlier
+     * call, or to the end of a step past the end of this call. This evaluation keeps the
+     * outputs computed by the equations of motion, such as the forces of the effectors,
+     * consistent with the states at the end of the call.
+     */
+    void refreshEquationsOfMotion(double time, double timeStep);
 
     /** Finds index of dynamicObject in dynPtrs (vector of pointers to DynamicObject) */
     size_t findDynamicObjectIndex(const DynamicObject& dynamicObject) const;
 
-    /** Combines the relative and absolute tolerances into a single tolerance
+    /** Resolves the relative and absolute tolerances of every state of the state layout
      *
      * This checks for the general, state-specific, and
      * dynamicObject-state-specific tolerances; only the most specific
-     * tolerance is used.
+     * tolerance is used. The result is kept in stateTolerances until the
+     * layout or a state-specific tolerance changes.
      */
-    double
-    getTolerance(size_t dynamicObjectIndex, const std::string& stateName, double stateNorm) const;
+    void updateStateTolerances();
 
     /** The higher order of the two orders used in adaptive RK methods.
      *
@@ -249,6 +300,42 @@ class svIntegratorAdaptiveRungeKutta : public svIntegratorRungeKutta<numberStage
     /** Holds the maximum absolute truncation error allowed for specific states of specific dynamic
      * objects*/
     std::unordered_map<ExtendedStateId, double, ExtendedStateIdHash> dynObjectStateSpecificAbsTol;
+
+    /** Workspace holding the absolute truncation error of the last trial step */
+    ExtendedStateVector truncationError;
+
+    /** Tolerances that apply to a state of the state layout */
+    struct StateTolerance {
+        const double* relTol; /**< Either relTol or an entry of one of the tolerance maps */
+        const double* absTol; /**< Either absTol or an entry of one of the tolerance maps */
+    };
+
+    /** Tolerances of every entry of the state layout, see updateStateTolerances */
+    std::vector<StateTolerance> stateTolerances;
+
+    /** Layout stateTolerances was resolved for */
+    std::shared_ptr<const ExtendedStateLayout> stateTolerancesLayout;
+
+    /** False when a state-specific tolerance was set after stateTolerances was resolved */
+    bool stateTolerancesValid = false;
+
+    /** Message payload registered with addCoastInput */
+    struct CoastInput {
+        const uint8_t* payload;         /**< Address of the payload */
+        std::vector<uint8_t> lastValue; /**< Content of the payload when it was last checked */
+    };
+
+    /** Payloads that must not change for a step to be continued when coasting */
+    std::vector<CoastInput> coastInputs;
+
+    /** States written to the dynamic objects at the end of the last call, when coasting */
+    ExtendedStateVector coastStates;
+
+    /** [s] Size proposed for the next step when coasting */
+    double coastTimeStep = 0.0;
+
+    /** True if the last recorded step may be continued by the next call when coasting */
+    bool coastStepValid = false;
 };
 
 template <size_t numberStages>
@@ -268,21 +355,52 @@ template <size_t numberStages>
 void svIntegratorAdaptiveRungeKutta<numberStages>::integrate(double startingTime,
                                                              double desiredTimeStep)
 {
+    // Simulation times are integer nanoseconds, which bounds the round-off between
+    // the end of a step and the end of a task period
+    const double timeTolerance = 1e-9;
+    const double endTime = startingTime + desiredTimeStep;
+    const bool coasting = this->maximumCoastTimeStep > 0;
+
     double time = startingTime;
     double timeStep = desiredTimeStep;
-    ExtendedStateVector state = ExtendedStateVector::fromStates(this->dynPtrs);
-    typename svIntegratorRungeKutta<numberStages>::KCoefficientsValues kValues;
+    this->prepareWorkspaces();
+    this->currentState.readStates();
+
+    if (coasting && this->canContinueCoasting(startingTime)) {
+        auto& lastSegment = this->denseOutputSegments.at(this->denseOutputSegmentCount - 1);
+        double lastSegmentEnd = lastSegment.startTime + lastSegment.timeStep;
+
+        // The whole call is within the last step: no integration is needed
+        if (lastSegmentEnd >= endTime - timeTolerance) {
+            this->interpolateSegment(lastSegment, endTime, this->currentState);
+            this->refreshEquationsOfMotion(endTime, desiredTimeStep);
+            this->coastStates = this->currentState;
+            return;
+        }
+
+        // Otherwise the integration continues from the end of the last step, which
+        // is kept as the first segment so that the whole call can be interpolated
+        std::swap(this->denseOutputSegments.front(), lastSegment);
+        this->denseOutputSegmentCount = 1;
+        time = lastSegmentEnd;
+        timeStep = this->coastTimeStep;
+        this->currentState = this->denseOutputSegments.front().endState;
+    }
+    else {
+        this->denseOutputSegmentCount = 0;
+    }
+    this->coastStepValid = false;
 
     // Continue until we are done with the desired time step
-    while (time < startingTime + desiredTimeStep) {
+    while (time < endTime) {
         // Much like regular Runge Kutta, we compute the
         // "k" coefficients and the next state from them.
-        kValues = this->computeKCoefficients(time, timeStep, state);
-        ExtendedStateVector candidateNextState = this->computeNextState(timeStep, state, kValues);
+        this->computeKCoefficients(time, timeStep, this->currentState, this->kValues);
+        this->computeNextState(timeStep, this->currentState, this->kValues, this->nextState);
 
         // For the adaptive RK, we also compute the maximum
         // relationship between error and tolerance
-        double maxRelError = this->computeMaxRelativeError(timeStep, candidateNextState, kValues);
+        double maxRelError = this->computeMaxRelativeError(timeStep, this->nextState, this->kValues);
 
         // If maxRelError > 1, then we need a smaller time step,
         // so we should reject the current time step.
@@ -290,9 +408,14 @@ void svIntegratorAdaptiveRungeKutta<numberStages>::integrate(double startingTime
         // integration, and this step was valid.
         if (maxRelError <= 1.) // Accept integration step
         {
+            if (this->denseOutput || coasting) {
+                this->recordDenseOutputStep(time, timeStep, this->currentState, this->kValues.at(0), this->nextState);
+            }
+
             // Advance time and set new state to the computed state
             time += timeStep;
-            state = std::move(candidateNextState);
+            // Swapping keeps both workspaces allocated
+            std::swap(this->currentState, this->nextState);
         }
 
         // Regardless of accepting or not the step, we compute a new time step
@@ -300,34 +423,135 @@ void svIntegratorAdaptiveRungeKutta<numberStages>::integrate(double startingTime
                              std::pow(1.0 / maxRelError, 1.0 / this->methodLargestOrder);
         newTimeStep = std::min(newTimeStep, timeStep * this->maximumFactorIncreaseForNextStepSize);
         newTimeStep = std::max(newTimeStep, timeStep * this->minimumFactorDecreaseForNextStepSize);
-        newTimeStep =
-            std::min(newTimeStep, startingTime + desiredTimeStep - time); // Avoid over-stepping
+        if (coasting) {
+            // Steps may go past the end of the call, they are interpolated
+            newTimeStep = std::min(newTimeStep, this->maximumCoastTimeStep);
+            this->coastTimeStep = newTimeStep;
+        }
+        else {
+            newTimeStep = std::min(newTimeStep, endTime - time); // Avoid over-stepping
+        }
         timeStep = newTimeStep;
     }
 
-    // Update the dynamic objects with the final state obtained
-    state.setStates(this->dynPtrs);
+    if (!coasting) {
+        // Update the dynamic objects with the final state obtained
+        this->currentState.setStates();
+
+        if (this->denseOutput) {
+            this->finishDenseOutput();
+        }
+        return;
+    }
+
+    // The derivatives at the end of the last step are needed to interpolate within it
+    this->finishDenseOutput();
+    if (time > endTime + timeTolerance) {
+        this->interpolateSegment(
+            this->denseOutputSegments.at(this->denseOutputSegmentCount - 1), endTime, this->currentState);
+        this->refreshEquationsOfMotion(endTime, desiredTimeStep);
+    }
+    else {
+        this->currentState.setStates();
+    }
+    this->coastStates = this->currentState;
+    this->updateCoastInputs();
+    this->coastStepValid = true;
+}
+
+template <size_t numberStages>
+bool svIntegratorAdaptiveRungeKutta<numberStages>::canContinueCoasting(double startingTime)
+{
+    const double timeTolerance = 1e-9;
+    bool inputsChanged = this->updateCoastInputs();
+    if (!this->coastStepValid || inputsChanged || this->denseOutputSegmentCount == 0) return false;
+
+    const auto& lastSegment = this->denseOutputSegments.at(this->denseOutputSegmentCount - 1);
+    if (startingTime < lastSegment.startTime - timeTolerance ||
+        startingTime > lastSegment.startTime + lastSegment.timeStep + timeTolerance) {
+        return false;
+    }
+
+    if (this->coastStates.getLayout() != this->currentState.getLayout()) return false;
+
+    // States modified after the last call, by an MRP switch for example, invalidate the step,
+    // unless the derivatives do not depend on them. Those are offset within the step instead.
+    for (const auto& entry : this->currentState.getLayout()->entries) {
+        if (entry.stateData->drivesDynamics &&
+            this->currentState.at(entry) != this->coastStates.at(entry)) {
+            return false;
+        }
+    }
+    auto& segment = this->denseOutputSegments.at(this->denseOutputSegmentCount - 1);
+    // The offset is added coefficient-wise, without a temporary vector
+    segment.startState.getValues() += this->currentState.getValues() - this->coastStates.getValues();
+    segment.endState.getValues() += this->currentState.getValues() - this->coastStates.getValues();
+    return true;
+}
+
+template <size_t numberStages>
+void svIntegratorAdaptiveRungeKutta<numberStages>::refreshEquationsOfMotion(double time,
+                                                                            double timeStep)
+{
+    // The derivatives are not needed, stageState is only used as scratch storage
+    this->computeDerivatives(time, timeStep, this->currentState, this->stageState);
+}
+
+template <size_t numberStages>
+bool svIntegratorAdaptiveRungeKutta<numberStages>::updateCoastInputs()
+{
+    bool changed = false;
+    for (auto& input : this->coastInputs) {
+        if (std::memcmp(input.lastValue.data(), input.payload, input.lastValue.size()) != 0) {
+            std::memcpy(input.lastValue.data(), input.payload, input.lastValue.size());
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+template <size_t numberStages>
+void svIntegratorAdaptiveRungeKutta<numberStages>::addCoastInput(uint64_t payloadAddress,
+                                                                 size_t payloadSize)
+{
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(static_cast<uintptr_t>(payloadAddress));
+    this->coastInputs.push_back({payload, std::vector<uint8_t>(payload, payload + payloadSize)});
+}
+
+template <size_t numberStages> void svIntegratorAdaptiveRungeKutta<numberStages>::clearCoastInputs()
+{
+    this->coastInputs.clear();
+}
+
+template <size_t numberStages> void svIntegratorAdaptiveRungeKutta<numberStages>::prepareWorkspaces()
+{
+    svIntegratorRungeKutta<numberStages>::prepareWorkspaces();
+    this->workspaceResizes += this->truncationError.resize(this->stateLayout);
+    if (!this->stateTolerancesValid || this->stateTolerancesLayout != this->stateLayout) {
+        this->updateStateTolerances();
+    }
 }
 
 template <size_t numberStages>
 double svIntegratorAdaptiveRungeKutta<numberStages>::computeMaxRelativeError(
     double timeStep,
     const ExtendedStateVector& candidateNextState,
-    const typename svIntegratorRungeKutta<numberStages>::KCoefficientsValues& kVectors) const
+    const typename svIntegratorRungeKutta<numberStages>::KCoefficientsValues& kVectors)
 {
     auto castCoefficients =
         static_cast<RKAdaptiveCoefficients<numberStages>*>(this->coefficients.get());
 
     // Compute the absolute truncation error for every state
-    ExtendedStateVector truncationError =
-        kVectors.at(0) *
-        ((castCoefficients->bArray.at(0) - castCoefficients->bStarArray.at(0)) * timeStep);
+    ExtendedStateVector& truncationError = this->truncationError;
+    truncationError.setScaled(
+        kVectors.at(0),
+        (castCoefficients->bArray.at(0) - castCoefficients->bStarArray.at(0)) * timeStep);
 
     for (size_t stageIndex = 1; stageIndex < numberStages; stageIndex++) {
         double bDiff =
             castCoefficients->bArray.at(stageIndex) - castCoefficients->bStarArray.at(stageIndex);
         if (bDiff == 0) continue;
-        truncationError += kVectors.at(stageIndex) * (bDiff * timeStep);
+        truncationError.addScaled(kVectors.at(stageIndex), bDiff * timeStep);
     }
 
     // Compute the maximum relative error being committed
@@ -335,17 +559,18 @@ double svIntegratorAdaptiveRungeKutta<numberStages>::computeMaxRelativeError(
     // and an acceptable error tolerance (a combination of relTol and absTol)
     // We care only about the largest relationship between
     // truncation error and tolerance.
+    // Both vectors share the same layout, so every state is found at the same offset.
+    // The tolerances were resolved in the same order by prepareWorkspaces.
     double maxRelativeError = 0;
-    auto maxRelativeErrorRef = std::ref(maxRelativeError);
-    candidateNextState.apply([this, &maxRelativeErrorRef, &truncationError](
-                                 const size_t& dynObjIndex,
-                                 const std::string& stateName,
-                                 const Eigen::MatrixXd& thisState) {
-        double thisTruncationError = truncationError.at({dynObjIndex, stateName}).norm();
-        double thisErrorTolerance = this->getTolerance(dynObjIndex, stateName, thisState.norm());
-        maxRelativeErrorRef.get() =
-            std::max(maxRelativeErrorRef.get(), thisTruncationError / thisErrorTolerance);
-    });
+    const auto& entries = candidateNextState.getLayout()->entries;
+    for (size_t entryIndex = 0; entryIndex < entries.size(); entryIndex++) {
+        const auto& entry = entries[entryIndex];
+        const StateTolerance& tolerance = this->stateTolerances[entryIndex];
+        double thisTruncationError = truncationError.at(entry).norm();
+        double thisErrorTolerance =
+            candidateNextState.at(entry).norm() * *tolerance.relTol + *tolerance.absTol;
+        maxRelativeError = std::max(maxRelativeError, thisTruncationError / thisErrorTolerance);
+    }
 
     return maxRelativeError;
 }
@@ -378,7 +603,8 @@ template <size_t numberStages>
 void svIntegratorAdaptiveRungeKutta<numberStages>::setRelativeTolerance(std::string stateName,
                                                                         double relTol)
 {
-    this->stateSpecificRelTol.at(stateName) = relTol;
+    this->stateSpecificRelTol[stateName] = relTol;
+    this->stateTolerancesValid = false;
 }
 
 template <size_t numberStages>
@@ -395,7 +621,8 @@ template <size_t numberStages>
 void svIntegratorAdaptiveRungeKutta<numberStages>::setAbsoluteTolerance(std::string stateName,
                                                                         double absTol)
 {
-    this->stateSpecificAbsTol.at(stateName) = absTol;
+    this->stateSpecificAbsTol[stateName] = absTol;
+    this->stateTolerancesValid = false;
 }
 
 template <size_t numberStages>
@@ -414,8 +641,9 @@ void svIntegratorAdaptiveRungeKutta<numberStages>::setRelativeTolerance(
     std::string stateName,
     double relTol)
 {
-    this->dynObjectStateSpecificRelTol.at(
-        {this->findDynamicObjectIndex(dynamicObject), stateName}) = relTol;
+    this->dynObjectStateSpecificRelTol[{this->findDynamicObjectIndex(dynamicObject), stateName}] =
+        relTol;
+    this->stateTolerancesValid = false;
 }
 
 template <size_t numberStages>
@@ -436,8 +664,9 @@ void svIntegratorAdaptiveRungeKutta<numberStages>::setAbsoluteTolerance(
     std::string stateName,
     double absTol)
 {
-    this->dynObjectStateSpecificAbsTol.at(
-        {this->findDynamicObjectIndex(dynamicObject), stateName}) = absTol;
+    this->dynObjectStateSpecificAbsTol[{this->findDynamicObjectIndex(dynamicObject), stateName}] =
+        absTol;
+    this->stateTolerancesValid = false;
 }
 
 template <size_t numberStages>
@@ -465,30 +694,40 @@ size_t svIntegratorAdaptiveRungeKutta<numberStages>::findDynamicObjectIndex(
 }
 
 template <size_t numberStages>
-double svIntegratorAdaptiveRungeKutta<numberStages>::getTolerance(size_t dynamicObjectIndex,
-                                                                  const std::string& stateName,
-                                                                  double stateNorm) const
+void svIntegratorAdaptiveRungeKutta<numberStages>::updateStateTolerances()
 {
-    const ExtendedStateId id{dynamicObjectIndex, stateName};
-
-    double relTol{this->relTol};
-    double absTol{this->absTol};
-
-    if (this->dynObjectStateSpecificRelTol.count(id) > 0) {
-        relTol = this->dynObjectStateSpecificRelTol.at(id);
-    }
-    else if (this->stateSpecificRelTol.count(stateName) > 0) {
-        relTol = this->stateSpecificRelTol.at(stateName);
-    }
+    // The general tolerances are referenced rather than copied, as they are public
+    // attributes that may be changed at any time. Entries of the maps are not moved
+    // when other entries are inserted.
+    const auto& entries = this->stateLayout->entries;
+    this->stateTolerances.resize(entries.size());
+    for (size_t entryIndex = 0; entryIndex < entries.size(); entryIndex++) {
+        const ExtendedStateId& id = entries[entryIndex].id;
+        const std::string& stateName = id.second;
+        StateTolerance& tolerance = this->stateTolerances[entryIndex];
+
+        tolerance.relTol = &this->relTol;
+        if (auto it = this->dynObjectStateSpecificRelTol.find(id);
+            it != this->dynObjectStateSpecificRelTol.end()) {
+            tolerance.relTol = &it->second;
+        }
+        else if (auto it = this->stateSpecificRelTol.find(stateName);
+                 it != this->stateSpecificRelTol.end()) {
+            tolerance.relTol = &it->second;
+        }
 
-    if (this->dynObjectStateSpecificAbsTol.count(id) > 0) {
-        absTol = this->dynObjectStateSpecificAbsTol.at(id);
-    }
-    else if (this->stateSpecificAbsTol.count(stateName) > 0) {
-        absTol = this->stateSpecificAbsTol.at(stateName);
+        tolerance.absTol = &this->absTol;
+        if (auto it = this->dynObjectStateSpecificAbsTol.find(id);
+            it != this->dynObjectStateSpecificAbsTol.end()) {
+            tolerance.absTol = &it->second;
+        }
+        else if (auto it = this->stateSpecificAbsTol.find(stateName);
+                 it != this->stateSpecificAbsTol.end()) {
+            tolerance.absTol = &it->second;
+        }
     }
-
-    return stateNorm * relTol + absTol;
+    this->stateTolerancesLayout = this->stateLayout;
+    this->stateTolerancesValid = true;
 }
 
 #endif /* svIntegratorAdaptiveRungeKutta_h */
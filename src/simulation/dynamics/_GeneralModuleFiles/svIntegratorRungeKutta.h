@@ -24,6 +24,7 @@
 #include "../_GeneralModuleFiles/dynParamManager.h"
 #include "../_GeneralModuleFiles/stateVecIntegrator.h"
 #include "extendedStateVector.h"
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <memory>
@@ -78,6 +79,29 @@ template <size_t numberStages> class svIntegratorRungeKutta : public StateVecInt
      */
     virtual void integrate(double currentTime, double timeStep) override;
 
+    /**
+     * Returns the number of times a workspace was resized to a new state layout.
+     *
+     * Workspaces are sized on the first call to integrate and reused afterwards,
+     * so this count should not grow during a run unless states are added or resized.
+     * It only counts workspace resizes, not every heap allocation made while integrating.
+     */
+    uint64_t getWorkspaceResizeCount() const { return this->workspaceResizes; }
+
+    /**
+     * Interpolates a state of a dynamic object at a time within the last call to integrate.
+     *
+     * Dense output must be enabled with setDenseOutput. Each step is interpolated with a cubic
+     * Hermite polynomial built from the states and derivatives at both ends of the step, so the
+     * interpolation is third order accurate whatever the order of the method. Returns false if
+     * dense output is disabled, if the state is not integrated by this integrator, or if the time
+     * is not within the last call to integrate.
+     */
+    virtual bool getInterpolatedState(const DynamicObject& dynObject,
+                                      const std::string& stateName,
+                                      double time,
+                                      Eigen::MatrixXd& state) const override;
+
   protected:
     /**
      * Can be used by subclasses to support passing coefficients
@@ -94,34 +118,119 @@ template <size_t numberStages> class svIntegratorRungeKutta : public StateVecInt
     using KCoefficientsValues = std::array<ExtendedStateVector, numberStages>;
 
     /**
-     * Computes the derivatives of every state given a time and current states.
+     * Computes the derivatives of every state given a time and current states,
+     * and stores them in stateDerivs.
      *
      * Internally, this sets the states on the dynamic objects and
      * calls the equationsOfMotion methods.
      */
-    ExtendedStateVector
-    computeDerivatives(double time, double timeStep, const ExtendedStateVector& states);
+    void computeDerivatives(double time,
+                            double timeStep,
+                            const ExtendedStateVector& states,
+                            ExtendedStateVector& stateDerivs);
 
     /**
      * Computes the "k" coefficients of the Runge-Kutta method
-     * for a time and state.
+     * for a time and state, and stores them in kVectors.
      */
-    KCoefficientsValues computeKCoefficients(double currentTime,
-                                             double timeStep,
-                                             const ExtendedStateVector& currentStates);
+    void computeKCoefficients(double currentTime,
+                              double timeStep,
+                              const ExtendedStateVector& currentStates,
+                              KCoefficientsValues& kVectors);
 
     /**
      * Adds the "k" coefficients, weighted by the "c" coefficients
-     * to find the state after the time step.
+     * to find the state after the time step, and stores it in nextStates.
+     */
+    void computeNextState(double timeStep,
+                          const ExtendedStateVector& currentStates,
+                          const KCoefficientsValues& kVectors,
+                          ExtendedStateVector& nextStates);
+
+    /**
+     * Sizes the stage workspaces to the current state layout.
+     *
+     * Storage is only allocated when the layout changes, which normally
+     * happens once, on the first call to integrate.
+     */
+    virtual void prepareWorkspaces();
+
+    /**
+     * Returns the layout of the states of the integrated dynamic objects.
+     *
+     * The layout is cached and only rebuilt when the set of dynamic objects
+     * or the size of their states changes.
+     */
+    const std::shared_ptr<const ExtendedStateLayout>& getStateLayout();
+
+    /** States and state derivatives at both ends of an accepted integration step */
+    struct DenseOutputSegment {
+        double startTime = 0;             /**< [s] Time at the start of the step */
+        double timeStep = 0;              /**< [s] Length of the step */
+        ExtendedStateVector startState;   /**< States at the start of the step */
+        ExtendedStateVector startDeriv;   /**< State derivatives at the start of the step */
+        ExtendedStateVector endState;     /**< States at the end of the step */
+        ExtendedStateVector endDeriv;     /**< State derivatives at the end of the step */
+    };
+
+    /**
+     * Records an accepted step for dense output.
+     *
+     * The derivatives at the start of a step are the first "k" coefficient of the method, which
+     * are also the derivatives at the end of the previously recorded step.
      */
-    ExtendedStateVector computeNextState(double timeStep,
-                                         const ExtendedStateVector& currentStates,
-                                         const KCoefficientsValues& kVectors);
+    void recordDenseOutputStep(double startTime,
+                               double timeStep,
+                               const ExtendedStateVector& startState,
+                               const ExtendedStateVector& startDeriv,
+                               const ExtendedStateVector& endState);
+
+    /**
+     * Sets the state derivatives at the end of the last recorded step, the only ones
+     * that are not given by the "k" coefficients of a later step.
+     *
+     * When the last stage of the method is evaluated at the end of the step (the last row
+     * of the "a" matrix equals the "b" coefficients and the last "c" coefficient is one),
+     * its "k" coefficient is used. Otherwise, this costs one evaluation of the equations of
+     * motion per call to integrate.
+     */
+    void finishDenseOutput();
+
+    /** Returns true if the last stage of the method is evaluated at the states at the end of the step */
+    bool isLastStageAtEndOfStep() const;
+
+    /**
+     * Returns the weights of the start state, start derivative, end state and end derivative
+     * in the cubic Hermite interpolant of a step at the given time.
+     */
+    static std::array<double, 4> getHermiteWeights(const DenseOutputSegment& segment, double time);
+
+    /** Interpolates all states of a recorded step at the given time and stores them in states */
+    static void interpolateSegment(const DenseOutputSegment& segment,
+                                   double time,
+                                   ExtendedStateVector& states);
 
   protected:
     // coefficients is stored as a pointer to support polymorphism
     /** Coefficients to be used in the method */
     const std::unique_ptr<RKCoefficients<numberStages>> coefficients;
+
+    /** Cached location of every state in the flat ExtendedStateVector storage */
+    std::shared_ptr<const ExtendedStateLayout> stateLayout;
+
+    KCoefficientsValues kValues;     /**< Workspace holding the "k" coefficients of every stage */
+    ExtendedStateVector currentState; /**< Workspace holding the states at the start of a step */
+    ExtendedStateVector stageState;   /**< Workspace holding the states used to evaluate a stage */
+    ExtendedStateVector nextState;    /**< Workspace holding the states at the end of a step */
+
+    /** Number of workspace resizes, see getWorkspaceResizeCount */
+    uint64_t workspaceResizes = 0;
+
+    /** Steps of the last call to integrate, kept when dense output is enabled */
+    std::vector<DenseOutputSegment> denseOutputSegments;
+
+    /** Number of valid entries in denseOutputSegments, which is only grown to reuse the storage */
+    size_t denseOutputSegmentCount = 0;
 };
 
 template <size_t numberStages>
@@ -144,73 +253,213 @@ svIntegratorRungeKutta<numberStages>::svIntegratorRungeKutta(
 template <size_t numberStages>
 void svIntegratorRungeKutta<numberStages>::integrate(double currentTime, double timeStep)
 {
-    ExtendedStateVector currentState = ExtendedStateVector::fromStates(this->dynPtrs);
-    KCoefficientsValues kValues = this->computeKCoefficients(currentTime, timeStep, currentState);
-    ExtendedStateVector nextState = this->computeNextState(timeStep, currentState, kValues);
-    nextState.setStates(this->dynPtrs);
+    this->prepareWorkspaces();
+    this->currentState.readStates();
+    this->computeKCoefficients(currentTime, timeStep, this->currentState, this->kValues);
+    this->computeNextState(timeStep, this->currentState, this->kValues, this->nextState);
+    this->nextState.setStates();
+
+    this->denseOutputSegmentCount = 0;
+    if (this->denseOutput) {
+        this->recordDenseOutputStep(currentTime, timeStep, this->currentState, this->kValues.at(0), this->nextState);
+        this->finishDenseOutput();
+    }
 }
 
-template <size_t numberStages>
-ExtendedStateVector
-svIntegratorRungeKutta<numberStages>::computeDerivatives(double time,
-                                                         double timeStep,
-                                                         const ExtendedStateVector& states)
+template <size_t numberStages> void svIntegratorRungeKutta<numberStages>::prepareWorkspaces()
 {
-    states.setStates(this->dynPtrs);
+    const auto& layout = this->getStateLayout();
+    for (auto& kVector : this->kValues) {
+        this->workspaceResizes += kVector.resize(layout);
+    }
+    this->workspaceResizes += this->currentState.resize(layout);
+    this->workspaceResizes += this->stageState.resize(layout);
+    this->workspaceResizes += this->nextState.resize(layout);
+}
 
-    for (auto dynPtr : this->dynPtrs) {
-        dynPtr->equationsOfMotion(time, timeStep);
+template <size_t numberStages>
+const std::shared_ptr<const ExtendedStateLayout>&
+svIntegratorRungeKutta<numberStages>::getStateLayout()
+{
+    if (!this->stateLayout || !this->stateLayout->isValidFor(this->dynPtrs)) {
+        this->stateLayout = ExtendedStateLayout::fromDynObjects(this->dynPtrs);
     }
+    return this->stateLayout;
+}
 
-    return ExtendedStateVector::fromStateDerivs(this->dynPtrs);
+template <size_t numberStages>
+void svIntegratorRungeKutta<numberStages>::computeDerivatives(double time,
+                                                              double timeStep,
+                                                              const ExtendedStateVector& states,
+                                                              ExtendedStateVector& stateDerivs)
+{
+    states.setStates();
+    this->computeEquationsOfMotion(time, timeStep);
+    stateDerivs.readStateDerivs();
 }
 
 template <size_t numberStages>
-auto svIntegratorRungeKutta<numberStages>::computeKCoefficients(
+void svIntegratorRungeKutta<numberStages>::computeKCoefficients(
     double currentTime,
     double timeStep,
-    const ExtendedStateVector& currentStates) -> KCoefficientsValues
+    const ExtendedStateVector& currentStates,
+    KCoefficientsValues& kVectors)
 {
-    KCoefficientsValues kVectors;
-
     for (size_t stageIndex = 0; stageIndex < numberStages; stageIndex++) {
         double timeToComputeK = currentTime + this->coefficients->cArray.at(stageIndex) * timeStep;
 
         if (stageIndex == 0) // Avoids one ExtendedStateVector copy
         {
-            kVectors.at(stageIndex) =
-                this->computeDerivatives(timeToComputeK, timeStep, currentStates);
+            this->computeDerivatives(timeToComputeK, timeStep, currentStates, kVectors.at(stageIndex));
             continue;
         }
 
-        ExtendedStateVector stateToComputeK = currentStates;
+        // Same layout, so this copy reuses the existing storage of stageState
+        this->stageState = currentStates;
         for (size_t subStageIndex = 0; subStageIndex < stageIndex; subStageIndex++) {
             if (this->coefficients->aMatrix.at(stageIndex).at(subStageIndex) == 0) continue;
-            stateToComputeK +=
-                kVectors.at(subStageIndex) *
-                (this->coefficients->aMatrix.at(stageIndex).at(subStageIndex) * timeStep);
+            this->stageState.addScaled(kVectors.at(subStageIndex),
+                                       this->coefficients->aMatrix.at(stageIndex).at(subStageIndex) *
+                                           timeStep);
         }
 
-        kVectors.at(stageIndex) =
-            this->computeDerivatives(timeToComputeK, timeStep, stateToComputeK);
+        this->computeDerivatives(timeToComputeK, timeStep, this->stageState, kVectors.at(stageIndex));
     }
-
-    return kVectors;
 }
 
 template <size_t numberStages>
-ExtendedStateVector
-svIntegratorRungeKutta<numberStages>::computeNextState(double timeStep,
-                                                       const ExtendedStateVector& currentStates,
-                                                       const KCoefficientsValues& kVectors)
+void svIntegratorRungeKutta<numberStages>::computeNextState(double timeStep,
+                                                            const ExtendedStateVector& currentStates,
+                                                            const KCoefficientsValues& kVectors,
+                                                            ExtendedStateVector& nextStates)
 {
-    ExtendedStateVector result = currentStates;
+    nextStates = currentStates;
     for (size_t stageIndex = 0; stageIndex < numberStages; stageIndex++) {
         if (this->coefficients->bArray.at(stageIndex) == 0) continue;
-        result += kVectors.at(stageIndex) * (this->coefficients->bArray.at(stageIndex) * timeStep);
+        nextStates.addScaled(kVectors.at(stageIndex),
+                             this->coefficients->bArray.at(stageIndex) * timeStep);
+    }
+}
+
+template <size_t numberStages>
+void svIntegratorRungeKutta<numberStages>::recordDenseOutputStep(double startTime,
+                                                                 double timeStep,
+                                                                 const ExtendedStateVector& startState,
+                                                                 const ExtendedStateVector& startDeriv,
+                                                                 const ExtendedStateVector& endState)
+{
+    if (this->denseOutputSegmentCount > 0) {
+        this->denseOutputSegments.at(this->denseOutputSegmentCount - 1).endDeriv = startDeriv;
+    }
+    if (this->denseOutputSegmentCount == this->denseOutputSegments.size()) {
+        this->denseOutputSegments.emplace_back();
+    }
+
+    // Same layout, so these copies reuse the existing storage of the segment
+    DenseOutputSegment& segment = this->denseOutputSegments.at(this->denseOutputSegmentCount++);
+    segment.startTime = startTime;
+    segment.timeStep = timeStep;
+    segment.startState = startState;
+    segment.startDeriv = startDeriv;
+    segment.endState = endState;
+    segment.endDeriv.resize(endState.getLayout());
+}
+
+template <size_t numberStages> void svIntegratorRungeKutta<numberStages>::finishDenseOutput()
+{
+    if (this->denseOutputSegmentCount == 0) return;
+
+    DenseOutputSegment& segment = this->denseOutputSegments.at(this->denseOutputSegmentCount - 1);
+    // The "k" coefficients are those of the last step, which is the last recorded one
+    if (this->isLastStageAtEndOfStep()) {
+        segment.endDeriv = this->kValues.back();
+        return;
     }
+    this->computeDerivatives(segment.startTime + segment.timeStep,
+                             segment.timeStep,
+                             segment.endState,
+                             segment.endDeriv);
+}
 
-    return result;
+template <size_t numberStages>
+bool svIntegratorRungeKutta<numberStages>::isLastStageAtEndOfStep() const
+{
+    // The stage and the next states are then accumulated with the same operations
+    const auto& lastRow = this->coefficients->aMatrix.back();
+    if (numberStages < 2 || this->coefficients->cArray.back() != 1 ||
+        this->coefficients->bArray.back() != 0) {
+        return false;
+    }
+    for (size_t stageIndex = 0; stageIndex + 1 < numberStages; stageIndex++) {
+        if (lastRow.at(stageIndex) != this->coefficients->bArray.at(stageIndex)) return false;
+    }
+    return true;
+}
+
+template <size_t numberStages>
+bool svIntegratorRungeKutta<numberStages>::getInterpolatedState(const DynamicObject& dynObject,
+                                                                const std::string& stateName,
+                                                                double time,
+                                                                Eigen::MatrixXd& state) const
+{
+    if (!this->denseOutput || this->denseOutputSegmentCount == 0) return false;
+
+    // Simulation times are integer nanoseconds, so times up to a nanosecond outside
+    // of the last call to integrate are taken as its start or end
+    const double timeTolerance = 1e-9;
+    const DenseOutputSegment& firstSegment = this->denseOutputSegments.front();
+    const DenseOutputSegment& lastSegment = this->denseOutputSegments.at(this->denseOutputSegmentCount - 1);
+    if (time < firstSegment.startTime - timeTolerance ||
+        time > lastSegment.startTime + lastSegment.timeStep + timeTolerance) {
+        return false;
+    }
+
+    auto dynIt = std::find(this->dynPtrs.cbegin(), this->dynPtrs.cend(), &dynObject);
+    if (dynIt == this->dynPtrs.cend()) return false;
+    size_t dynIndex = std::distance(this->dynPtrs.cbegin(), dynIt);
+    int64_t entryIndex = lastSegment.endState.getLayout()->findEntry({dynIndex, stateName});
+    if (entryIndex < 0) return false;
+    const ExtendedStateLayoutEntry& entry = lastSegment.endState.getLayout()->entries.at(entryIndex);
+
+    size_t segmentIndex = 0;
+    while (segmentIndex + 1 < this->denseOutputSegmentCount &&
+           time > this->denseOutputSegments.at(segmentIndex).startTime +
+                      this->denseOutputSegments.at(segmentIndex).timeStep) {
+        segmentIndex++;
+    }
+    const DenseOutputSegment& segment = this->denseOutputSegments.at(segmentIndex);
+
+    auto weights = getHermiteWeights(segment, time);
+    state = weights[0] * segment.startState.at(entry) + weights[1] * segment.startDeriv.at(entry) +
+            weights[2] * segment.endState.at(entry) + weights[3] * segment.endDeriv.at(entry);
+    return true;
+}
+
+template <size_t numberStages>
+std::array<double, 4>
+svIntegratorRungeKutta<numberStages>::getHermiteWeights(const DenseOutputSegment& segment, double time)
+{
+    double h = segment.timeStep;
+    double theta = h > 0 ? std::min(std::max((time - segment.startTime) / h, 0.0), 1.0) : 1.0;
+
+    // Cubic Hermite basis functions, the derivative terms are scaled by the step
+    return {(1 + 2 * theta) * (1 - theta) * (1 - theta),
+            theta * (1 - theta) * (1 - theta) * h,
+            theta * theta * (3 - 2 * theta),
+            theta * theta * (theta - 1) * h};
+}
+
+template <size_t numberStages>
+void svIntegratorRungeKutta<numberStages>::interpolateSegment(const DenseOutputSegment& segment,
+                                                              double time,
+                                                              ExtendedStateVector& states)
+{
+    auto weights = getHermiteWeights(segment, time);
+    states.resize(segment.endState.getLayout());
+    states.getValues() = weights[0] * segment.startState.getValues() +
+                         weights[1] * segment.startDeriv.getValues() +
+                         weights[2] * segment.endState.getValues() +
+                         weights[3] * segment.endDeriv.getValues();
 }
 
 #endif /* svIntegratorRungeKutta_h */
@@ -0,0 +1,122 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "svIntegratorSymplectic.h"
+#include <stdexcept>
+
+svIntegratorSymplectic::svIntegratorSymplectic(DynamicObject* dynIn,
+                                               const std::vector<double>& driftCoefficients,
+                                               const std::vector<double>& kickCoefficients)
+    : StateVecIntegrator(dynIn), driftCoefficients(driftCoefficients), kickCoefficients(kickCoefficients)
+{
+    if (driftCoefficients.size() != kickCoefficients.size()) {
+        throw std::invalid_argument("The drift and kick coefficients of a symplectic integrator "
+                                    "must have the same size");
+    }
+}
+
+void svIntegratorSymplectic::integrate(double currentTime, double timeStep)
+{
+    this->prepareLayout();
+    this->states.readStates();
+
+    double stageTime = currentTime;
+    for (size_t stageIndex = 0; stageIndex < this->driftCoefficients.size(); stageIndex++) {
+        double drift = this->driftCoefficients.at(stageIndex) * timeStep;
+        if (drift != 0) {
+            Eigen::VectorXd& values = this->states.getValues();
+            for (const auto& pair : this->driftPairs) {
+                values.segment(pair.positionOffset, pair.size) += drift * values.segment(pair.velocityOffset, pair.size);
+            }
+            stageTime += drift;
+        }
+
+        double kick = this->kickCoefficients.at(stageIndex) * timeStep;
+        if (kick == 0) continue;
+
+        this->states.setStates();
+        this->computeEquationsOfMotion(stageTime, timeStep);
+        this->stateDerivs.readStateDerivs();
+        this->checkFirstOrderStates();
+        this->states.getValues() += kick * this->stateDerivs.getValues().cwiseProduct(this->kickMask);
+    }
+
+    this->states.setStates();
+}
+
+void svIntegratorSymplectic::prepareLayout()
+{
+    if (this->stateLayout && this->stateLayout->isValidFor(this->dynPtrs)) return;
+
+    this->stateLayout = ExtendedStateLayout::fromDynObjects(this->dynPtrs);
+    this->states.resize(this->stateLayout);
+    this->stateDerivs.resize(this->stateLayout);
+
+    this->driftPairs.clear();
+    this->firstOrderEntries.clear();
+    this->kickMask = Eigen::VectorXd::Ones(this->stateLayout->size);
+    std::vector<bool> isPaired(this->stateLayout->entries.size(), false);
+    const auto& entries = this->stateLayout->entries;
+    for (size_t index = 0; index < entries.size(); index++) {
+        const std::string& name = entries[index].id.second;
+        const size_t nameLength = this->positionStateName.size();
+        if (name.size() < nameLength ||
+            name.compare(name.size() - nameLength, nameLength, this->positionStateName) != 0) {
+            continue;
+        }
+
+        // The velocity state has the same prefix as the position state
+        std::string velocityName = name.substr(0, name.size() - nameLength) + this->velocityStateName;
+        int64_t velocityIndex = this->stateLayout->findEntry({entries[index].id.first, velocityName});
+        if (velocityIndex < 0) continue;
+        const auto& position = entries[index];
+        const auto& velocity = entries.at(velocityIndex);
+        if (position.rows * position.cols != velocity.rows * velocity.cols) continue;
+
+        this->driftPairs.push_back({position.offset, velocity.offset, position.rows * position.cols});
+        this->kickMask.segment(position.offset, position.rows * position.cols).setZero();
+        isPaired[index] = true;
+        isPaired[velocityIndex] = true;
+    }
+
+    for (size_t index = 0; index < entries.size(); index++) {
+        if (!isPaired[index] && entries[index].stateData->drivesDynamics) {
+            this->firstOrderEntries.push_back(index);
+        }
+    }
+}
+
+void svIntegratorSymplectic::checkFirstOrderStates()
+{
+    if (this->firstOrderWarningIssued) return;
+
+    for (size_t index : this->firstOrderEntries) {
+        const auto& entry = this->stateLayout->entries.at(index);
+        if (!this->stateDerivs.at(entry).isZero(0.0)) {
+            this->bskLogger.bskLog(BSK_WARNING,
+                                   "The state %s has a nonzero derivative, but symplectic integrators only "
+                                   "integrate the position and velocity states %s and %s to their full order.",
+                                   entry.id.second.c_str(),
+                                   this->positionStateName.c_str(),
+                                   this->velocityStateName.c_str());
+            this->firstOrderWarningIssued = true;
+            return;
+        }
+    }
+}
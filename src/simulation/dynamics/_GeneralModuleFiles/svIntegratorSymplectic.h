@@ -0,0 +1,100 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef svIntegratorSymplectic_h
+#define svIntegratorSymplectic_h
+
+#include "architecture/utilities/bskLogging.h"
+#include "dynamicObject.h"
+#include "extendedStateVector.h"
+#include "stateVecIntegrator.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * The svIntegratorSymplectic class implements explicit symplectic integrators built as a
+ * composition of drifts and kicks.
+ *
+ * A step is split in stages. In stage i, the position states are first moved by the value of
+ * their velocity state multiplied by driftCoefficients[i] times the step (drift). The equations
+ * of motion are then evaluated, and every other state is moved by its derivative multiplied by
+ * kickCoefficients[i] times the step (kick). Kicks with a zero coefficient do not evaluate the
+ * equations of motion.
+ *
+ * The composition is symplectic, which bounds the energy error of conservative orbits over long
+ * propagations, as long as the acceleration only depends on the position. States other than the
+ * position and velocity states, such as the attitude, are only integrated to first order, so these
+ * integrators are meant for translational dynamics.
+ */
+class svIntegratorSymplectic : public StateVecIntegrator {
+  public:
+    /** Creates a symplectic integrator for the given DynamicObject using the passed coefficients */
+    svIntegratorSymplectic(DynamicObject* dynIn,
+                           const std::vector<double>& driftCoefficients,
+                           const std::vector<double>& kickCoefficients);
+
+    /** Performs the integration of the associated dynamic objects up to time currentTime+timeStep */
+    virtual void integrate(double currentTime, double timeStep) override;
+
+    /** Name of the position states, which may be prefixed as in the spacecraft system */
+    std::string positionStateName = "hubPosition";
+
+    /** Name of the velocity states, the derivative of the position states */
+    std::string velocityStateName = "hubVelocity";
+
+    BSKLogger bskLogger; /**< BSK Logging */
+
+  protected:
+    /** Finds the position and velocity states in the current layout, when it changes */
+    void prepareLayout();
+
+    /** Warns once if states that are only integrated to first order have a nonzero derivative */
+    void checkFirstOrderStates();
+
+  protected:
+    const std::vector<double> driftCoefficients; /**< Drift coefficient of every stage */
+    const std::vector<double> kickCoefficients;  /**< Kick coefficient of every stage */
+
+    /** Cached location of every state in the flat ExtendedStateVector storage */
+    std::shared_ptr<const ExtendedStateLayout> stateLayout;
+
+    /** Location of a position state and of its velocity state in the flat storage */
+    struct DriftPair {
+        Eigen::Index positionOffset; /**< Index of the first element of the position state */
+        Eigen::Index velocityOffset; /**< Index of the first element of the velocity state */
+        Eigen::Index size;           /**< Number of elements of both states */
+    };
+
+    /** Position and velocity states of every dynamic object */
+    std::vector<DriftPair> driftPairs;
+
+    /** Layout entries of the states that are only integrated to first order */
+    std::vector<size_t> firstOrderEntries;
+
+    /** One for the states that are kicked, zero for the position states */
+    Eigen::VectorXd kickMask;
+
+    ExtendedStateVector states;      /**< Workspace holding the states during the step */
+    ExtendedStateVector stateDerivs; /**< Workspace holding the state derivatives of a kick */
+
+    bool firstOrderWarningIssued = false; /**< Set once the first order warning was logged */
+};
+
+#endif /* svIntegratorSymplectic_h */
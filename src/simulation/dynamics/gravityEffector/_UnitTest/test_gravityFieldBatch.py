@@ -0,0 +1,86 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+import os
+
+import numpy as np
+import pytest
+from Basilisk.simulation import gravityEffector
+from Basilisk.simulation.gravityEffector import loadGravFromFile
+from Basilisk.simulation.gravityEffector import loadPolyFromFile
+
+path = os.path.dirname(os.path.abspath(__file__))
+
+
+def createGravityModel(modelName):
+    if modelName == "pointMass":
+        model = gravityEffector.PointMassGravityModel()
+        model.muBody = 0.3986004415E+15
+        radius = 6378.1363E3
+    elif modelName == "sphericalHarmonics":
+        model = gravityEffector.SphericalHarmonicsGravityModel()
+        loadGravFromFile(path + '/GGM03S.txt', model, 20)
+        radius = model.radEquator
+    else:
+        model = gravityEffector.PolyhedralGravityModel()
+        loadPolyFromFile(path + '/EROS856Vert1708Fac.txt', model)
+        model.muBody = 4.46275472004 * 1e5
+        radius = 16E3
+    model.initializeParameters()
+    return model, radius
+
+
+@pytest.mark.parametrize("modelName", ["pointMass", "sphericalHarmonics", "polyhedral"])
+@pytest.mark.parametrize("numberPositions", [1, 4, 11])
+def test_gravityFieldBatch(modelName, numberPositions):
+    r"""
+    **Validation Test Description**
+
+    This unit test evaluates the gravity field of a body at several positions with a single
+    ``computeFieldBatch`` call, and compares the result with ``computeField`` evaluated at
+    each position separately. The number of positions is chosen so that both full and
+    partially filled packets of the batched spherical harmonics recursion are exercised.
+
+    **Test Parameters**
+
+    Args:
+        modelName (str): gravity model to test
+        numberPositions (int): number of positions evaluated in the batch
+
+    **Description of Variables Being Tested**
+
+    The batched accelerations must match the single position accelerations to a relative
+    accuracy of 1e-12.
+    """
+    model, radius = createGravityModel(modelName)
+
+    rng = np.random.default_rng(0)
+    directions = rng.normal(size=(numberPositions, 3))
+    directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+    positions = directions * radius * rng.uniform(1.1, 3.0, size=(numberPositions, 1))
+
+    batchAccelerations = np.array(model.computeFieldBatch(positions))
+    assert batchAccelerations.shape == (numberPositions, 3)
+
+    for position, batchAcceleration in zip(positions, batchAccelerations):
+        acceleration = np.array(model.computeField(position)).flatten()
+        np.testing.assert_allclose(batchAcceleration, acceleration,
+                                   rtol=1e-12, atol=1e-12 * np.linalg.norm(acceleration))
+
+
+if __name__ == "__main__":
+    test_gravityFieldBatch("sphericalHarmonics", 11)
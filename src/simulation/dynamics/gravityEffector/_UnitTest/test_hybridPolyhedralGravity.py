@@ -0,0 +1,130 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+import os
+
+import numpy as np
+import pytest
+from Basilisk.simulation import gravityEffector
+
+path = os.path.dirname(os.path.abspath(__file__))
+
+
+def createPolyhedralModel(model):
+    model.loadFromFile(path + '/EROS856Vert1708Fac.txt')
+    model.muBody = 4.46275472004 * 1e5
+    model.initializeParameters()
+    return model
+
+
+@pytest.mark.parametrize("radiusFactor, accuracy", [(1.0, 1e-14), (1.75, 1e-3), (3.0, 1e-5), (5.0, 1e-7)])
+def test_hybridPolyhedralGravity(radiusFactor, accuracy):
+    r"""
+    **Validation Test Description**
+
+    This unit test compares the hybrid polyhedral gravity model against the polyhedral model
+    of the same shape.  Close to the body the hybrid model must return the polyhedral field
+    exactly, in the transition shell and far from the body the fitted spherical harmonics
+    must converge to the polyhedral field.
+
+    **Test Parameters**
+
+    Args:
+        radiusFactor (float): distance of the evaluated positions, in Brillouin radii
+        accuracy (float): relative accuracy required from the hybrid model
+
+    **Description of Variables Being Tested**
+
+    The hybrid accelerations must match the polyhedral accelerations to the given relative
+    accuracy.  The degree zero coefficient of the fitted harmonics must be one.
+    """
+    hybrid = createPolyhedralModel(gravityEffector.HybridPolyhedralGravityModel())
+    poly = createPolyhedralModel(gravityEffector.PolyhedralGravityModel())
+
+    radius = hybrid.getBrillouinRadius()
+    assert hybrid.getFarFieldModel().cBar[0][0] == pytest.approx(1, abs=1e-12)
+
+    rng = np.random.default_rng(0)
+    directions = rng.normal(size=(20, 3))
+    directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+    for position in directions * radius * radiusFactor:
+        hybridAcceleration = np.array(hybrid.computeField(position)).flatten()
+        polyAcceleration = np.array(poly.computeField(position)).flatten()
+        np.testing.assert_allclose(hybridAcceleration, polyAcceleration,
+                                   rtol=0, atol=accuracy * np.linalg.norm(polyAcceleration))
+
+
+@pytest.mark.parametrize("farFieldDegree", [1, 3, 5])
+def test_hybridPolyhedralGravityOddDegree(farFieldDegree):
+    r"""
+    **Validation Test Description**
+
+    The fitted coefficients are the exact projection of the constant density polyhedron on the spherical harmonics,
+    so they must not depend on the degree of the fit.  This test fits an odd degree expansion and compares it with a
+    degree 12 expansion of the same shape, and with the polyhedral field far from the body.
+
+    **Test Parameters**
+
+    Args:
+        farFieldDegree (int): odd degree of the fitted spherical harmonics
+
+    **Description of Variables Being Tested**
+
+    The coefficients up to ``farFieldDegree`` must match those of the degree 12 fit within 1e-13.  At 20 Brillouin
+    radii, the far field acceleration must match the polyhedral acceleration within the truncation error of the
+    expansion.
+    """
+    hybrid = gravityEffector.HybridPolyhedralGravityModel()
+    hybrid.farFieldDegree = farFieldDegree
+    createPolyhedralModel(hybrid)
+    reference = gravityEffector.HybridPolyhedralGravityModel()
+    reference.farFieldDegree = 12
+    createPolyhedralModel(reference)
+    poly = createPolyhedralModel(gravityEffector.PolyhedralGravityModel())
+
+    farField = hybrid.getFarFieldModel()
+    referenceFarField = reference.getFarFieldModel()
+    for n in range(farFieldDegree + 1):
+        np.testing.assert_allclose(farField.cBar[n], referenceFarField.cBar[n][:n + 1], rtol=0, atol=1e-13)
+        np.testing.assert_allclose(farField.sBar[n], referenceFarField.sBar[n][:n + 1], rtol=0, atol=1e-13)
+
+    radiusFactor = 20.0
+    rng = np.random.default_rng(0)
+    directions = rng.normal(size=(10, 3))
+    directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+    for position in directions * hybrid.getBrillouinRadius() * radiusFactor:
+        farFieldAcceleration = np.array(farField.computeField(position)).flatten()
+        polyAcceleration = np.array(poly.computeField(position)).flatten()
+        np.testing.assert_allclose(farFieldAcceleration, polyAcceleration, rtol=0,
+                                   atol=radiusFactor ** -(farFieldDegree + 1) * np.linalg.norm(polyAcceleration))
+
+
+def test_hybridPolyhedralGravityFactors():
+    r"""
+    **Validation Test Description**
+
+    The hybrid model must refuse to initialize when the transition shell is not consistent.
+    """
+    hybrid = gravityEffector.HybridPolyhedralGravityModel()
+    hybrid.loadFromFile(path + '/EROS856Vert1708Fac.txt')
+    hybrid.polyhedralRadiusFactor = 2.0
+    hybrid.farFieldRadiusFactor = 1.5
+    assert hybrid.initializeParameters() is not None
+
+
+if __name__ == "__main__":
+    test_hybridPolyhedralGravity(3.0, 1e-5)
@@ -0,0 +1,112 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+import os
+
+import numpy as np
+from Basilisk.simulation import gravityEffector
+from Basilisk.simulation.gravityEffector import loadGravFromFile
+
+path = os.path.dirname(os.path.abspath(__file__))
+
+
+def createInterpolatedModel(cacheDirectory=""):
+    source = gravityEffector.SphericalHarmonicsGravityModel()
+    loadGravFromFile(path + '/GGM03S.txt', source, 20)
+
+    model = gravityEffector.InterpolatedGravityModel()
+    model.sourceModel = source
+    model.minimumRadius = source.radEquator + 200E3
+    model.maximumRadius = source.radEquator + 2000E3
+    model.angularPoints = 32
+    model.radialPoints = 16
+    model.cacheDirectory = cacheDirectory
+    assert model.initializeParameters() is None
+    return model, source
+
+
+def test_interpolatedGravity():
+    r"""
+    **Validation Test Description**
+
+    This unit test tabulates a spherical harmonics model on the interpolation grid, and
+    compares the interpolated field against the spherical harmonics field inside and
+    outside of the interpolation shell.
+
+    **Description of Variables Being Tested**
+
+    Inside the shell, the interpolated accelerations must match the spherical harmonics to
+    a relative accuracy of 1e-5.  Outside of the shell, the spherical harmonics model is
+    evaluated directly, so both accelerations must be identical.
+    """
+    model, source = createInterpolatedModel()
+
+    rng = np.random.default_rng(0)
+    directions = rng.normal(size=(50, 3))
+    directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+    radii = rng.uniform(model.minimumRadius, model.maximumRadius, size=(50, 1))
+    for position in directions * radii:
+        acceleration = np.array(source.computeField(position)).flatten()
+        np.testing.assert_allclose(np.array(model.computeField(position)).flatten(), acceleration,
+                                   rtol=0, atol=1e-5 * np.linalg.norm(acceleration))
+
+    position = directions[0] * model.maximumRadius * 1.5
+    np.testing.assert_array_equal(np.array(model.computeField(position)),
+                                  np.array(source.computeField(position)))
+
+
+def test_interpolatedGravityCache(tmp_path):
+    r"""
+    **Validation Test Description**
+
+    The first model initialized with a cache directory builds the grid and stores it.  A
+    second model with the same source field and grid must load the stored grid, while a
+    model with a different source field must build a new one.
+
+    **Description of Variables Being Tested**
+
+    The cache state of each model, the name of the cache files, and the equality of the
+    fields interpolated from the built and from the loaded grids.
+    """
+    builtModel, _ = createInterpolatedModel(str(tmp_path))
+    assert not builtModel.isLoadedFromCache()
+    assert os.path.isfile(builtModel.getCacheFileName())
+
+    loadedModel, _ = createInterpolatedModel(str(tmp_path))
+    assert loadedModel.isLoadedFromCache()
+    assert loadedModel.getCacheFileName() == builtModel.getCacheFileName()
+
+    position = [0, 0, builtModel.minimumRadius * 1.1]
+    np.testing.assert_array_equal(np.array(loadedModel.computeField(position)),
+                                  np.array(builtModel.computeField(position)))
+
+    source = gravityEffector.SphericalHarmonicsGravityModel()
+    loadGravFromFile(path + '/GGM03S.txt', source, 10)
+    otherModel = gravityEffector.InterpolatedGravityModel()
+    otherModel.sourceModel = source
+    otherModel.minimumRadius = builtModel.minimumRadius
+    otherModel.maximumRadius = builtModel.maximumRadius
+    otherModel.angularPoints = 32
+    otherModel.radialPoints = 16
+    otherModel.cacheDirectory = str(tmp_path)
+    assert otherModel.initializeParameters() is None
+    assert not otherModel.isLoadedFromCache()
+    assert otherModel.getCacheFileName() != builtModel.getCacheFileName()
+
+
+if __name__ == "__main__":
+    test_interpolatedGravity()
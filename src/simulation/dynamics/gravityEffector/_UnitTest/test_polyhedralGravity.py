@@ -0,0 +1,133 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+import os
+
+import numpy as np
+import pytest
+from Basilisk import __path__
+from Basilisk.simulation import gravityEffector
+
+bskPath = __path__[0]
+path = os.path.dirname(os.path.abspath(__file__))
+
+
+def createPolyhedralModel(fileName, threadCount=1):
+    model = gravityEffector.PolyhedralGravityModel()
+    model.loadFromFile(fileName)
+    model.muBody = 4.46275472004 * 1e5
+    model.threadCount = threadCount
+    model.initializeParameters()
+    return model
+
+
+def directPolyhedralField(model, position):
+    """Werner and Scheeres field summed facet by facet, without the precomputed edge and facet dyads"""
+    vertices = np.array(model.xyzVertex)
+    facets = np.array(model.orderFacet) - 1
+    r = vertices[facets] - position  # vertices of every facet relative to the position
+    norms = np.linalg.norm(r, axis=2)
+
+    volume = np.sum(np.abs(np.einsum('ij,ij->i', vertices[facets[:, 0]],
+                                     np.cross(vertices[facets[:, 1]], vertices[facets[:, 2]])))) / 6
+    normals = np.cross(r[:, 1] - r[:, 0], r[:, 2] - r[:, 1])
+    normals /= np.linalg.norm(normals, axis=1)[:, np.newaxis]
+
+    # facet terms F_f r_f w_f
+    wy = np.einsum('ij,ij->i', r[:, 0], np.cross(r[:, 1], r[:, 2]))
+    wx = (norms[:, 0] * norms[:, 1] * norms[:, 2]
+          + norms[:, 0] * np.einsum('ij,ij->i', r[:, 1], r[:, 2])
+          + norms[:, 1] * np.einsum('ij,ij->i', r[:, 2], r[:, 0])
+          + norms[:, 2] * np.einsum('ij,ij->i', r[:, 0], r[:, 1]))
+    facetSum = np.sum(normals * (np.einsum('ij,ij->i', normals, r[:, 0]) * 2 * np.arctan2(wy, wx))[:, np.newaxis],
+                      axis=0)
+
+    # edge terms, each edge being visited once by each of its two facets
+    edgeSum = np.zeros(3)
+    for start, end in [(0, 1), (1, 2), (2, 0)]:
+        edge = r[:, end] - r[:, start]
+        length = np.linalg.norm(edge, axis=1)
+        edgeNormals = np.cross(edge, normals)
+        edgeNormals /= np.linalg.norm(edgeNormals, axis=1)[:, np.newaxis]
+        a = norms[:, start]
+        b = norms[:, end]
+        factor = np.log((a + b + length) / (a + b - length))
+        edgeSum += np.sum(normals * (np.einsum('ij,ij->i', edgeNormals, r[:, start]) * factor)[:, np.newaxis],
+                          axis=0)
+
+    return model.muBody / volume * (-edgeSum + facetSum)
+
+
+@pytest.mark.parametrize("radius", [10e3, 20e3, 50e3])
+def test_polyhedralGravityDyads(radius):
+    r"""
+    **Validation Test Description**
+
+    The polyhedral model computes the edge and facet dyads once when it is initialized.  This test compares its field
+    with the field summed facet by facet directly from the vertices, at random positions around Eros.
+
+    **Test Parameters**
+
+    Args:
+        radius (float): [m] distance of the evaluated positions from the body origin
+
+    **Description of Variables Being Tested**
+
+    The accelerations must match the direct sum to a relative accuracy of 1e-10.
+    """
+    model = createPolyhedralModel(path + '/EROS856Vert1708Fac.txt')
+
+    rng = np.random.default_rng(0)
+    directions = rng.normal(size=(10, 3))
+    directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+    for position in directions * radius:
+        acceleration = np.array(model.computeField(position)).flatten()
+        reference = directPolyhedralField(model, position)
+        np.testing.assert_allclose(acceleration, reference, rtol=0, atol=1e-10 * np.linalg.norm(reference))
+
+
+def test_polyhedralGravityThreads():
+    r"""
+    **Validation Test Description**
+
+    The field of a 7790 facets shape model of Eros is evaluated by a model using the calling thread only, and by a
+    model splitting the edges and facets between 3 threads.
+
+    **Description of Variables Being Tested**
+
+    The threaded accelerations must match the serial ones to a relative accuracy of 1e-12, and must be identical
+    when evaluated again with the same threads.
+    """
+    fileName = bskPath + '/supportData/LocalGravData/eros007790.tab'
+    serialModel = createPolyhedralModel(fileName)
+    threadedModel = createPolyhedralModel(fileName, threadCount=3)
+
+    rng = np.random.default_rng(0)
+    directions = rng.normal(size=(10, 3))
+    directions /= np.linalg.norm(directions, axis=1)[:, np.newaxis]
+    for position in directions * 30e3:
+        serialAcceleration = np.array(serialModel.computeField(position)).flatten()
+        threadedAcceleration = np.array(threadedModel.computeField(position)).flatten()
+        np.testing.assert_allclose(threadedAcceleration, serialAcceleration,
+                                   rtol=0, atol=1e-12 * np.linalg.norm(serialAcceleration))
+        np.testing.assert_array_equal(np.array(threadedModel.computeField(position)).flatten(),
+                                      threadedAcceleration)
+
+
+if __name__ == "__main__":
+    test_polyhedralGravityDyads(20e3)
+    test_polyhedralGravityThreads()
@@ -27,6 +27,8 @@ from Basilisk.architecture.swig_common_model import *
 
 from Basilisk.simulation.pointMassGravityModel import PointMassGravityModel
 from Basilisk.simulation.polyhedralGravityModel import PolyhedralGravityModel
+from Basilisk.simulation.hybridPolyhedralGravityModel import HybridPolyhedralGravityModel
+from Basilisk.simulation.interpolatedGravityModel import InterpolatedGravityModel
 from Basilisk.simulation.sphericalHarmonicsGravityModel import SphericalHarmonicsGravityModel
 
 from Basilisk.utilities import deprecated
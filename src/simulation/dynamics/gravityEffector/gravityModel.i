@@ -42,4 +42,15 @@ from Basilisk.architecture.swig_common_model import *
     }
 }
 
+// The batched field is exposed to Python with one position per row, see the %extend below
+%ignore GravityModel::computeFieldBatch(const Eigen::Matrix3Xd&, Eigen::Matrix3Xd&) const;
+
 %include "simulation/dynamics/_GeneralModuleFiles/gravityModel.h"
+
+%extend GravityModel {
+    Eigen::MatrixX3d computeFieldBatch(const Eigen::MatrixX3d& positions_planetFixed) const {
+        Eigen::Matrix3Xd accelerations_planetFixed;
+        $self->computeFieldBatch(positions_planetFixed.transpose(), accelerations_planetFixed);
+        return accelerations_planetFixed.transpose();
+    }
+}
@@ -0,0 +1,212 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "hybridPolyhedralGravityModel.h"
+#include "simulation/dynamics/_GeneralModuleFiles/gravityEffector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+// Computes the nodes and weights of the Gauss-Legendre rule of the given
+// number of points on the interval [0, 1].
+void gaussLegendre(size_t numberPoints, std::vector<double>& nodes, std::vector<double>& weights)
+{
+    nodes.resize(numberPoints);
+    weights.resize(numberPoints);
+    for (size_t i = 0; i < numberPoints; i++) {
+        // Newton iterations on P_n, starting from the Chebyshev approximation of the root
+        double x = cos(M_PI * (i + 0.75) / (numberPoints + 0.5));
+        double derivative = 0;
+        for (int iteration = 0; iteration < 100; iteration++) {
+            double p0 = 1, p1 = x;
+            for (size_t n = 2; n <= numberPoints; n++) {
+                double p2 = ((2 * n - 1) * x * p1 - (n - 1) * p0) / n;
+                p0 = p1;
+                p1 = p2;
+            }
+            if (numberPoints == 1) p0 = 1;
+            derivative = numberPoints * (x * p1 - p0) / (x * x - 1);
+            double step = p1 / derivative;
+            x -= step;
+            if (fabs(step) < 1e-15) break;
+        }
+        nodes[i] = 0.5 * (1 - x);
+        weights[i] = 1 / ((1 - x * x) * derivative * derivative);
+    }
+}
+
+// Index of the (degree, order) term in a lower-triangular table stored row by row
+inline size_t triangularIndex(const size_t degree, const size_t order)
+{
+    return degree * (degree + 1) / 2 + order;
+}
+
+// Evaluates the unnormalized regular solid harmonics r^n P_nm(sin(lat)) exp(j m lon)
+// at the given point, up to the given degree (no Condon-Shortley phase).
+void solidHarmonics(const Eigen::Vector3d& point, size_t degree, std::vector<double>& realPart,
+                    std::vector<double>& imaginaryPart)
+{
+    const double x = point[0], y = point[1], z = point[2];
+    const double r2 = point.squaredNorm();
+
+    for (size_t m = 0; m <= degree; m++) {
+        const size_t mm = triangularIndex(m, m);
+        if (m == 0) {
+            realPart[mm] = 1;
+            imaginaryPart[mm] = 0;
+        }
+        else {
+            const size_t previous = triangularIndex(m - 1, m - 1);
+            realPart[mm] = (2 * m - 1) * (x * realPart[previous] - y * imaginaryPart[previous]);
+            imaginaryPart[mm] = (2 * m - 1) * (x * imaginaryPart[previous] + y * realPart[previous]);
+        }
+
+        if (m + 1 > degree) continue;
+        realPart[triangularIndex(m + 1, m)] = (2 * m + 1) * z * realPart[mm];
+        imaginaryPart[triangularIndex(m + 1, m)] = (2 * m + 1) * z * imaginaryPart[mm];
+
+        for (size_t n = m + 2; n <= degree; n++) {
+            const size_t nm = triangularIndex(n, m);
+            const size_t n1m = triangularIndex(n - 1, m);
+            const size_t n2m = triangularIndex(n - 2, m);
+            realPart[nm] =
+                ((2 * n - 1) * z * realPart[n1m] - (n + m - 1) * r2 * realPart[n2m]) / (n - m);
+            imaginaryPart[nm] = ((2 * n - 1) * z * imaginaryPart[n1m] -
+                                 (n + m - 1) * r2 * imaginaryPart[n2m]) /
+                                (n - m);
+        }
+    }
+}
+}
+
+std::optional<std::string> HybridPolyhedralGravityModel::initializeParameters()
+{
+    auto errorMessage = PolyhedralGravityModel::initializeParameters();
+    if (errorMessage) return errorMessage;
+
+    if (this->polyhedralRadiusFactor < 1.0 ||
+        this->farFieldRadiusFactor < this->polyhedralRadiusFactor) {
+        return "Could not initialize hybrid polyhedral model: the radius factors must satisfy "
+               "1 <= polyhedralRadiusFactor <= farFieldRadiusFactor.";
+    }
+
+    this->brillouinRadius = this->xyzVertex.rowwise().norm().maxCoeff();
+    this->fitFarField();
+
+    this->farField.bskLogger = this->bskLogger;
+    return this->farField.initializeParameters();
+}
+
+std::optional<std::string>
+HybridPolyhedralGravityModel::initializeParameters(const GravBodyData& body)
+{
+    this->muBody = body.mu;
+    return this->initializeParameters();
+}
+
+void HybridPolyhedralGravityModel::fitFarField()
+{
+    /* For a constant density body, the normalized coefficients are
+           C_nm + j S_nm = 1 / ((2n+1) V R^n) * integral of N_nm r^n P_nm(sin(lat)) exp(j m lon) dV
+       The integrand is a homogeneous polynomial of degree n in x, y, z. Splitting the
+       polyhedron into the cones that join the origin to each facet, the volume integral
+       over a cone is h_f / (n + 3) times the surface integral over the facet, where h_f
+       is the (signed) distance from the origin to the plane of the facet. The facet
+       integrals are computed exactly with a collapsed Gauss-Legendre rule: with the Jacobian,
+       the integrand has degree n + 1 in s, and m points integrate up to degree 2m - 1. */
+    const size_t degree = this->farFieldDegree;
+    const double radius = this->brillouinRadius;
+
+    std::vector<double> nodes, weights;
+    gaussLegendre((degree + 3) / 2, nodes, weights);
+
+    std::vector<double> realPart(triangularIndex(degree + 1, 0));
+    std::vector<double> imaginaryPart(triangularIndex(degree + 1, 0));
+    std::vector<double> realIntegral(realPart.size(), 0.0);
+    std::vector<double> imaginaryIntegral(imaginaryPart.size(), 0.0);
+
+    const Eigen::Index nFacet = this->facetVertex.rows();
+    for (Eigen::Index f = 0; f < nFacet; f++) {
+        // Work with coordinates scaled by the reference radius, so that r^n stays bounded
+        const Eigen::Vector3d a = this->xyzVertex.row(this->facetVertex(f, 0)).transpose() / radius;
+        const Eigen::Vector3d b = this->xyzVertex.row(this->facetVertex(f, 1)).transpose() / radius;
+        const Eigen::Vector3d c = this->xyzVertex.row(this->facetVertex(f, 2)).transpose() / radius;
+        const double h = a.dot(this->normalFacet.row(f));
+        const double doubleArea = (b - a).cross(c - b).norm();
+
+        // The point a + s * ((b - a) + t * (c - b)) sweeps the facet with Jacobian 2 * area * s
+        for (size_t i = 0; i < nodes.size(); i++) {
+            for (size_t j = 0; j < nodes.size(); j++) {
+                const double s = nodes[i];
+                const double t = nodes[j];
+                const double weight = weights[i] * weights[j] * doubleArea * s * h;
+                solidHarmonics(a + s * ((b - a) + t * (c - b)), degree, realPart, imaginaryPart);
+                for (size_t k = 0; k < realPart.size(); k++) {
+                    realIntegral[k] += weight * realPart[k];
+                    imaginaryIntegral[k] += weight * imaginaryPart[k];
+                }
+            }
+        }
+    }
+
+    const double scaledVolume = this->volPoly / (radius * radius * radius);
+    this->farField.cBar.assign(degree + 1, {});
+    this->farField.sBar.assign(degree + 1, {});
+    for (size_t n = 0; n <= degree; n++) {
+        this->farField.cBar[n].resize(n + 1);
+        this->farField.sBar[n].resize(n + 1);
+        for (size_t m = 0; m <= n; m++) {
+            // N_nm = sqrt((2 - d_m) (2n + 1) (n - m)! / (n + m)!)
+            const double normalization =
+                exp(0.5 * (log(m == 0 ? 1.0 : 2.0) + log(2.0 * n + 1) + lgamma(n - m + 1.0) -
+                           lgamma(n + m + 1.0)));
+            const double factor = normalization / ((n + 3) * (2 * n + 1) * scaledVolume);
+            this->farField.cBar[n][m] = factor * realIntegral[triangularIndex(n, m)];
+            this->farField.sBar[n][m] = factor * imaginaryIntegral[triangularIndex(n, m)];
+        }
+    }
+
+    this->farField.radEquator = radius;
+    this->farField.muBody = this->muBody;
+    this->farField.maxDeg = degree;
+}
+
+Eigen::Vector3d
+HybridPolyhedralGravityModel::computeField(const Eigen::Vector3d& position_planetFixed) const
+{
+    const double polyhedralRadius = this->polyhedralRadiusFactor * this->brillouinRadius;
+    const double farFieldRadius = this->farFieldRadiusFactor * this->brillouinRadius;
+    const double r = position_planetFixed.norm();
+
+    if (r <= polyhedralRadius) {
+        return PolyhedralGravityModel::computeField(position_planetFixed);
+    }
+    if (r >= farFieldRadius) {
+        return this->farField.computeField(position_planetFixed);
+    }
+
+    // Smoothstep blending, so that the acceleration is continuous with continuous derivative
+    // of the blending weight at both ends of the transition shell
+    const double t = (r - polyhedralRadius) / (farFieldRadius - polyhedralRadius);
+    const double weight = t * t * (3 - 2 * t);
+    return (1 - weight) * PolyhedralGravityModel::computeField(position_planetFixed) +
+           weight * this->farField.computeField(position_planetFixed);
+}
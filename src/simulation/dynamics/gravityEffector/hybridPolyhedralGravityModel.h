@@ -0,0 +1,89 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef HYBRID_POLY_GRAVITY_MODEL_H
+#define HYBRID_POLY_GRAVITY_MODEL_H
+
+#include "simulation/dynamics/gravityEffector/polyhedralGravityModel.h"
+#include "simulation/dynamics/gravityEffector/sphericalHarmonicsGravityModel.h"
+
+/** A polyhedral gravity model that uses a spherical harmonics surrogate far from the body.
+ *
+ * When initialized, the exterior spherical harmonics expansion of the constant density
+ * polyhedron is computed up to `farFieldDegree`, using the radius of the Brillouin sphere
+ * (the smallest sphere centered at the origin that contains every vertex) as the
+ * reference radius.
+ *
+ * When computing the field, the exact polyhedral model is only used inside
+ * `polyhedralRadiusFactor` times the Brillouin radius, and only the spherical harmonics
+ * are used outside `farFieldRadiusFactor` times the Brillouin radius. In between, both
+ * accelerations are blended with a smooth weight, so that the field is continuous.
+ */
+class HybridPolyhedralGravityModel : public PolyhedralGravityModel {
+  public:
+    /** Initialize the polyhedral model and fit the far-field spherical harmonics.
+     *
+     * The attribute `muBody` must be set separately.
+     *
+     * Will return an error message (string) if the polyhedral model could not be
+     * initialized or if the radius factors are not consistent.
+     * Otherwise, returns an empty optional.
+     */
+    std::optional<std::string> initializeParameters() override;
+
+    /** Initialize all parameters necessary for the computation of gravity.
+     *
+     * The attribute `muBody` is read from the given `GravBodyData`.
+     */
+    std::optional<std::string> initializeParameters(const GravBodyData&) override;
+
+    /** Returns the gravity acceleration at a position around this body.
+     *
+     * The position is given in the body-fixed reference frame.
+     * Likewise, the resulting acceleration should be given in the
+     * body-fixed reference frame.
+     */
+    Eigen::Vector3d computeField(const Eigen::Vector3d& position_planetFixed) const override;
+
+    /** Returns the radius of the Brillouin sphere of the polyhedron [m] */
+    double getBrillouinRadius() const { return this->brillouinRadius; }
+
+    /** Returns the spherical harmonics model fitted to the polyhedron */
+    const SphericalHarmonicsGravityModel& getFarFieldModel() const { return this->farField; }
+
+  public:
+    /** Maximum degree of the spherical harmonics fitted to the polyhedron */
+    size_t farFieldDegree = 8;
+
+    /** [-] Inside this multiple of the Brillouin radius, only the polyhedral model is used */
+    double polyhedralRadiusFactor = 1.5;
+
+    /** [-] Outside this multiple of the Brillouin radius, only the spherical harmonics are used */
+    double farFieldRadiusFactor = 2.0;
+
+  private:
+    /** Computes the normalized spherical harmonics coefficients of the polyhedron */
+    void fitFarField();
+
+  private:
+    double brillouinRadius = 0;               /**< [m] Radius of the Brillouin sphere */
+    SphericalHarmonicsGravityModel farField;  /**< Spherical harmonics fitted to the polyhedron */
+};
+
+#endif /* HYBRID_POLY_GRAVITY_MODEL_H */
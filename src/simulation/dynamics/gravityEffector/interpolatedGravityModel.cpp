@@ -0,0 +1,392 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "interpolatedGravityModel.h"
+#include "architecture/utilities/threadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+// Each cube face covers [-pi/4, pi/4] in both equiangular coordinates
+constexpr double faceHalfAngle = M_PI / 4;
+
+// Number of source evaluations hashed into the cache key
+constexpr size_t numberProbes = 32;
+
+constexpr char cacheFileMagic[8] = {'B', 'S', 'K', 'G', 'R', 'I', 'D', '1'};
+
+// Header of the cache files, followed by the grid nodes as doubles
+struct CacheFileHeader {
+    char magic[8];
+    uint64_t key;
+    double minimumRadius;
+    double maximumRadius;
+    uint64_t radialPoints;
+    uint64_t angularPoints;
+};
+
+// 64-bit FNV-1a hash, accumulated over several calls
+void hashBytes(uint64_t& hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+// Catmull-Rom weights of the four nodes around a point at fraction t of the central interval
+Eigen::Vector4d catmullRomWeights(double t)
+{
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    return {0.5 * (-t3 + 2 * t2 - t), 0.5 * (3 * t3 - 5 * t2 + 2), 0.5 * (-3 * t3 + 4 * t2 + t),
+            0.5 * (t3 - t2)};
+}
+
+// Locates a coordinate in a grid of the given number of intervals, returning the
+// interval (clamped to the grid) and the fraction of the coordinate within it
+size_t locate(double coordinate, size_t intervals, double& fraction)
+{
+    const double clamped = std::min(std::max(coordinate, 0.0), double(intervals));
+    const size_t index = std::min(size_t(clamped), intervals - 1);
+    fraction = clamped - index;
+    return index;
+}
+}
+
+InterpolatedGravityModel::~InterpolatedGravityModel()
+{
+    this->releaseCacheFile();
+}
+
+std::optional<std::string> InterpolatedGravityModel::initializeParameters()
+{
+    if (!this->sourceModel) {
+        return "Could not initialize interpolated gravity model: the source model is not set.";
+    }
+    this->sourceModel->bskLogger = this->bskLogger;
+    auto errorMessage = this->sourceModel->initializeParameters();
+    if (errorMessage) return errorMessage;
+
+    return this->initializeGrid();
+}
+
+std::optional<std::string> InterpolatedGravityModel::initializeParameters(const GravBodyData& body)
+{
+    if (!this->sourceModel) {
+        return "Could not initialize interpolated gravity model: the source model is not set.";
+    }
+    this->sourceModel->bskLogger = this->bskLogger;
+    auto errorMessage = this->sourceModel->initializeParameters(body);
+    if (errorMessage) return errorMessage;
+
+    return this->initializeGrid();
+}
+
+std::optional<std::string> InterpolatedGravityModel::initializeGrid()
+{
+    if (this->minimumRadius <= 0 || this->maximumRadius <= this->minimumRadius) {
+        return "Could not initialize interpolated gravity model: the radii must satisfy "
+               "0 < minimumRadius < maximumRadius.";
+    }
+    if (this->angularPoints < 1 || this->radialPoints < 1) {
+        return "Could not initialize interpolated gravity model: the grid needs at least one "
+               "interval in each direction.";
+    }
+
+    this->radialStep = (1 / this->minimumRadius - 1 / this->maximumRadius) / this->radialPoints;
+    this->angularStep = 2 * faceHalfAngle / this->angularPoints;
+
+    // The outer ghost layer of the grid sits one radial step beyond maximumRadius
+    if (1 / this->maximumRadius <= this->radialStep) {
+        return "Could not initialize interpolated gravity model: radialPoints must be larger "
+               "than maximumRadius / minimumRadius - 1.";
+    }
+
+    this->releaseCacheFile();
+    this->gridData = nullptr;
+    this->loadedFromCache = false;
+    this->cacheFileName.clear();
+
+    if (this->cacheDirectory.empty()) {
+        this->buildGrid();
+        return {};
+    }
+
+    const uint64_t key = this->computeCacheKey();
+    char keyString[17];
+    std::snprintf(keyString, sizeof(keyString), "%016llx", static_cast<unsigned long long>(key));
+    this->cacheFileName = this->cacheDirectory + "/gravityGrid_" + keyString + ".bin";
+
+    if (this->loadCacheFile(key)) {
+        this->loadedFromCache = true;
+        return {};
+    }
+
+    this->buildGrid();
+    if (!this->writeCacheFile(key) && this->bskLogger) {
+        this->bskLogger->bskLog(BSK_WARNING, "Could not write the gravity grid cache file %s",
+                                this->cacheFileName.c_str());
+    }
+    return {};
+}
+
+uint64_t InterpolatedGravityModel::computeCacheKey() const
+{
+    uint64_t hash = 14695981039346656037ULL;
+    hashBytes(hash, cacheFileMagic, sizeof(cacheFileMagic));
+    hashBytes(hash, &this->minimumRadius, sizeof(double));
+    hashBytes(hash, &this->maximumRadius, sizeof(double));
+    const uint64_t resolution[2] = {this->radialPoints, this->angularPoints};
+    hashBytes(hash, resolution, sizeof(resolution));
+
+    // Probe positions spiral over the sphere while sweeping the radius of the shell
+    for (size_t i = 0; i < numberProbes; i++) {
+        const double z = 1 - (2 * i + 1.0) / numberProbes;
+        const double longitude = i * M_PI * (3 - sqrt(5.0));
+        const double radius = this->minimumRadius +
+                              (this->maximumRadius - this->minimumRadius) * (i + 0.5) / numberProbes;
+        const Eigen::Vector3d position =
+            radius * Eigen::Vector3d(sqrt(1 - z * z) * cos(longitude),
+                                     sqrt(1 - z * z) * sin(longitude), z);
+        const Eigen::Vector3d acceleration = this->sourceModel->computeField(position);
+        hashBytes(hash, acceleration.data(), 3 * sizeof(double));
+    }
+    return hash;
+}
+
+void InterpolatedGravityModel::buildGrid()
+{
+    const size_t radialNodes = this->radialPoints + 3;
+    const size_t angularNodes = this->angularPoints + 3;
+    const size_t layers = 6 * radialNodes;
+    this->gridStorage.resize(3 * layers * angularNodes * angularNodes);
+
+    // Each layer holds the nodes of one cube face at one radius. The nodes of a layer are
+    // evaluated in one computeFieldBatch call, which the spherical harmonics model
+    // vectorizes over positions.
+    auto buildLayer = [&](size_t layer) {
+        const size_t face = layer / radialNodes;
+        const size_t axis = face / 2;
+        const double sign = face % 2 == 0 ? 1 : -1;
+        const double inverseRadius =
+            1 / this->maximumRadius + (double(layer % radialNodes) - 1) * this->radialStep;
+
+        Eigen::Matrix3Xd positions(3, angularNodes * angularNodes);
+        for (size_t eta = 0; eta < angularNodes; eta++) {
+            for (size_t xi = 0; xi < angularNodes; xi++) {
+                Eigen::Vector3d direction;
+                direction[axis] = sign;
+                direction[(axis + 1) % 3] =
+                    tan(-faceHalfAngle + (double(xi) - 1) * this->angularStep);
+                direction[(axis + 2) % 3] =
+                    tan(-faceHalfAngle + (double(eta) - 1) * this->angularStep);
+                positions.col(eta * angularNodes + xi) = direction.normalized() / inverseRadius;
+            }
+        }
+        Eigen::Matrix3Xd accelerations;
+        this->sourceModel->computeFieldBatch(positions, accelerations);
+        Eigen::Map<Eigen::Matrix3Xd>(this->gridStorage.data() +
+                                         3 * layer * angularNodes * angularNodes,
+                                     3, angularNodes * angularNodes) = accelerations;
+    };
+
+    // The grid is only built when the model is initialized, so the pool is not kept
+    const size_t threads = std::max<size_t>(1, std::min(this->threadCount, layers));
+    if (threads > 1) {
+        ThreadPool threadPool(threads);
+        threadPool.parallelFor(layers, buildLayer);
+    }
+    else {
+        for (size_t layer = 0; layer < layers; layer++) buildLayer(layer);
+    }
+
+    this->gridData = this->gridStorage.data();
+}
+
+bool InterpolatedGravityModel::loadCacheFile(uint64_t key)
+{
+    const size_t nodes = 6 * (this->radialPoints + 3) * (this->angularPoints + 3) *
+                         (this->angularPoints + 3);
+    const size_t fileSize = sizeof(CacheFileHeader) + 3 * nodes * sizeof(double);
+
+    auto headerMatches = [&](const CacheFileHeader& header) {
+        return std::memcmp(header.magic, cacheFileMagic, sizeof(cacheFileMagic)) == 0 &&
+               header.key == key && header.minimumRadius == this->minimumRadius &&
+               header.maximumRadius == this->maximumRadius &&
+               header.radialPoints == this->radialPoints &&
+               header.angularPoints == this->angularPoints;
+    };
+
+#ifdef _WIN32
+    // Without mmap, the grid is read into the storage of this model
+    std::ifstream file(this->cacheFileName, std::ios::binary);
+    CacheFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !headerMatches(header)) {
+        return false;
+    }
+    std::vector<double> storage(3 * nodes);
+    if (!file.read(reinterpret_cast<char*>(storage.data()), fileSize - sizeof(header))) {
+        return false;
+    }
+    this->gridStorage = std::move(storage);
+    this->gridData = this->gridStorage.data();
+#else
+    const int descriptor = open(this->cacheFileName.c_str(), O_RDONLY);
+    if (descriptor < 0) return false;
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || size_t(status.st_size) != fileSize) {
+        close(descriptor);
+        return false;
+    }
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) return false;
+
+    if (!headerMatches(*static_cast<const CacheFileHeader*>(mapping))) {
+        munmap(mapping, fileSize);
+        return false;
+    }
+    this->mappedFile = mapping;
+    this->mappedSize = fileSize;
+    this->gridData = reinterpret_cast<const double*>(static_cast<const char*>(mapping) +
+                                                     sizeof(CacheFileHeader));
+    this->gridStorage.clear();
+    this->gridStorage.shrink_to_fit();
+#endif
+    return true;
+}
+
+bool InterpolatedGravityModel::writeCacheFile(uint64_t key) const
+{
+    CacheFileHeader header;
+    std::memcpy(header.magic, cacheFileMagic, sizeof(cacheFileMagic));
+    header.key = key;
+    header.minimumRadius = this->minimumRadius;
+    header.maximumRadius = this->maximumRadius;
+    header.radialPoints = this->radialPoints;
+    header.angularPoints = this->angularPoints;
+
+    // Write to a uniquely named file first, so that processes building the same grid
+    // concurrently never see a partially written cache file
+    std::random_device randomDevice;
+    std::ostringstream temporaryName;
+    temporaryName << this->cacheFileName << ".tmp" << std::hex << randomDevice() << randomDevice();
+    {
+        std::ofstream file(temporaryName.str(), std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(this->gridStorage.data()),
+                   this->gridStorage.size() * sizeof(double));
+        if (!file) {
+            std::remove(temporaryName.str().c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporaryName.str().c_str(), this->cacheFileName.c_str()) != 0) {
+        // Another process may have created the file in the meantime
+        std::remove(temporaryName.str().c_str());
+        std::ifstream existing(this->cacheFileName);
+        return bool(existing);
+    }
+    return true;
+}
+
+void InterpolatedGravityModel::releaseCacheFile()
+{
+#ifndef _WIN32
+    if (this->mappedFile) munmap(this->mappedFile, this->mappedSize);
+#endif
+    this->mappedFile = nullptr;
+    this->mappedSize = 0;
+}
+
+Eigen::Map<const Eigen::Vector3d>
+InterpolatedGravityModel::gridNode(size_t face, size_t radial, size_t eta, size_t xi) const
+{
+    const size_t angularNodes = this->angularPoints + 3;
+    const size_t layer = face * (this->radialPoints + 3) + radial;
+    return Eigen::Map<const Eigen::Vector3d>(
+        this->gridData + 3 * ((layer * angularNodes + eta) * angularNodes + xi));
+}
+
+Eigen::Vector3d
+InterpolatedGravityModel::computeField(const Eigen::Vector3d& position_planetFixed) const
+{
+    const double radius = position_planetFixed.norm();
+    if (radius < this->minimumRadius || radius > this->maximumRadius) {
+        return this->sourceModel->computeField(position_planetFixed);
+    }
+
+    // The face is the one the position points to, and the equiangular coordinates of the
+    // position on that face lie in [-pi/4, pi/4]
+    Eigen::Index axis;
+    position_planetFixed.cwiseAbs().maxCoeff(&axis);
+    const double normal = fabs(position_planetFixed[axis]);
+    const size_t face = 2 * axis + (position_planetFixed[axis] < 0 ? 1 : 0);
+    const double xiAngle = atan(position_planetFixed[(axis + 1) % 3] / normal);
+    const double etaAngle = atan(position_planetFixed[(axis + 2) % 3] / normal);
+
+    double radialFraction, etaFraction, xiFraction;
+    const size_t radial = locate((1 / radius - 1 / this->maximumRadius) / this->radialStep,
+                                 this->radialPoints, radialFraction);
+    const size_t eta = locate((etaAngle + faceHalfAngle) / this->angularStep, this->angularPoints,
+                              etaFraction);
+    const size_t xi = locate((xiAngle + faceHalfAngle) / this->angularStep, this->angularPoints,
+                             xiFraction);
+
+    // Interval i of the grid is bounded by nodes i + 1 and i + 2, so that its four
+    // interpolation nodes are i to i + 3
+    const Eigen::Vector4d radialWeights = catmullRomWeights(radialFraction);
+    const Eigen::Vector4d etaWeights = catmullRomWeights(etaFraction);
+    const Eigen::Vector4d xiWeights = catmullRomWeights(xiFraction);
+
+    Eigen::Vector3d acceleration = Eigen::Vector3d::Zero();
+    for (size_t i = 0; i < 4; i++) {
+        Eigen::Vector3d etaSum = Eigen::Vector3d::Zero();
+        for (size_t j = 0; j < 4; j++) {
+            Eigen::Vector3d xiSum = Eigen::Vector3d::Zero();
+            for (size_t k = 0; k < 4; k++) {
+                xiSum += xiWeights[k] * this->gridNode(face, radial + i, eta + j, xi + k);
+            }
+            etaSum += etaWeights[j] * xiSum;
+        }
+        acceleration += radialWeights[i] * etaSum;
+    }
+    return acceleration;
+}
+
+double
+InterpolatedGravityModel::computePotentialEnergy(const Eigen::Vector3d& positionWrtPlanet_N) const
+{
+    return this->sourceModel->computePotentialEnergy(positionWrtPlanet_N);
+}
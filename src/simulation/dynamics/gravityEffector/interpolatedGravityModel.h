@@ -0,0 +1,142 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef INTERPOLATED_GRAVITY_MODEL_H
+#define INTERPOLATED_GRAVITY_MODEL_H
+
+#include "simulation/dynamics/_GeneralModuleFiles/gravityModel.h"
+
+#include <memory>
+#include <vector>
+
+/** A gravity model that interpolates the field of another model on a precomputed grid.
+ *
+ * The acceleration of `sourceModel` is tabulated on a cubed-sphere shell grid between
+ * `minimumRadius` and `maximumRadius`. Each of the six cube faces is sampled uniformly
+ * in the equiangular coordinates of the face, and the radial direction is sampled
+ * uniformly in 1/r, so that the point-mass term of the field is a quadratic in the
+ * radial coordinate. computeField interpolates the table with tricubic Catmull-Rom
+ * (Hermite) splines. Positions outside of the shell are evaluated with `sourceModel`.
+ *
+ * When `cacheDirectory` is set, the table is stored in a binary file in that directory,
+ * and later initializations with the same source field and grid memory-map that file
+ * instead of rebuilding the table. The file name is a hash of the grid resolution and
+ * of the field of the source model sampled at a fixed set of probe positions, so that
+ * any change to the coefficients, degree or shape of the source model selects a
+ * different file. Several processes (for example, the runs of a Monte Carlo) can then
+ * share one table.
+ */
+class InterpolatedGravityModel : public GravityModel {
+  public:
+    InterpolatedGravityModel() = default;
+    ~InterpolatedGravityModel();
+
+    /* The model owns the mapping of the cache file, and gridData points into memory owned
+       by this object, so it can be neither copied nor moved. */
+    InterpolatedGravityModel(const InterpolatedGravityModel&) = delete;
+    InterpolatedGravityModel& operator=(const InterpolatedGravityModel&) = delete;
+    InterpolatedGravityModel(InterpolatedGravityModel&&) = delete;
+    InterpolatedGravityModel& operator=(InterpolatedGravityModel&&) = delete;
+
+    /** Initializes the source model and builds or loads the interpolation grid.
+     *
+     * Will return an error message (string) if the source model is not set or could not
+     * be initialized, or if the grid parameters are not valid.
+     * Otherwise, returns an empty optional.
+     */
+    std::optional<std::string> initializeParameters() override;
+
+    /** Initializes the source model with the given `GravBodyData`, then builds or
+     * loads the interpolation grid.
+     */
+    std::optional<std::string> initializeParameters(const GravBodyData&) override;
+
+    /** Returns the gravity acceleration at a position around this body.
+     *
+     * The position is given in the body-fixed reference frame.
+     * Likewise, the resulting acceleration should be given in the
+     * body-fixed reference frame.
+     */
+    Eigen::Vector3d computeField(const Eigen::Vector3d& position_planetFixed) const override;
+
+    /** Returns the gravitational potential energy of the source model.
+     *
+     * The gravity models compute the potential energy of a point-mass, which is
+     * cheaper to evaluate directly than to interpolate.
+     */
+    double computePotentialEnergy(const Eigen::Vector3d& positionWrtPlanet_N) const override;
+
+    /** Returns the path of the cache file, or an empty string if caching is disabled */
+    const std::string& getCacheFileName() const { return this->cacheFileName; }
+
+    /** Returns true if the grid was loaded from the cache file instead of being built */
+    bool isLoadedFromCache() const { return this->loadedFromCache; }
+
+  public:
+    std::shared_ptr<GravityModel> sourceModel;  /**< Model whose field is interpolated */
+
+    double minimumRadius = 0;  /**< [m] Inner radius of the interpolation shell */
+    double maximumRadius = 0;  /**< [m] Outer radius of the interpolation shell */
+
+    size_t radialPoints = 32;   /**< [-] Number of grid intervals in the radial direction */
+    size_t angularPoints = 64;  /**< [-] Number of grid intervals along each edge of a cube face */
+
+    /** Directory of the cache files. If empty, the grid is always built and not stored */
+    std::string cacheDirectory;
+
+    /** Number of threads used to evaluate the source model when building the grid */
+    size_t threadCount = 1;
+
+  private:
+    /** Validates the grid parameters, then loads the grid from the cache file or builds it */
+    std::optional<std::string> initializeGrid();
+
+    /** Returns a hash of the grid parameters and of the source field at probe positions */
+    uint64_t computeCacheKey() const;
+
+    /** Evaluates the source model on every grid node into `gridStorage` */
+    void buildGrid();
+
+    /** Maps the cache file, returning false if it does not exist or does not match */
+    bool loadCacheFile(uint64_t key);
+
+    /** Writes `gridStorage` to the cache file, returning false if it could not be written */
+    bool writeCacheFile(uint64_t key) const;
+
+    /** Releases the mapping of the cache file, if any */
+    void releaseCacheFile();
+
+    /** Returns the acceleration stored at the given grid node */
+    Eigen::Map<const Eigen::Vector3d> gridNode(size_t face, size_t radial, size_t eta,
+                                               size_t xi) const;
+
+  private:
+    double radialStep = 0;   /**< [1/m] Grid spacing of 1/r */
+    double angularStep = 0;  /**< [rad] Grid spacing of the equiangular face coordinates */
+
+    std::vector<double> gridStorage;    /**< Grid built in this process */
+    const double* gridData = nullptr;   /**< Grid in use, in `gridStorage` or in the mapped file */
+
+    std::string cacheFileName;     /**< Path of the cache file */
+    bool loadedFromCache = false;  /**< Whether the grid was loaded from the cache file */
+    void* mappedFile = nullptr;    /**< Start of the mapped cache file */
+    size_t mappedSize = 0;         /**< Size of the mapped cache file */
+};
+
+#endif /* INTERPOLATED_GRAVITY_MODEL_H */
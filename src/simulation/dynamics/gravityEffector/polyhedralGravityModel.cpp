@@ -19,6 +19,48 @@
 
 #include "polyhedralGravityModel.h"
 #include "simulation/dynamics/_GeneralModuleFiles/gravityEffector.h"
+#include "architecture/utilities/threadPool.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace {
+// Below this number of facets per thread, the cost of waking a thread and
+// combining its partial sums is larger than the work it would take over.
+constexpr size_t minimumFacetsPerThread = 2048;
+
+// Stores a 3x3 dyad as a row of a table with one row per edge or facet
+inline void storeDyad(Eigen::Matrix<double, Eigen::Dynamic, 9>& table, Eigen::Index row,
+                      const Eigen::Matrix3d& dyad)
+{
+    table.row(row) = Eigen::Map<const Eigen::Matrix<double, 1, 9>>(dyad.data());
+}
+
+// Multiplies the dyad stored in the given row by a vector
+inline Eigen::Vector3d multiplyDyad(const Eigen::Matrix<double, Eigen::Dynamic, 9>& table,
+                                    Eigen::Index row, const Eigen::Vector3d& vector)
+{
+    // Dyads are stored column-major: (0, 1, 2) is the first column
+    return Eigen::Vector3d(
+        table(row, 0) * vector[0] + table(row, 3) * vector[1] + table(row, 6) * vector[2],
+        table(row, 1) * vector[0] + table(row, 4) * vector[1] + table(row, 7) * vector[2],
+        table(row, 2) * vector[0] + table(row, 5) * vector[1] + table(row, 8) * vector[2]);
+}
+
+// Position of every vertex relative to the evaluation point, and its norm.
+// Each thread owns one, so that computeField stays reentrant.
+struct PolyhedralScratch {
+    Eigen::Matrix3Xd relativeVertex;
+    Eigen::VectorXd relativeVertexNorm;
+};
+
+PolyhedralScratch& getPolyhedralScratch()
+{
+    thread_local PolyhedralScratch scratch;
+    return scratch;
+}
+}
 
 std::optional<std::string> PolyhedralGravityModel::initializeParameters()
 {
@@ -33,8 +75,17 @@ std::optional<std::string> PolyhedralGravityModel::initializeParameters()
     Eigen::Vector3i v;
     Eigen::Vector3d xyz1, xyz2, xyz3, e21, e32;
 
-    /* Initialize normal */
+    /* Initialize normal, volume and facet tables */
     this->normalFacet.setZero(nFacet, 3);
+    this->volPoly = 0;
+    this->facetVertex.resize(nFacet, 3);
+    this->facetDyad.resize(nFacet, 9);
+
+    /* Edges are identified by their (lower, higher) vertex indices. Each edge is
+       shared by two facets, whose contributions are added into a single dyad. */
+    std::map<std::pair<int, int>, Eigen::Index> edgeIndex;
+    std::vector<std::pair<int, int>> edgeList;
+    std::vector<Eigen::Matrix3d> edgeDyadList;
 
     /* Loop through each facet to compute volume */
     for (unsigned int m = 0; m < nFacet; m++) {
@@ -55,6 +106,39 @@ std::optional<std::string> PolyhedralGravityModel::initializeParameters()
 
         /* Add volume contribution */
         this->volPoly += abs(xyz1.cross(xyz2).transpose() * xyz3) / 6;
+
+        /* Store the facet vertices (zero-based) and the facet dyad F_f */
+        Eigen::Vector3d nf = this->normalFacet.row(m).transpose();
+        this->facetVertex.row(m) << i, j, k;
+        storeDyad(this->facetDyad, m, nf * nf.transpose());
+
+        /* Add the contribution of this facet to the dyad E_e of each of its edges */
+        const int edgeVertices[3][2] = {{i, j}, {j, k}, {k, i}};
+        for (const auto& edge : edgeVertices) {
+            Eigen::Vector3d r21 = this->xyzVertex.row(edge[1]).transpose() -
+                                  this->xyzVertex.row(edge[0]).transpose();
+            Eigen::Vector3d n21 = r21.cross(nf) / r21.cross(nf).norm();
+
+            auto key = std::make_pair(std::min(edge[0], edge[1]), std::max(edge[0], edge[1]));
+            auto inserted = edgeIndex.emplace(key, Eigen::Index(edgeList.size()));
+            if (inserted.second) {
+                edgeList.push_back(key);
+                edgeDyadList.push_back(Eigen::Matrix3d::Zero());
+            }
+            edgeDyadList[inserted.first->second] += nf * n21.transpose();
+        }
+    }
+
+    /* Store the unique edges */
+    const Eigen::Index nEdge = Eigen::Index(edgeList.size());
+    this->edgeVertex.resize(nEdge, 2);
+    this->edgeLength.resize(nEdge);
+    this->edgeDyad.resize(nEdge, 9);
+    for (Eigen::Index e = 0; e < nEdge; e++) {
+        this->edgeVertex.row(e) << edgeList[e].first, edgeList[e].second;
+        this->edgeLength[e] =
+            (this->xyzVertex.row(edgeList[e].second) - this->xyzVertex.row(edgeList[e].first)).norm();
+        storeDyad(this->edgeDyad, e, edgeDyadList[e]);
     }
 
     return {};
@@ -69,99 +153,113 @@ std::optional<std::string> PolyhedralGravityModel::initializeParameters(const Gr
 Eigen::Vector3d
 PolyhedralGravityModel::computeField(const Eigen::Vector3d& position_planetFixed) const
 {
-    int i, j, k;
-    Eigen::Vector3i v;
-    Eigen::Vector3d ri, rj, rk;
-    Eigen::Vector3d nf;
-    Eigen::Vector3d r1, r2, re;
-    Eigen::Vector3d r21, n21;
-    Eigen::Matrix3d Ee;
+    const Eigen::Index nVertex = this->xyzVertex.rows();
+    const Eigen::Index nFacet = this->facetVertex.rows();
+    const Eigen::Index nEdge = this->edgeVertex.rows();
+
+    /* Compute vectors and norm from each vertex to the evaluation position */
+    PolyhedralScratch& scratch = getPolyhedralScratch();
+    scratch.relativeVertex.resize(3, nVertex);
+    scratch.relativeVertexNorm.resize(nVertex);
+    for (Eigen::Index n = 0; n < nVertex; n++) {
+        scratch.relativeVertex.col(n) = this->xyzVertex.row(n).transpose() - position_planetFixed;
+        scratch.relativeVertexNorm[n] = scratch.relativeVertex.col(n).norm();
+    }
 
-    int idx_min;
-    double a, b, e, Le;
-    double wy, wx, wf;
+    const size_t threads = std::max<size_t>(
+        1, std::min<size_t>(this->threadCount, size_t(nFacet) / minimumFacetsPerThread));
 
-    Eigen::Vector3d dUe, dUf, acc;
-    dUe.setZero(3);
-    dUf.setZero(3);
+    Eigen::Vector3d dUe = Eigen::Vector3d::Zero();
+    Eigen::Vector3d dUf = Eigen::Vector3d::Zero();
 
-    const size_t nFacet = this->orderFacet.rows();
+    if (threads == 1) {
+        this->addEdgeContributions(scratch.relativeVertex, scratch.relativeVertexNorm, 0, nEdge, dUe);
+        this->addFacetContributions(scratch.relativeVertex, scratch.relativeVertexNorm, 0, nFacet,
+                                    dUf);
+    }
+    else {
+        /* Each thread reduces a contiguous block of edges and facets. Partial sums are
+           added in block order, so that the result does not depend on thread timing. */
+        std::vector<Eigen::Vector3d> partialUe(threads, Eigen::Vector3d::Zero());
+        std::vector<Eigen::Vector3d> partialUf(threads, Eigen::Vector3d::Zero());
+        auto reduceBlock = [&](size_t block) {
+            this->addEdgeContributions(scratch.relativeVertex, scratch.relativeVertexNorm,
+                                       nEdge * block / threads, nEdge * (block + 1) / threads,
+                                       partialUe[block]);
+            this->addFacetContributions(scratch.relativeVertex, scratch.relativeVertexNorm,
+                                        nFacet * block / threads, nFacet * (block + 1) / threads,
+                                        partialUf[block]);
+        };
+
+        /* The pool serves one caller at a time. Other callers, such as spacecraft whose
+           dynamics are evaluated in parallel, reduce the same blocks in their own thread. */
+        std::unique_lock<std::mutex> poolLock(*this->threadPoolMutex, std::try_to_lock);
+        if (poolLock.owns_lock()) {
+            if (!this->threadPool || this->threadPool->getThreadCount() != threads) {
+                this->threadPool.reset();
+                this->threadPool = std::make_shared<ThreadPool>(threads);
+            }
+            this->threadPool->parallelFor(threads, reduceBlock);
+        }
+        else {
+            for (size_t block = 0; block < threads; block++) {
+                reduceBlock(block);
+            }
+        }
 
-    /* Loop through each facet */
-    for (unsigned int m = 0; m < nFacet; m++) {
-        /* Fill auxiliary variables with vertex order on each facet */
-        v = this->orderFacet.row(m);
-        i = v[0] - 1;
-        j = v[1] - 1;
-        k = v[2] - 1;
+        for (size_t block = 0; block < threads; block++) {
+            dUe += partialUe[block];
+            dUf += partialUf[block];
+        }
+    }
 
-        /* Compute vectors and norm from each vertex to the evaluation position */
-        ri = this->xyzVertex.row(i).transpose() - position_planetFixed;
-        rj = this->xyzVertex.row(j).transpose() - position_planetFixed;
-        rk = this->xyzVertex.row(k).transpose() - position_planetFixed;
-
-        /* Extract normal to facet */
-        nf = this->normalFacet.row(m).transpose();
-
-        /* Loop through each facet edge */
-        for (unsigned int n = 0; n <= 2; n++) {
-            switch (n) {
-            case 0:
-                idx_min = std::min(i, j);
-                r1 = ri;
-                r2 = rj;
-                re = this->xyzVertex.row(idx_min).transpose() - position_planetFixed;
-
-                a = ri.norm();
-                b = rj.norm();
-                break;
-            case 1:
-                idx_min = std::min(j, k);
-                r1 = rj;
-                r2 = rk;
-                re = this->xyzVertex.row(idx_min).transpose() - position_planetFixed;
-
-                a = rj.norm();
-                b = rk.norm();
-                break;
-            case 2:
-                idx_min = std::min(i, k);
-                r1 = rk;
-                r2 = ri;
-                re = this->xyzVertex.row(idx_min).transpose() - position_planetFixed;
-
-                a = rk.norm();
-                b = ri.norm();
-                break;
-            }
+    /* Compute acceleration contribution */
+    return (this->muBody / this->volPoly) * (-dUe + dUf);
+}
 
-            /* Compute along edge vector and norm */
-            r21 = r2 - r1;
-            e = r21.norm();
-            n21 = r21.cross(nf) / r21.cross(nf).norm();
+void PolyhedralGravityModel::addEdgeContributions(const Eigen::Matrix3Xd& relativeVertex,
+                                                  const Eigen::VectorXd& relativeVertexNorm,
+                                                  Eigen::Index firstEdge, Eigen::Index lastEdge,
+                                                  Eigen::Vector3d& dUe) const
+{
+    for (Eigen::Index e = firstEdge; e < lastEdge; e++) {
+        const int i = this->edgeVertex(e, 0);
+        const int j = this->edgeVertex(e, 1);
+        const double a = relativeVertexNorm[i];
+        const double b = relativeVertexNorm[j];
 
-            /* Dimensionless per edge factor */
-            Le = log((a + b + e) / (a + b - e));
+        /* Dimensionless per edge factor */
+        const double Le = log((a + b + this->edgeLength[e]) / (a + b - this->edgeLength[e]));
 
-            /* Compute dyad product */
-            Ee = nf * n21.transpose();
+        /* Add current edge distribution, using the lower index vertex as the edge point */
+        dUe += multiplyDyad(this->edgeDyad, e, relativeVertex.col(i)) * Le;
+    }
+}
 
-            /* Add current facet distribution */
-            dUe += Ee * re * Le;
-        }
+void PolyhedralGravityModel::addFacetContributions(const Eigen::Matrix3Xd& relativeVertex,
+                                                   const Eigen::VectorXd& relativeVertexNorm,
+                                                   Eigen::Index firstFacet, Eigen::Index lastFacet,
+                                                   Eigen::Vector3d& dUf) const
+{
+    for (Eigen::Index f = firstFacet; f < lastFacet; f++) {
+        const int i = this->facetVertex(f, 0);
+        const int j = this->facetVertex(f, 1);
+        const int k = this->facetVertex(f, 2);
+        const auto ri = relativeVertex.col(i);
+        const auto rj = relativeVertex.col(j);
+        const auto rk = relativeVertex.col(k);
+        const double ni = relativeVertexNorm[i];
+        const double nj = relativeVertexNorm[j];
+        const double nk = relativeVertexNorm[k];
 
         /* Compute solid angle for the current facet */
-        wy = ri.transpose() * rj.cross(rk);
-        wx = ri.norm() * rj.norm() * rk.norm() + ri.norm() * rj.transpose() * rk +
-             rj.norm() * rk.transpose() * ri + rk.norm() * ri.transpose() * rj;
-        wf = 2 * atan2(wy, wx);
+        const double wy = ri.dot(rj.cross(rk));
+        const double wx = ni * nj * nk + ni * rj.dot(rk) + nj * rk.dot(ri) + nk * ri.dot(rj);
+        const double wf = 2 * atan2(wy, wx);
 
         /* Add current solid angle facet */
-        dUf += nf * (nf.transpose() * ri) * wf;
+        dUf += multiplyDyad(this->facetDyad, f, ri) * wf;
     }
-
-    /* Compute acceleration contribution */
-    return (this->muBody / this->volPoly) * (-dUe + dUf);
 }
 
 double
@@ -22,12 +22,24 @@
 
 #include "simulation/dynamics/_GeneralModuleFiles/gravityModel.h"
 
+#include <memory>
+#include <mutex>
+
+class ThreadPool;
+
 /** The Polyhedral gravity model.
  *
  * In this class, a polyhedron is defined by its triangular facets.
  * Each facet is defined by three vertices (they are triangles), and
  * each vertex is defined by its position relative to the center of
  * mass of the body.
+ *
+ * Once initialized, computeField only reads the vertex, facet and normal
+ * data, so it can be called concurrently from several threads on the same model.
+ *
+ * The position-independent terms of the model (the edge dyads E_e, the facet
+ * dyads F_f and the list of unique edges) are computed in initializeParameters,
+ * so that computeField only evaluates the per-edge and per-facet factors.
  */
 class PolyhedralGravityModel : public GravityModel {
   public:
@@ -89,9 +101,41 @@ class PolyhedralGravityModel : public GravityModel {
      */
     Eigen::MatrixX3i orderFacet;
 
+    /**
+     * Number of threads used to evaluate the edges and facets in computeField.
+     *
+     * Only shape models with many facets benefit from multiple threads: each thread
+     * is given at least a few thousand facets, so small models are always evaluated
+     * in the calling thread. The threads are created on the first threaded evaluation
+     * and kept for the following ones.
+     */
+    size_t threadCount = 1;
+
   private:
+    /** Adds the edge contributions of edges [firstEdge, lastEdge) to dUe */
+    void addEdgeContributions(const Eigen::Matrix3Xd& relativeVertex,
+                              const Eigen::VectorXd& relativeVertexNorm, Eigen::Index firstEdge,
+                              Eigen::Index lastEdge, Eigen::Vector3d& dUe) const;
+
+    /** Adds the facet contributions of facets [firstFacet, lastFacet) to dUf */
+    void addFacetContributions(const Eigen::Matrix3Xd& relativeVertex,
+                               const Eigen::VectorXd& relativeVertexNorm, Eigen::Index firstFacet,
+                               Eigen::Index lastFacet, Eigen::Vector3d& dUf) const;
+
+    /** Threads reducing the edge and facet blocks, shared by copies of this model */
+    mutable std::shared_ptr<ThreadPool> threadPool;
+    /** Held by the caller using threadPool. Concurrent callers reduce the blocks themselves */
+    mutable std::shared_ptr<std::mutex> threadPoolMutex = std::make_shared<std::mutex>();
+
+  protected:
     double volPoly = 0;  /**< [m^3] Volume of the polyhedral */
     Eigen::MatrixX3d normalFacet;  /**< [-] Normal of a facet */
+
+    Eigen::MatrixX3i facetVertex;  /**< [-] Zero-based vertex indices of each facet */
+    Eigen::Matrix<double, Eigen::Dynamic, 9> facetDyad;  /**< [-] Facet dyad F_f, one column-major 3x3 per row */
+    Eigen::MatrixX2i edgeVertex;   /**< [-] Zero-based (lower, higher) vertex indices of each unique edge */
+    Eigen::VectorXd edgeLength;    /**< [m] Length of each unique edge */
+    Eigen::Matrix<double, Eigen::Dynamic, 9> edgeDyad;  /**< [-] Edge dyad E_e, summed over both facets of the edge */
 };
 
 #endif /* POLY_GRAVITY_MODEL_H */
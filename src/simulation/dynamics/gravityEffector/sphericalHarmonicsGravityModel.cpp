@@ -21,12 +21,46 @@
 #include "architecture/utilities/bskLogging.h"
 #include "simulation/dynamics/_GeneralModuleFiles/gravityEffector.h"
 
+#include <algorithm>
+
 namespace {
 // Computes the term (2 - d_l), where d_l is the kronecker delta.
 inline double getK(const size_t degree)
 {
     return (degree == 0) ? 1.0 : 2.0;
 }
+
+// Number of positions evaluated together by computeFieldBatch. Four doubles fill
+// an AVX register; on targets without AVX, Eigen splits the packet in SSE/NEON registers.
+constexpr Eigen::Index batchWidth = 4;
+using BatchArray = Eigen::Array<double, batchWidth, 1>;
+using BatchArrayVector = std::vector<BatchArray, Eigen::aligned_allocator<BatchArray>>;
+
+// Index of the (degree, order) term in a lower-triangular table stored row by row
+inline size_t triangularIndex(const size_t degree, const size_t order)
+{
+    return degree * (degree + 1) / 2 + order;
+}
+
+// Storage of the position-dependent terms of the Pines recursion. Each thread owns
+// one, which makes computeField reentrant, while the storage is only allocated
+// the first time a thread evaluates a field of a given degree.
+struct PinesScratch {
+    std::vector<double> aBar;    // [-] Eq. 61, lower-triangular table
+    std::vector<double> rE;      // [-] real part of (s + j*t)^m
+    std::vector<double> iM;      // [-] imaginary part of (s + j*t)^m
+    std::vector<double> rhol;    // [-] (radEquator / r)^l * mu / r
+    BatchArrayVector aBarBatch;  // [-] same as above, for a packet of positions
+    BatchArrayVector rEBatch;
+    BatchArrayVector iMBatch;
+    BatchArrayVector rholBatch;
+};
+
+PinesScratch& getPinesScratch()
+{
+    thread_local PinesScratch scratch;
+    return scratch;
+}
 }
 
 std::optional<std::string> SphericalHarmonicsGravityModel::initializeParameters()
@@ -36,14 +70,21 @@ std::optional<std::string> SphericalHarmonicsGravityModel::initializeParameters(
                "provided.";
     }
 
+    // Parameters could have been initialized before (for example, with a different maxDeg)
+    this->aBarDiagonal.clear();
+    this->n1.clear();
+    this->n2.clear();
+    this->nQuot1.clear();
+    this->nQuot2.clear();
+
     for (size_t i = 0; i <= this->maxDeg + 1; i++) {
-        std::vector<double> aRow, n1Row, n2Row;
-        aRow.resize(i + 1, 0.0);
+        std::vector<double> n1Row, n2Row;
         // Diagonal elements of A_bar
-        if (i == 0) { aRow[i] = 1.0; }
+        if (i == 0) { this->aBarDiagonal.push_back(1.0); }
         else {
-            aRow[i] = sqrt(double((2 * i + 1) * getK(i)) / (2 * i * getK(i - 1))) *
-                      this->aBar[i - 1][i - 1];
+            this->aBarDiagonal.push_back(
+                sqrt(double((2 * i + 1) * getK(i)) / (2 * i * getK(i - 1))) *
+                this->aBarDiagonal[i - 1]);
         }
         n1Row.resize(i + 1, 0.0);
         n2Row.resize(i + 1, 0.0);
@@ -56,7 +97,6 @@ std::optional<std::string> SphericalHarmonicsGravityModel::initializeParameters(
         }
         this->n1.push_back(n1Row);
         this->n2.push_back(n2Row);
-        this->aBar.push_back(aRow);
     }
 
     for (size_t l = 0; l <= this->maxDeg; l++) // up to _maxDegree-1
@@ -108,7 +148,12 @@ SphericalHarmonicsGravityModel::computeField(const Eigen::Vector3d& position_pla
     double order;
     double rho;
     double a1, a2, a3, a4, sum_a1, sum_a2, sum_a3, sum_a4;
-    std::vector<double> rE, iM, rhol;
+
+    PinesScratch& scratch = getPinesScratch();
+    std::vector<double>& aBar = scratch.aBar;
+    std::vector<double>& rE = scratch.rE;
+    std::vector<double>& iM = scratch.iM;
+    std::vector<double>& rhol = scratch.rhol;
 
     // Change of variables: direction cosines
     r = sqrt(x * x + y * y + z * z);
@@ -119,32 +164,39 @@ SphericalHarmonicsGravityModel::computeField(const Eigen::Vector3d& position_pla
     // Future work: allow maximum order different than maximum degree
     order = degree;
 
+    aBar.resize(triangularIndex(degree + 2, 0));
+    rE.resize(degree + 2);
+    iM.resize(degree + 2);
+    rhol.resize(degree + 2);
+
+    // Diagonal terms are computed in initializeParameters()
+    aBar[0] = this->aBarDiagonal[0];
     for (size_t l = 1; l <= degree + 1; l++) {
-        // Diagonal terms are computed in initializeParameters()
+        aBar[triangularIndex(l, l)] = this->aBarDiagonal[l];
         //  Low diagonal terms
-        this->aBar[l][l - 1] = sqrt(double((2 * l) * getK(l - 1)) / getK(l)) * this->aBar[l][l] * u;
+        aBar[triangularIndex(l, l - 1)] =
+            sqrt(double((2 * l) * getK(l - 1)) / getK(l)) * this->aBarDiagonal[l] * u;
     }
 
     // Lower terms of A_bar
     for (size_t m = 0; m <= order + 1; m++) {
         for (size_t l = m + 2; l <= degree + 1; l++) {
-            this->aBar[l][m] =
-                u * this->n1[l][m] * this->aBar[l - 1][m] - this->n2[l][m] * this->aBar[l - 2][m];
+            aBar[triangularIndex(l, m)] = u * this->n1[l][m] * aBar[triangularIndex(l - 1, m)] -
+                                          this->n2[l][m] * aBar[triangularIndex(l - 2, m)];
         }
 
-        // Computation of real and imaginary parts of (2+j*t)^m
+        // Computation of real and imaginary parts of (s+j*t)^m
         if (m == 0) {
-            rE.push_back(1.0);
-            iM.push_back(0.0);
+            rE[m] = 1.0;
+            iM[m] = 0.0;
         }
         else {
-            rE.push_back(s * rE[m - 1] - t * iM[m - 1]);
-            iM.push_back(s * iM[m - 1] + t * rE[m - 1]);
+            rE[m] = s * rE[m - 1] - t * iM[m - 1];
+            iM[m] = s * iM[m - 1] + t * rE[m - 1];
         }
     }
 
     rho = radEquator / r;
-    rhol.resize(degree + 2, 0.0);
     rhol[0] = muBody / r;
     rhol[1] = rhol[0] * rho;
 
@@ -183,10 +235,12 @@ SphericalHarmonicsGravityModel::computeField(const Eigen::Vector3d& position_pla
                 F = this->sBar[l][m] * rE[m - 1] - this->cBar[l][m] * iM[m - 1];
             }
 
-            sum_a1 = sum_a1 + m * this->aBar[l][m] * E;
-            sum_a2 = sum_a2 + m * this->aBar[l][m] * F;
-            if (m < l) { sum_a3 = sum_a3 + this->nQuot1[l][m] * this->aBar[l][m + 1] * D; }
-            sum_a4 = sum_a4 + this->nQuot2[l][m] * this->aBar[l + 1][m + 1] * D;
+            sum_a1 = sum_a1 + m * aBar[triangularIndex(l, m)] * E;
+            sum_a2 = sum_a2 + m * aBar[triangularIndex(l, m)] * F;
+            if (m < l) {
+                sum_a3 = sum_a3 + this->nQuot1[l][m] * aBar[triangularIndex(l, m + 1)] * D;
+            }
+            sum_a4 = sum_a4 + this->nQuot2[l][m] * aBar[triangularIndex(l + 1, m + 1)] * D;
         }
 
         a1 = a1 + rhol[l + 1] / radEquator * sum_a1;
@@ -198,6 +252,123 @@ SphericalHarmonicsGravityModel::computeField(const Eigen::Vector3d& position_pla
     return {a1 + s * a4, a2 + t * a4, a3 + u * a4};
 }
 
+void SphericalHarmonicsGravityModel::computeFieldBatch(const Eigen::Matrix3Xd& positions_planetFixed,
+                                                       Eigen::Matrix3Xd& accelerations_planetFixed) const
+{
+    const size_t degree = this->maxDeg;
+    const size_t order = degree;
+    const Eigen::Index numberPositions = positions_planetFixed.cols();
+    accelerations_planetFixed.resize(3, numberPositions);
+
+    // Storage of the recursion for one packet of positions, reused for every packet
+    PinesScratch& scratch = getPinesScratch();
+    BatchArrayVector& aBarBatch = scratch.aBarBatch;
+    BatchArrayVector& rE = scratch.rEBatch;
+    BatchArrayVector& iM = scratch.iMBatch;
+    BatchArrayVector& rhol = scratch.rholBatch;
+    aBarBatch.resize(triangularIndex(degree + 2, 0));
+    rE.resize(order + 2);
+    iM.resize(order + 2);
+    rhol.resize(degree + 2);
+
+    for (Eigen::Index first = 0; first < numberPositions; first += batchWidth) {
+        const Eigen::Index width = std::min(batchWidth, numberPositions - first);
+
+        // Lanes past the last position repeat it, so that they stay finite
+        BatchArray x, y, z;
+        for (Eigen::Index lane = 0; lane < batchWidth; lane++) {
+            const Eigen::Index column = first + std::min(lane, width - 1);
+            x[lane] = positions_planetFixed(0, column);
+            y[lane] = positions_planetFixed(1, column);
+            z[lane] = positions_planetFixed(2, column);
+        }
+
+        // Change of variables: direction cosines
+        const BatchArray r = (x * x + y * y + z * z).sqrt();
+        const BatchArray s = x / r;
+        const BatchArray t = y / r;
+        const BatchArray u = z / r;
+
+        // Diagonal terms do not depend on the position, low diagonal terms do
+        aBarBatch[0].setConstant(this->aBarDiagonal[0]);
+        for (size_t l = 1; l <= degree + 1; l++) {
+            aBarBatch[triangularIndex(l, l)].setConstant(this->aBarDiagonal[l]);
+            aBarBatch[triangularIndex(l, l - 1)] =
+                sqrt(double((2 * l) * getK(l - 1)) / getK(l)) * this->aBarDiagonal[l] * u;
+        }
+
+        // Lower terms of A_bar
+        for (size_t m = 0; m <= order + 1; m++) {
+            for (size_t l = m + 2; l <= degree + 1; l++) {
+                aBarBatch[triangularIndex(l, m)] =
+                    u * this->n1[l][m] * aBarBatch[triangularIndex(l - 1, m)] -
+                    this->n2[l][m] * aBarBatch[triangularIndex(l - 2, m)];
+            }
+
+            // Computation of real and imaginary parts of (s+j*t)^m
+            if (m == 0) {
+                rE[m].setOnes();
+                iM[m].setZero();
+            }
+            else {
+                rE[m] = s * rE[m - 1] - t * iM[m - 1];
+                iM[m] = s * iM[m - 1] + t * rE[m - 1];
+            }
+        }
+
+        const BatchArray rho = this->radEquator / r;
+        rhol[0] = this->muBody / r;
+        rhol[1] = rhol[0] * rho;
+
+        // Gravity field of degree l = 0
+        BatchArray a1 = BatchArray::Zero();
+        BatchArray a2 = BatchArray::Zero();
+        BatchArray a3 = BatchArray::Zero();
+        BatchArray a4 = -rhol[1] / this->radEquator;
+
+        for (size_t l = 1; l <= degree; l++) {
+            rhol[l + 1] = rho * rhol[l];
+
+            BatchArray sum_a1 = BatchArray::Zero();
+            BatchArray sum_a2 = BatchArray::Zero();
+            BatchArray sum_a3 = BatchArray::Zero();
+            BatchArray sum_a4 = BatchArray::Zero();
+
+            for (size_t m = 0; m <= l; m++) {
+                const double cBarLM = this->cBar[l][m];
+                const double sBarLM = this->sBar[l][m];
+                const BatchArray D = cBarLM * rE[m] + sBarLM * iM[m];
+
+                // E and F are zero for m = 0
+                if (m > 0) {
+                    const BatchArray E = cBarLM * rE[m - 1] + sBarLM * iM[m - 1];
+                    const BatchArray F = sBarLM * rE[m - 1] - cBarLM * iM[m - 1];
+                    sum_a1 += double(m) * aBarBatch[triangularIndex(l, m)] * E;
+                    sum_a2 += double(m) * aBarBatch[triangularIndex(l, m)] * F;
+                }
+                if (m < l) {
+                    sum_a3 += this->nQuot1[l][m] * aBarBatch[triangularIndex(l, m + 1)] * D;
+                }
+                sum_a4 += this->nQuot2[l][m] * aBarBatch[triangularIndex(l + 1, m + 1)] * D;
+            }
+
+            a1 += rhol[l + 1] / this->radEquator * sum_a1;
+            a2 += rhol[l + 1] / this->radEquator * sum_a2;
+            a3 += rhol[l + 1] / this->radEquator * sum_a3;
+            a4 -= rhol[l + 1] / this->radEquator * sum_a4;
+        }
+
+        const BatchArray gx = a1 + s * a4;
+        const BatchArray gy = a2 + t * a4;
+        const BatchArray gz = a3 + u * a4;
+        for (Eigen::Index lane = 0; lane < width; lane++) {
+            accelerations_planetFixed(0, first + lane) = gx[lane];
+            accelerations_planetFixed(1, first + lane) = gy[lane];
+            accelerations_planetFixed(2, first + lane) = gz[lane];
+        }
+    }
+}
+
 double SphericalHarmonicsGravityModel::computePotentialEnergy(
     const Eigen::Vector3d& positionWrtPlanet_N) const
 {
@@ -27,6 +27,9 @@
 
 /**
  * The Spherical Harmonics gravity model
+ *
+ * Once initialized, computeField and computeFieldBatch are reentrant: they can be
+ * called concurrently from several threads on the same model.
  */
 class SphericalHarmonicsGravityModel : public GravityModel {
   public:
@@ -72,6 +75,18 @@ class SphericalHarmonicsGravityModel : public GravityModel {
     Eigen::Vector3d computeField(const Eigen::Vector3d& position_planetFixed, size_t degree,
                                  bool include_zero_degree) const;
 
+    /** Returns the gravity acceleration at several positions around this body.
+     *
+     * Positions and accelerations are stored one per column, in the body-fixed
+     * reference frame. All degrees up to `maxDeg` are used.
+     *
+     * The Pines recursion is evaluated for a packet of positions at a time, so that
+     * the recursion coefficients are loaded once per packet and every operation is
+     * a SIMD operation on Eigen packets.
+     */
+    void computeFieldBatch(const Eigen::Matrix3Xd& positions_planetFixed,
+                           Eigen::Matrix3Xd& accelerations_planetFixed) const override;
+
     /** Returns the gravitational potential energy at a position around this body.
      *
      * The current implementation returns the potential energy of a point-mass
@@ -106,8 +121,11 @@ class SphericalHarmonicsGravityModel : public GravityModel {
      *
      * They are coefficients used in the method of Pines for the gravity due to SH.
      * For their definition, see the 'Basilisk-GravityEffector' documentation.
+     *
+     * They only depend on the degree, so they are not modified after initializeParameters.
+     * The position-dependent terms of the recursion are kept in thread-local storage.
      */
-    mutable std::vector<std::vector<double>> aBar;  /**< [-] Eq. 61 */
+    std::vector<double> aBarDiagonal;               /**< [-] Diagonal of Eq. 61 */
     std::vector<std::vector<double>> n1;            /**< [-] Eq. 63 */
     std::vector<std::vector<double>> n2;            /**< [-] Eq. 64 */
     std::vector<std::vector<double>> nQuot1;        /**< [-] Eq. 79 */
@@ -52,6 +52,9 @@
 %naturalvar SphericalHarmonicsGravityModel::cBar;
 %naturalvar SphericalHarmonicsGravityModel::sBar;
 
+// Exposed to Python through the GravityModel.computeFieldBatch wrapper
+%ignore SphericalHarmonicsGravityModel::computeFieldBatch(const Eigen::Matrix3Xd&, Eigen::Matrix3Xd&) const;
+
 %include "simulation/dynamics/gravityEffector/sphericalHarmonicsGravityModel.h"
 
 %extend SphericalHarmonicsGravityModel {
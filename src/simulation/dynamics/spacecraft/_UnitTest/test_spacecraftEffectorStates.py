@@ -0,0 +1,106 @@
+# ISC License
+#
+# Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+import numpy as np
+from Basilisk.simulation import hingedRigidBodyStateEffector
+from Basilisk.simulation import linearSpringMassDamper
+from Basilisk.simulation import spacecraft
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import simIncludeGravBody
+
+
+def test_spacecraftEffectorStates():
+    r"""
+    **Validation Test Description**
+
+    A tumbling spacecraft in Earth orbit, with a damped hinged panel and a damped spring mass particle attached, is
+    propagated for 10 seconds with 0.01 second steps.  The truth values were computed before the spacecraft cached
+    the hub attitude kinematics once per evaluation of the equations of motion.
+
+    **Description of Variables Being Tested**
+
+    The hub position, velocity, attitude and angular velocity, the panel angle and rate, and the particle offset and
+    rate must match the truth values to a relative accuracy of 1e-10.
+    """
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(0.01)))
+
+    scObject = spacecraft.Spacecraft()
+    scObject.ModelTag = "spacecraft"
+    scObject.hub.mHub = 750.0
+    scObject.hub.r_BcB_B = [[0.0], [0.0], [1.0]]
+    scObject.hub.IHubPntBc_B = [[900.0, 0.0, 0.0], [0.0, 800.0, 0.0], [0.0, 0.0, 600.0]]
+    scObject.hub.r_CN_NInit = [[-4020338.690396649], [7490566.741852513], [5248299.211589362]]
+    scObject.hub.v_CN_NInit = [[-5199.77710904224], [-3436.681645356935], [1041.576797498721]]
+    scObject.hub.sigma_BNInit = [[0.1], [0.2], [-0.3]]
+    scObject.hub.omega_BN_BInit = [[0.05], [-0.04], [0.03]]
+
+    panel = hingedRigidBodyStateEffector.HingedRigidBodyStateEffector()
+    panel.ModelTag = "panel"
+    panel.mass = 100.0
+    panel.IPntS_S = [[100.0, 0.0, 0.0], [0.0, 50.0, 0.0], [0.0, 0.0, 50.0]]
+    panel.d = 1.5
+    panel.k = 100.0
+    panel.c = 5.0
+    panel.r_HB_B = [[0.5], [0.0], [1.0]]
+    panel.dcm_HB = [[-1.0, 0.0, 0.0], [0.0, -1.0, 0.0], [0.0, 0.0, 1.0]]
+    panel.thetaInit = 5 * np.pi / 180.0
+    panel.thetaDotInit = 0.0
+    scObject.addStateEffector(panel)
+
+    particle = linearSpringMassDamper.LinearSpringMassDamper()
+    particle.k = 100.0
+    particle.c = 2.0
+    particle.r_PB_B = [[0.1], [0.0], [-0.1]]
+    particle.pHat_B = [[np.sqrt(3) / 3], [np.sqrt(3) / 3], [np.sqrt(3) / 3]]
+    particle.rhoInit = 0.05
+    particle.rhoDotInit = 0.0
+    particle.massInit = 10.0
+    scObject.addStateEffector(particle)
+
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createCustomGravObject("earth", 0.3986004415E+15)
+    earth.isCentralBody = True
+    gravFactory.addBodiesTo(scObject)
+
+    scSim.AddModelToTask("simTask", scObject)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(10.))
+    scSim.ExecuteSimulation()
+
+    scStates = scObject.scStateOutMsg.read()
+    np.testing.assert_allclose(scStates.r_BN_N,
+                               [-4.0722556415078952e+06, 7.4560511376137370e+06, 5.2586092799932892e+06], rtol=1e-10)
+    np.testing.assert_allclose(scStates.v_BN_N,
+                               [-5.1835442518875607e+03, -3.4665797050244805e+03, 1.0205786312693957e+03], rtol=1e-10)
+    np.testing.assert_allclose(scStates.sigma_BN,
+                               [1.5792359529726610e-01, 1.1858022204254281e-02, -2.7534470712505421e-01], rtol=1e-10)
+    np.testing.assert_allclose(scStates.omega_BN_B,
+                               [4.7742108569093354e-02, -5.5742126057634359e-02, 3.2031859884716254e-02], rtol=1e-10)
+
+    def finalState(name):
+        return scObject.dynManager.getStateObject(name).getState()[0][0]
+
+    np.testing.assert_allclose(finalState(panel.nameOfThetaState), 7.3102237130474581e-03, rtol=1e-10)
+    np.testing.assert_allclose(finalState(panel.nameOfThetaDotState), -5.9775819856527329e-02, rtol=1e-10)
+    np.testing.assert_allclose(finalState(particle.nameOfRhoState), 1.5827278467727156e-02, rtol=1e-10)
+    np.testing.assert_allclose(finalState(particle.nameOfRhoDotState), -2.9296475355652139e-02, rtol=1e-10)
+
+
+if __name__ == "__main__":
+    test_spacecraftEffectorStates()
@@ -0,0 +1,82 @@
+# ISC License
+#
+# Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+import numpy as np
+from Basilisk.simulation import spacecraft
+from Basilisk.utilities import RigidBodyKinematics as rbk
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import simIncludeGravBody
+
+
+def propagateTumblingSpacecraft(stepSeconds, rotationalSubsteps):
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(stepSeconds)))
+
+    scObject = spacecraft.Spacecraft()
+    scObject.ModelTag = "spacecraft"
+    scObject.hub.mHub = 100.0
+    scObject.hub.r_BcB_B = [[0.1], [0.05], [-0.02]]
+    scObject.hub.IHubPntBc_B = [[10.0, 0.0, 0.0], [0.0, 15.0, 0.0], [0.0, 0.0, 20.0]]
+    scObject.hub.r_CN_NInit = [[7000. * 1000], [0.], [1000. * 1000]]
+    scObject.hub.v_CN_NInit = [[0.], [7.3 * 1000], [1000.]]
+    scObject.hub.sigma_BNInit = [[0.1], [0.2], [-0.3]]
+    scObject.hub.omega_BN_BInit = [[0.3], [-0.2], [0.4]]
+    scObject.rotationalSubsteps = rotationalSubsteps
+    scSim.AddModelToTask("simTask", scObject)
+
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createEarth()
+    earth.isCentralBody = True
+    gravFactory.addBodiesTo(scObject)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(600.))
+    scSim.ExecuteSimulation()
+
+    return scObject.scStateOutMsg.read()
+
+
+def test_spacecraftMultiRate():
+    r"""
+    **Validation Test Description**
+
+    A tumbling spacecraft whose center of mass is offset from point B is propagated in low Earth orbit for ten
+    minutes, with 10 second steps whose rotational states are sub-cycled with 100 steps, and compared with the same
+    spacecraft propagated with 0.1 second steps without sub-cycling.
+
+    **Description of Variables Being Tested**
+
+    With the same rotational step, the final position of point B must match the reference within a centimeter and
+    the attitude and angular velocity within 1e-4.  Without sub-cycling, 10 second steps cannot follow the tumble.
+    """
+    reference = propagateTumblingSpacecraft(0.1, 0)
+    multiRate = propagateTumblingSpacecraft(10., 100)
+
+    np.testing.assert_allclose(multiRate.r_BN_N, reference.r_BN_N, atol=1e-2)
+    np.testing.assert_allclose(multiRate.v_BN_N, reference.v_BN_N, atol=1e-4)
+    np.testing.assert_allclose(multiRate.omega_BN_B, reference.omega_BN_B, atol=1e-4)
+    attitudeError = rbk.subMRP(np.array(multiRate.sigma_BN), np.array(reference.sigma_BN))
+    assert np.linalg.norm(attitudeError) < 1e-4
+
+    coupled = propagateTumblingSpacecraft(10., 0)
+    attitudeError = rbk.subMRP(np.array(coupled.sigma_BN), np.array(reference.sigma_BN))
+    assert np.linalg.norm(attitudeError) > 1e-2
+
+
+if __name__ == "__main__":
+    test_spacecraftMultiRate()
@@ -22,6 +22,7 @@
 #include "../_GeneralModuleFiles/svIntegratorRK4.h"
 #include "architecture/utilities/avsEigenSupport.h"
 #include "architecture/utilities/avsEigenMRP.h"
+#include <algorithm>
 #include <iostream>
 
 
@@ -38,6 +39,10 @@ Spacecraft::Spacecraft()
     this->dvAccum_CN_B.setZero();
     this->dvAccum_BN_B.setZero();
     this->dvAccum_CN_N.setZero();
+    this->rotationalSubsteps = 0;
+    this->integrationPhase = IntegrationPhase::Coupled;
+    this->rotationalGravityCurrent = false;
+    this->lastStepMultiRate = false;
 
     // - Set integrator as RK4 by default
     this->integrator = new svIntegratorRK4(this);
@@ -58,6 +63,15 @@ void Spacecraft::Reset(uint64_t CurrentSimNanos)
     // - Call method for initializing the dynamics of spacecraft
     this->initializeDynamics();
 
+    if (this->rotationalSubsteps > 0 && !this->canIntegrateMultiRate()) {
+        bskLogger.bskLog(BSK_WARNING, "The rotational states of a spacecraft whose integration is synced with other "
+                                      "dynamic objects cannot be sub-cycled, all states are integrated together.");
+    } else if (this->rotationalSubsteps % 2 == 1) {
+        bskLogger.bskLog(BSK_WARNING, "rotationalSubsteps is odd, the rotational states are integrated with %u steps "
+                                      "per task step so that both halves of the step take the same number of steps.",
+                         this->rotationalSubsteps + 1);
+    }
+
     // compute initial spacecraft states relative to inertial frame, taking into account initial sc states might be defined relative to a planet
     this->gravField.updateInertialPosAndVel(this->hubR_N->getState(), this->hubV_N->getState());
     this->writeOutputStateMessages(CurrentSimNanos);
@@ -90,15 +104,14 @@ void Spacecraft::writeOutputStateMessages(uint64_t clockTime)
     stateOut = this->scStateOutMsg.zeroMsgPayload;
     eigenMatrixXd2CArray(*this->inertialPositionProperty, stateOut.r_BN_N);
     eigenMatrixXd2CArray(*this->inertialVelocityProperty, stateOut.v_BN_N);
-    Eigen::MRPd sigmaLocal_BN;
-    sigmaLocal_BN = (Eigen::Vector3d) this->hubSigma->getState();
-    Eigen::Matrix3d dcm_NB = sigmaLocal_BN.toRotationMatrix();
+    this->kinematics.update(this->hubSigma->getState(), this->hubOmega_BN_B->getState());
+    const Eigen::Matrix3d& dcm_NB = this->kinematics.dcm_NB;
     Eigen::Vector3d rLocal_CN_N = (*this->inertialPositionProperty) + dcm_NB*(*this->c_B);
     Eigen::Vector3d vLocal_CN_N = (*this->inertialVelocityProperty) + dcm_NB*(*this->cDot_B);
     eigenVector3d2CArray(rLocal_CN_N, stateOut.r_CN_N);
     eigenVector3d2CArray(vLocal_CN_N, stateOut.v_CN_N);
-    eigenMatrixXd2CArray(this->hubSigma->getState(), stateOut.sigma_BN);
-    eigenMatrixXd2CArray(this->hubOmega_BN_B->getState(), stateOut.omega_BN_B);
+    eigenVector3d2CArray(this->kinematics.sigma_BN, stateOut.sigma_BN);
+    eigenVector3d2CArray(this->kinematics.omega_BN_B, stateOut.omega_BN_B);
     eigenMatrixXd2CArray(this->dvAccum_CN_B, stateOut.TotalAccumDVBdy);
     stateOut.MRPSwitchCount = this->hub.MRPSwitchCount;
     eigenMatrixXd2CArray(this->dvAccum_BN_B, stateOut.TotalAccumDV_BN_B);
@@ -116,6 +129,63 @@ void Spacecraft::writeOutputStateMessages(uint64_t clockTime)
     this->scMassOutMsg.write(&massStateOut, this->moduleID, clockTime);
 }
 
+/*! This method interpolates the hub states at a time within the last integration step, using the dense output
+ of the integrator (see StateVecIntegrator::setDenseOutput).  It lets modules running at a higher rate than the
+ dynamics task sample the states in between integration steps.  The position, velocity, attitude and angular
+ rate are interpolated, the other fields are those written at the end of the last step.
+ @param simTimeNanos [ns] Time within the last integration step
+ @param stateOut Set to the interpolated states if true is returned
+ @return bool True if the states could be interpolated
+ */
+bool Spacecraft::interpolateStates(uint64_t simTimeNanos, SCStatesMsgPayload& stateOut)
+{
+    // - The last call to the integrator only integrated the rotational states of a multi-rate step
+    if (this->lastStepMultiRate) {
+        return false;
+    }
+
+    StateVecIntegrator* activeIntegrator = this->getActiveIntegrator();
+    double time = simTimeNanos*NANO2SEC;
+    Eigen::MatrixXd rLocal_BF_N, vLocal_BF_N, sigmaLocal_BN, omegaLocal_BN_B;
+    if (!activeIntegrator
+        || !activeIntegrator->getInterpolatedState(*this, this->hubR_N->getName(), time, rLocal_BF_N)
+        || !activeIntegrator->getInterpolatedState(*this, this->hubV_N->getName(), time, vLocal_BF_N)
+        || !activeIntegrator->getInterpolatedState(*this, this->hubSigma->getName(), time, sigmaLocal_BN)
+        || !activeIntegrator->getInterpolatedState(*this, this->hubOmega_BN_B->getName(), time, omegaLocal_BN_B)) {
+        return false;
+    }
+
+    // - The states at the end of the step are interpolated before the MRP switch of postIntegration
+    Eigen::Vector3d sigma_BN = sigmaLocal_BN;
+    if (sigma_BN.squaredNorm() > 1.0) {
+        sigma_BN = -sigma_BN/sigma_BN.squaredNorm();
+    }
+
+    Eigen::Vector3d rLocal_BN_N;
+    Eigen::Vector3d vLocal_BN_N;
+    this->gravField.computeInertialPosAndVel(rLocal_BF_N, vLocal_BF_N, simTimeNanos, rLocal_BN_N, vLocal_BN_N);
+    Eigen::MRPd sigmaMRP_BN;
+    sigmaMRP_BN = sigma_BN;
+    Eigen::Matrix3d dcm_NB = sigmaMRP_BN.toRotationMatrix();
+    Eigen::Vector3d rLocal_CN_N = rLocal_BN_N + dcm_NB*(*this->c_B);
+    Eigen::Vector3d vLocal_CN_N = vLocal_BN_N + dcm_NB*(*this->cDot_B);
+
+    stateOut = this->scStateOutMsg.zeroMsgPayload;
+    eigenVector3d2CArray(rLocal_BN_N, stateOut.r_BN_N);
+    eigenVector3d2CArray(vLocal_BN_N, stateOut.v_BN_N);
+    eigenVector3d2CArray(rLocal_CN_N, stateOut.r_CN_N);
+    eigenVector3d2CArray(vLocal_CN_N, stateOut.v_CN_N);
+    eigenVector3d2CArray(sigma_BN, stateOut.sigma_BN);
+    eigenMatrixXd2CArray(omegaLocal_BN_B, stateOut.omega_BN_B);
+    eigenMatrixXd2CArray(this->dvAccum_CN_B, stateOut.TotalAccumDVBdy);
+    stateOut.MRPSwitchCount = this->hub.MRPSwitchCount;
+    eigenMatrixXd2CArray(this->dvAccum_BN_B, stateOut.TotalAccumDV_BN_B);
+    eigenMatrixXd2CArray(this->dvAccum_CN_N, stateOut.TotalAccumDV_CN_N);
+    eigenVector3d2CArray(this->nonConservativeAccelpntB_B, stateOut.nonConservativeAccelpntB_B);
+    eigenVector3d2CArray(this->omegaDot_BN_B, stateOut.omegaDot_BN_B);
+    return true;
+}
+
 /*! If the optional attitude reference input message is set, then read in the reference attitude and set it for the hub*/
 void Spacecraft::readOptionalRefMsg()
 {
@@ -156,7 +226,12 @@ void Spacecraft::UpdateState(uint64_t CurrentSimNanos)
     this->gravField.UpdateState(CurrentSimNanos);
 
     // - Integrate the state forward in time
-    this->integrateState(newTime);
+    this->lastStepMultiRate = this->rotationalSubsteps > 0 && newTime > this->timePrevious && this->canIntegrateMultiRate();
+    if (this->lastStepMultiRate) {
+        this->integrateStateMultiRate(newTime);
+    } else {
+        this->integrateState(newTime);
+    }
 
     // If set, read in and prescribe attitude reference motion
     readOptionalRefMsg();
@@ -269,6 +344,16 @@ void Spacecraft::initializeDynamics()
         (*dynIt)->linkInStates(this->dynManager);
     }
 
+    // - Sort the states for the multi-rate integration, the gravity velocities follow the hub velocity
+    this->translationalStates = {this->hubR_N, this->hubV_N, this->hubGravVelocity, this->BcGravVelocity};
+    this->rotationalStates.clear();
+    for (auto& state : this->dynManager.stateContainer.stateMap) {
+        if (std::find(this->translationalStates.begin(), this->translationalStates.end(), &state.second)
+            == this->translationalStates.end()) {
+            this->rotationalStates.push_back(&state.second);
+        }
+    }
+
     // If set, read in and prescribe attitude reference motion as initial states
     readOptionalRefMsg();
 
@@ -342,18 +427,20 @@ void Spacecraft::equationsOfMotion(double integTimeSeconds, double timeStep)
     // - Update the mass properties of the spacecraft
     this->updateSCMassProps(integTimeSeconds);
 
-    // - This is where gravity is computed (gravity needs to know c_B to calculated gravity about r_CN_N)
-    Eigen::MRPd sigmaBNLoc;
-    Eigen::Matrix3d dcm_NB;
-    Eigen::Vector3d cLocal_N;
+    // - The attitude kinematics are computed once and shared by the rest of the evaluation
+    this->kinematics.update(this->hubSigma->getStateAs<Eigen::Vector3d>(),
+                            this->hubOmega_BN_B->getStateAs<Eigen::Vector3d>());
+    const Eigen::Matrix3d& dcm_NB = this->kinematics.dcm_NB;
 
-    sigmaBNLoc = (Eigen::Vector3d) this->hubSigma->getState();
-    dcm_NB = sigmaBNLoc.toRotationMatrix();
-    cLocal_N = dcm_NB*(*this->c_B);
-    Eigen::Vector3d rLocal_CN_N = this->hubR_N->getState() + dcm_NB*(*this->c_B);
-    Eigen::Vector3d vLocal_CN_N = this->hubV_N->getState() + dcm_NB*(*this->cDot_B);
+    // - This is where gravity is computed (gravity needs to know c_B to calculated gravity about r_CN_N)
+    Eigen::Vector3d rLocal_CN_N = this->hubR_N->getStateAs<Eigen::Vector3d>() + dcm_NB*(*this->c_B);
+    Eigen::Vector3d vLocal_CN_N = this->hubV_N->getStateAs<Eigen::Vector3d>() + dcm_NB*(*this->cDot_B);
 
-    this->gravField.computeGravityField(rLocal_CN_N, vLocal_CN_N);
+    // - The translational states are frozen during the rotational phase, so the field is only computed once
+    if (this->integrationPhase != IntegrationPhase::Rotational || !this->rotationalGravityCurrent) {
+        this->gravField.computeGravityField(rLocal_CN_N, vLocal_CN_N);
+        this->rotationalGravityCurrent = this->integrationPhase == IntegrationPhase::Rotational;
+    }
 
     // - Loop through dynEffectors to compute force and torque on the s/c
     std::vector<DynamicEffector*>::iterator dynIt;
@@ -366,6 +453,21 @@ void Spacecraft::equationsOfMotion(double integTimeSeconds, double timeStep)
         this->sumTorquePntB_B += (*dynIt)->torqueExternalPntB_B;
     }
 
+    // - In the translational phase of a multi-rate step, the center of mass moves under gravity and the external
+    // forces while point B keeps its frozen offset from it, so the back-substitution is not needed
+    if (this->integrationPhase == IntegrationPhase::Translational) {
+        Eigen::Vector3d gLocal_N = *this->g_N;
+        Eigen::Vector3d rDDotLocal_CN_N = gLocal_N + (this->sumForceExternal_N + dcm_NB*this->sumForceExternal_B)/(*this->m_SC)(0,0);
+        this->hubR_N->setDerivative(vLocal_CN_N);
+        this->hubV_N->setDerivative(rDDotLocal_CN_N);
+        this->hubGravVelocity->setDerivative(gLocal_N);
+        this->BcGravVelocity->setDerivative(gLocal_N);
+        for (auto state : this->rotationalStates) {
+            state->stateDeriv.setZero();
+        }
+        return;
+    }
+
     // - Loop through state effectors to get contributions for back-substitution
     std::vector<StateEffector*>::iterator it;
     for(it = this->states.begin(); it != this->states.end(); it++)
@@ -380,7 +482,7 @@ void Spacecraft::equationsOfMotion(double integTimeSeconds, double timeStep)
         this->backSubContributions.vecRot.setZero();
 
         // - Call the update contributions method for the stateEffectors and add in contributions to the hub matrices
-        (*it)->updateContributions(integTimeSeconds, this->backSubContributions, this->hubSigma->getState(), this->hubOmega_BN_B->getState(), *this->g_N);
+        (*it)->updateContributions(integTimeSeconds, this->backSubContributions, this->kinematics.sigma_BN, this->kinematics.omega_BN_B, *this->g_N);
         this->hub.hubBackSubMatrices.matrixA += this->backSubContributions.matrixA;
         this->hub.hubBackSubMatrices.matrixB += this->backSubContributions.matrixB;
         this->hub.hubBackSubMatrices.matrixC += this->backSubContributions.matrixC;
@@ -397,7 +499,7 @@ void Spacecraft::equationsOfMotion(double integTimeSeconds, double timeStep)
 
     Eigen::Matrix3d intermediateMatrix;
     Eigen::Vector3d intermediateVector;
-    Eigen::Vector3d omegaLocalBN_B = this->hubOmega_BN_B->getState();
+    const Eigen::Vector3d& omegaLocalBN_B = this->kinematics.omega_BN_B;
     this->hub.hubBackSubMatrices.matrixA += (*this->m_SC)(0,0)*intermediateMatrix.Identity();
     intermediateMatrix = eigenTilde((*this->c_B));  // make c_B skew symmetric matrix
     this->hub.hubBackSubMatrices.matrixB += -(*this->m_SC)(0,0)*intermediateMatrix;
@@ -406,12 +508,15 @@ void Spacecraft::equationsOfMotion(double integTimeSeconds, double timeStep)
     this->hub.hubBackSubMatrices.vecTrans += -2.0*(*this->m_SC)(0, 0)*omegaLocalBN_B.cross(cPrimeLocal_B)
     - (*this->m_SC)(0, 0)*omegaLocalBN_B.cross(omegaLocalBN_B.cross(cLocal_B))
     - 2.0*(*mDot_SC)(0,0)*(cPrimeLocal_B+omegaLocalBN_B.cross(cLocal_B));
-    intermediateVector = *ISCPntB_B*omegaLocalBN_B;
-    this->hub.hubBackSubMatrices.vecRot += -omegaLocalBN_B.cross(intermediateVector) - *ISCPntBPrime_B*omegaLocalBN_B;
+    // - Fixed-size copies of the inertia properties keep the products off the heap
+    Eigen::Matrix3d ISCLocalPntB_B = *this->ISCPntB_B;
+    Eigen::Matrix3d ISCLocalPrimePntB_B = *this->ISCPntBPrime_B;
+    intermediateVector = ISCLocalPntB_B*omegaLocalBN_B;
+    this->hub.hubBackSubMatrices.vecRot += -omegaLocalBN_B.cross(intermediateVector) - ISCLocalPrimePntB_B*omegaLocalBN_B;
 
     // - Map external force_N to the body frame
     Eigen::Vector3d sumForceExternalMappedToB;
-    sumForceExternalMappedToB = dcm_NB.transpose()*this->sumForceExternal_N;
+    sumForceExternalMappedToB = this->kinematics.dcm_BN*this->sumForceExternal_N;
 
     // - Edit both v_trans and v_rot with gravity and external force and torque
     Eigen::Vector3d gLocal_N = *this->g_N;
@@ -423,18 +528,94 @@ void Spacecraft::equationsOfMotion(double integTimeSeconds, double timeStep)
     gravityForce_N = (*this->m_SC)(0,0)*gLocal_N;
 
     Eigen::Vector3d gravityForce_B;
-    gravityForce_B = dcm_NB.transpose()*gravityForce_N;
+    gravityForce_B = this->kinematics.dcm_BN*gravityForce_N;
     this->hub.hubBackSubMatrices.vecTrans += gravityForce_B + sumForceExternalMappedToB + this->sumForceExternal_B;
     this->hub.hubBackSubMatrices.vecRot += cLocal_B.cross(gravityForce_B) + this->sumTorquePntB_B;
 
     // - Compute the derivatives of the hub states before looping through stateEffectors
-    this->hub.computeDerivatives(integTimeSeconds, this->hubV_N->getStateDeriv(), this->hubOmega_BN_B->getStateDeriv(), this->hubSigma->getState());
+    this->hub.computeDerivatives(integTimeSeconds, this->hubV_N->getStateDerivAs<Eigen::Vector3d>(),
+                                 this->hubOmega_BN_B->getStateDerivAs<Eigen::Vector3d>(), this->kinematics.sigma_BN);
 
     // - Loop through state effectors for compute derivatives
     for(it = states.begin(); it != states.end(); it++)
     {
-        (*it)->computeDerivatives(integTimeSeconds, this->hubV_N->getStateDeriv(), this->hubOmega_BN_B->getStateDeriv(), this->hubSigma->getState());
+        (*it)->computeDerivatives(integTimeSeconds, this->hubV_N->getStateDerivAs<Eigen::Vector3d>(),
+                                  this->hubOmega_BN_B->getStateDerivAs<Eigen::Vector3d>(), this->kinematics.sigma_BN);
+    }
+
+    // - Freeze the translational states in the rotational phase of a multi-rate step
+    if (this->integrationPhase == IntegrationPhase::Rotational) {
+        for (auto state : this->translationalStates) {
+            state->stateDeriv.setZero();
+        }
+    }
+}
+
+/*! Returns true if the rotational states can be sub-cycled, which requires the integrator to only integrate this
+ spacecraft
+ @return bool True if multi-rate integration is possible
+ */
+bool Spacecraft::canIntegrateMultiRate() const
+{
+    return !this->isDynamicsSynced && this->integrator && this->integrator->dynPtrs.size() == 1;
+}
+
+/*! This method integrates the rotational and state effector states with rotationalSubsteps steps for each step of the
+ translational states, using a symmetric (Strang) splitting: the rotational states are integrated over the first half of
+ the step with the center of mass frozen, then the center of mass over the whole step with the rotational states frozen
+ at their mid-step value, and finally the rotational states over the second half of the step.  Point B keeps its offset
+ from the center of mass while the center of mass moves, and follows the rotation while it is frozen.  The gravity field
+ is only computed by the translational step, and once at the start of each rotational half step.
+ @param integrateToThisTime [s] Time to integrate to
+ */
+void Spacecraft::integrateStateMultiRate(double integrateToThisTime)
+{
+    this->preIntegration(integrateToThisTime);
+
+    // - Each half of the step takes the same number of rotational steps, so an odd count is rounded up to even
+    uint32_t halfSubsteps = (this->rotationalSubsteps + 1)/2;
+    double halfStep = this->timeStep/2.0;
+
+    this->integrateRotationalStates(this->timeBefore, halfStep, halfSubsteps);
+
+    this->integrationPhase = IntegrationPhase::Translational;
+    this->integrator->integrate(this->timeBefore, this->timeStep);
+
+    this->integrateRotationalStates(this->timeBefore + halfStep, halfStep, halfSubsteps);
+
+    this->integrationPhase = IntegrationPhase::Coupled;
+    this->postIntegration(integrateToThisTime);
+}
+
+/*! This method integrates the rotational and state effector states with the center of mass frozen, and then moves
+ point B to its new offset from the center of mass
+ @param startTime [s] Time at the start of the rotational phase
+ @param duration [s] Duration of the rotational phase
+ @param steps Number of integration steps
+ */
+void Spacecraft::integrateRotationalStates(double startTime, double duration, uint32_t steps)
+{
+    Eigen::MRPd sigmaBNLoc;
+    sigmaBNLoc = (Eigen::Vector3d) this->hubSigma->getState();
+    this->updateSCMassProps(startTime);
+    Eigen::Matrix3d dcm_NB = sigmaBNLoc.toRotationMatrix();
+    Eigen::Vector3d rLocal_CN_N = this->hubR_N->getState() + dcm_NB*(*this->c_B);
+    Eigen::Vector3d vLocal_CN_N = this->hubV_N->getState() + dcm_NB*(*this->cDot_B);
+
+    this->integrationPhase = IntegrationPhase::Rotational;
+    this->rotationalGravityCurrent = false;
+    double rotationalTimeStep = duration/steps;
+    for (uint32_t i = 0; i < steps; i++) {
+        this->integrator->integrate(startTime + i*rotationalTimeStep, rotationalTimeStep);
+        // - Keep the attitude MRP within the unit sphere over the many rotational steps
+        this->hub.modifyStates(startTime + (i + 1)*rotationalTimeStep);
     }
+
+    sigmaBNLoc = (Eigen::Vector3d) this->hubSigma->getState();
+    this->updateSCMassProps(startTime + duration);
+    dcm_NB = sigmaBNLoc.toRotationMatrix();
+    this->hubR_N->setState(rLocal_CN_N - dcm_NB*(*this->c_B));
+    this->hubV_N->setState(vLocal_CN_N - dcm_NB*(*this->cDot_B));
 }
 
 /*! Prepare for integration process
@@ -447,14 +628,12 @@ void Spacecraft::preIntegration(double integrateToThisTime) {
     Eigen::Vector3d oldV_BN_N = this->hubV_N->getState();  // - V_BN_N before integration
     Eigen::Vector3d oldV_CN_N;  // - V_CN_N before integration
     Eigen::Vector3d oldC_B;     // - Center of mass offset before integration
-    Eigen::MRPd oldSigma_BN;    // - Sigma_BN before integration
     // - Get the angular rate, oldOmega_BN_B from the dyn manager
     this->oldOmega_BN_B = this->hubOmega_BN_B->getState();
     // - Get center of mass, v_BN_N and dcm_NB from the dyn manager
-    oldSigma_BN = (Eigen::Vector3d) this->hubSigma->getState();
+    this->kinematics.update(this->hubSigma->getState(), this->oldOmega_BN_B);
     // - Finally find v_CN_N
-    Eigen::Matrix3d oldDcm_NB = oldSigma_BN.toRotationMatrix(); // - dcm_NB before integration
-    oldV_CN_N = oldV_BN_N + oldDcm_NB*(*this->cDot_B);
+    oldV_CN_N = oldV_BN_N + this->kinematics.dcm_NB*(*this->cDot_B);
 
     // - Integrate the state from the last time (timeBefore) to the integrateToThisTime
     this->hub.matchGravitytoVelocityState(oldV_CN_N); // Set gravity velocity to base velocity for DV estimation
@@ -473,32 +652,28 @@ void Spacecraft::postIntegration(double integrateToThisTime) {
     // - Find v_CN_N after the integration for accumulated DV
     Eigen::Vector3d newV_BN_N = this->hubV_N->getState(); // - V_BN_N after integration
     Eigen::Vector3d newV_CN_N;  // - V_CN_N after integration
-    Eigen::MRPd newSigma_BN;    // - Sigma_BN after integration
     // - Get center of mass, v_BN_N and dcm_NB
-    Eigen::Vector3d sigmaBNLoc;
-    sigmaBNLoc = (Eigen::Vector3d) this->hubSigma->getState();
-    newSigma_BN = sigmaBNLoc;
-    Eigen::Matrix3d newDcm_NB = newSigma_BN.toRotationMatrix();  // - dcm_NB after integration
+    this->kinematics.update(this->hubSigma->getState(), this->hubOmega_BN_B->getState());
+    const Eigen::Matrix3d& newDcm_NB = this->kinematics.dcm_NB;  // - dcm_NB after integration
     newV_CN_N = newV_BN_N + newDcm_NB*(*this->cDot_B);
 
     // - Find accumulated DV of the center of mass in the body frame
-    this->dvAccum_CN_B += newDcm_NB.transpose()*(newV_CN_N -
+    this->dvAccum_CN_B += this->kinematics.dcm_BN*(newV_CN_N -
                                               this->BcGravVelocity->getState());
 
     // - Find the accumulated DV of the body frame in the body frame
-    this->dvAccum_BN_B += newDcm_NB.transpose()*(newV_BN_N -
+    this->dvAccum_BN_B += this->kinematics.dcm_BN*(newV_BN_N -
                                                  this->hubGravVelocity->getState());
 
     // - Find the accumulated DV of the center of mass in the inertial frame
     this->dvAccum_CN_N += newV_CN_N - this->BcGravVelocity->getState();
 
     // - non-conservative acceleration of the body frame in the body frame
-    this->nonConservativeAccelpntB_B = (newDcm_NB.transpose()*(newV_BN_N -
+    this->nonConservativeAccelpntB_B = (this->kinematics.dcm_BN*(newV_BN_N -
                                                                this->hubGravVelocity->getState()))/this->timeStep;
 
     // - angular acceleration in the body frame
-    Eigen::Vector3d newOmega_BN_B;
-    newOmega_BN_B = this->hubOmega_BN_B->getState();
+    const Eigen::Vector3d& newOmega_BN_B = this->kinematics.omega_BN_B;
     if (fabs(this->timeStep) > 1e-10) {
         this->omegaDot_BN_B = (newOmega_BN_B - this->oldOmega_BN_B)/this->timeStep; //angular acceleration of B wrt N in the Body frame
     } else {
@@ -530,12 +705,11 @@ void Spacecraft::computeEnergyMomentum(double time)
     // - Grab values from state Manager
     Eigen::Vector3d rLocal_BN_N = hubR_N->getState();
     Eigen::Vector3d rDotLocal_BN_N = hubV_N->getState();
-    Eigen::MRPd sigmaLocal_BN;
-    sigmaLocal_BN = (Eigen::Vector3d ) hubSigma->getState();
 
     // - Find DCM's
-    Eigen::Matrix3d dcmLocal_NB = sigmaLocal_BN.toRotationMatrix();
-    Eigen::Matrix3d dcmLocal_BN = dcmLocal_NB.transpose();
+    this->kinematics.update(this->hubSigma->getState(), this->hubOmega_BN_B->getState());
+    const Eigen::Matrix3d& dcmLocal_NB = this->kinematics.dcm_NB;
+    const Eigen::Matrix3d& dcmLocal_BN = this->kinematics.dcm_BN;
 
     // - Convert from inertial frame to body frame
     Eigen::Vector3d rBNLocal_B;
@@ -556,7 +730,7 @@ void Spacecraft::computeEnergyMomentum(double time)
     this->rotEnergyContr = 0.0;
 
     // - Get the hubs contribution
-    this->hub.updateEnergyMomContributions(time, this->rotAngMomPntCContr_B, this->rotEnergyContr, this->hubOmega_BN_B->getState());
+    this->hub.updateEnergyMomContributions(time, this->rotAngMomPntCContr_B, this->rotEnergyContr, this->kinematics.omega_BN_B);
     totRotAngMomPntC_B += this->rotAngMomPntCContr_B;
     this->totRotEnergy += this->rotEnergyContr;
 
@@ -569,7 +743,7 @@ void Spacecraft::computeEnergyMomentum(double time)
         this->rotEnergyContr = 0.0;
 
         // - Call energy and momentum calulations for stateEffectors
-        (*it)->updateEnergyMomContributions(time, this->rotAngMomPntCContr_B, this->rotEnergyContr, this->hubOmega_BN_B->getState());
+        (*it)->updateEnergyMomContributions(time, this->rotAngMomPntCContr_B, this->rotEnergyContr, this->kinematics.omega_BN_B);
         totRotAngMomPntC_B += this->rotAngMomPntCContr_B;
         this->totRotEnergy += this->rotEnergyContr;
     }
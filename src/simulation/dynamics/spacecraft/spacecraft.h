@@ -74,6 +74,7 @@ public:
     BSKLogger bskLogger;                      //!< -- BSK Logging
     Message<SCStatesMsgPayload> scStateOutMsg;      //!< spacecraft state output message
     Message<SCMassPropsMsgPayload> scMassOutMsg;    //!< spacecraft mass properties output message
+    uint32_t rotationalSubsteps;         //!< -- Number of integration steps of the rotational and state effector states per step of the translational states, rounded up to an even number, zero to integrate all states together
 
 public:
     Spacecraft();                    //!< -- Constructor
@@ -84,6 +85,7 @@ public:
     void calcForceTorqueFromStateEffectors(double time, Eigen::Vector3d omega_BN_B);  //!< -- This method computes the force and torque from the stateEffectors
     void Reset(uint64_t CurrentSimNanos);
 	void writeOutputStateMessages(uint64_t clockTime); //!< -- Method to write all of the class output messages
+    bool interpolateStates(uint64_t simTimeNanos, SCStatesMsgPayload& stateOut); //!< -- Interpolates the hub states within the last integration step
     void UpdateState(uint64_t CurrentSimNanos);  //!< -- Runtime hook back into Basilisk arch
     void linkInStates(DynParamManager& statesIn);  //!< Method to get access to the hub's states
     void equationsOfMotion(double integTimeSeconds, double timeStep);    //!< -- This method computes the equations of motion for the whole system
@@ -114,9 +116,25 @@ private:
     Eigen::MatrixXd *sysTime;            //!< [s] System time
 
     Eigen::Vector3d oldOmega_BN_B;       //!< [r/s] prior angular rate of B wrt N in the Body frame
+    HubKinematics kinematics;            //!< -- Attitude kinematics of the hub, updated once per evaluation
+
+    /*! States integrated in the current phase of the multi-rate integration */
+    enum class IntegrationPhase {
+        Coupled,        //!< All states are integrated together
+        Rotational,     //!< Only the rotational and state effector states are integrated
+        Translational   //!< Only the translational states are integrated
+    };
+    IntegrationPhase integrationPhase;   //!< -- Current phase of the integration
+    bool rotationalGravityCurrent;       //!< -- Flag indicating that g_N was computed in the current rotational phase
+    bool lastStepMultiRate;              //!< -- Flag indicating that the last integration step was a multi-rate step
+    std::vector<StateData*> translationalStates; //!< -- Hub position, velocity and gravity velocity states
+    std::vector<StateData*> rotationalStates;    //!< -- Every other state of the spacecraft
 
 private:
     void readOptionalRefMsg();                  //!< -- Read the optional attitude or translational reference input message and set the reference states
+    bool canIntegrateMultiRate() const;         //!< -- Returns true if the rotational states can be sub-cycled
+    void integrateStateMultiRate(double integrateToThisTime); //!< -- Integrates the rotational and translational states separately
+    void integrateRotationalStates(double startTime, double duration, uint32_t steps); //!< -- Integrates the rotational states with the center of mass frozen
 };
 
 
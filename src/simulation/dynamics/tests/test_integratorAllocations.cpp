@@ -0,0 +1,181 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include <Eigen/Dense>
+#include "simulation/dynamics/_GeneralModuleFiles/dynamicObject.h"
+#include "simulation/dynamics/_GeneralModuleFiles/svIntegratorAdaptiveRungeKutta.h"
+#include "simulation/dynamics/_GeneralModuleFiles/svIntegratorRK4.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <gtest/gtest.h>
+
+// Every heap allocation of the test executable is counted. Eigen allocates its dynamic
+// matrices with malloc, so malloc itself is replaced where the C library allows it.
+static std::atomic<uint64_t> allocationCount{0};
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_calloc(std::size_t count, std::size_t size);
+extern "C" void* __libc_realloc(void* pointer, std::size_t size);
+
+extern "C" void* malloc(std::size_t size)
+{
+    allocationCount++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size)
+{
+    allocationCount++;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, std::size_t size)
+{
+    allocationCount++;
+    return __libc_realloc(pointer, size);
+}
+#else
+void* operator new(std::size_t size)
+{
+    allocationCount++;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+#endif
+
+/** Harmonic oscillator whose equations of motion do not allocate */
+class Oscillator : public DynamicObject {
+  public:
+    Oscillator()
+    {
+        this->position = this->dynManager.registerState<Eigen::Vector3d>("position");
+        this->velocity = this->dynManager.registerState<Eigen::Vector3d>("velocity");
+        this->position->setState(Eigen::Vector3d(1.0, 0.0, -0.5));
+        this->velocity->setState(Eigen::Vector3d(0.0, 1.0, 0.2));
+    }
+
+    void UpdateState(uint64_t) override {}
+    void preIntegration(double) override {}
+    void postIntegration(double) override {}
+
+    void equationsOfMotion(double, double) override
+    {
+        this->position->setDerivative(this->velocity->getStateAs<Eigen::Vector3d>());
+        this->velocity->setDerivative(-this->position->getStateAs<Eigen::Vector3d>());
+    }
+
+    StateData* position;
+    StateData* velocity;
+};
+
+/** Coefficients of the Bogacki-Shampine method */
+static RKAdaptiveCoefficients<4> getBogackiShampineCoefficients()
+{
+    RKAdaptiveCoefficients<4> coefficients;
+    coefficients.aMatrix[1] = {1.0 / 2.0, 0.0, 0.0, 0.0};
+    coefficients.aMatrix[2] = {0.0, 3.0 / 4.0, 0.0, 0.0};
+    coefficients.aMatrix[3] = {2.0 / 9.0, 1.0 / 3.0, 4.0 / 9.0, 0.0};
+    coefficients.bArray = {7.0 / 24.0, 1.0 / 4.0, 1.0 / 3.0, 1.0 / 8.0};
+    coefficients.bStarArray = {2.0 / 9.0, 1.0 / 3.0, 4.0 / 9.0, 0.0};
+    coefficients.cArray = {0.0, 1.0 / 2.0, 3.0 / 4.0, 1.0};
+    return coefficients;
+}
+
+/** Returns the number of heap allocations made by the given number of calls to integrate,
+ * after a first call that sizes the workspaces */
+static uint64_t countIntegrationAllocations(StateVecIntegrator& integrator, size_t callCount)
+{
+    const double timeStep = 0.1;
+    uint64_t before = allocationCount;
+    integrator.integrate(0.0, timeStep);
+    // The workspaces are sized by the first call
+    EXPECT_GT(allocationCount - before, 0u);
+
+    before = allocationCount;
+    for (size_t callIndex = 1; callIndex <= callCount; callIndex++) {
+        integrator.integrate(callIndex * timeStep, timeStep);
+    }
+    return allocationCount - before;
+}
+
+TEST(integratorAllocations, testRK4) {
+    Oscillator oscillator;
+    svIntegratorRK4 integrator(&oscillator);
+
+    EXPECT_EQ(countIntegrationAllocations(integrator, 100), 0u);
+    EXPECT_EQ(integrator.getWorkspaceResizeCount(), 7u);
+}
+
+TEST(integratorAllocations, testAdaptive) {
+    Oscillator oscillator;
+    svIntegratorAdaptiveRungeKutta<4> integrator(&oscillator, getBogackiShampineCoefficients(), 3.0);
+    integrator.setRelativeTolerance("velocity", 1e-6);
+    integrator.setAbsoluteTolerance(oscillator, "position", 1e-9);
+
+    EXPECT_EQ(countIntegrationAllocations(integrator, 100), 0u);
+    EXPECT_EQ(integrator.getWorkspaceResizeCount(), 8u);
+}
+
+TEST(integratorAllocations, testAdaptiveDenseOutput) {
+    Oscillator oscillator;
+    svIntegratorAdaptiveRungeKutta<4> integrator(&oscillator, getBogackiShampineCoefficients(), 3.0);
+    integrator.setDenseOutput(true);
+
+    EXPECT_EQ(countIntegrationAllocations(integrator, 100), 0u);
+}
+
+TEST(integratorAllocations, testAdaptiveCoasting) {
+    Oscillator oscillator;
+    svIntegratorAdaptiveRungeKutta<4> integrator(&oscillator, getBogackiShampineCoefficients(), 3.0);
+    integrator.maximumCoastTimeStep = 1.0;
+
+    // The dense output segments grow until a call first continues the last step
+    for (size_t callIndex = 0; callIndex < 10; callIndex++) {
+        integrator.integrate(callIndex * 0.1, 0.1);
+    }
+    uint64_t before = allocationCount;
+    for (size_t callIndex = 10; callIndex < 110; callIndex++) {
+        integrator.integrate(callIndex * 0.1, 0.1);
+    }
+    EXPECT_EQ(allocationCount - before, 0u);
+}
+
+TEST(integratorTolerances, testToleranceSetAfterFirstStep) {
+    Oscillator oscillator;
+    svIntegratorAdaptiveRungeKutta<4> integrator(&oscillator, getBogackiShampineCoefficients(), 3.0);
+    integrator.integrate(0.0, 1.0);
+    integrator.setRelativeTolerance("position", 1e-10);
+    integrator.setRelativeTolerance(oscillator, "velocity", 1e-10);
+    integrator.integrate(1.0, 1.0);
+
+    // The tolerances resolved by the first call must not be reused by the second one,
+    // which would give the same states as an integrator using the default tolerances
+    Oscillator reference;
+    svIntegratorAdaptiveRungeKutta<4> referenceIntegrator(&reference, getBogackiShampineCoefficients(), 3.0);
+    referenceIntegrator.integrate(0.0, 1.0);
+    referenceIntegrator.integrate(1.0, 1.0);
+    EXPECT_TRUE(reference.position->getState().isApprox(oscillator.position->getState(), 1e-3));
+    EXPECT_FALSE(reference.position->getState().isApprox(oscillator.position->getState(), 1e-12));
+}
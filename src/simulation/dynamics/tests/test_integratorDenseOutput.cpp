@@ -0,0 +1,128 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include <Eigen/Dense>
+#include "simulation/dynamics/_GeneralModuleFiles/dynamicObject.h"
+#include "simulation/dynamics/_GeneralModuleFiles/svIntegratorAdaptiveRungeKutta.h"
+#include "simulation/dynamics/_GeneralModuleFiles/svIntegratorRK4.h"
+#include <gtest/gtest.h>
+
+/** Harmonic oscillator that counts the evaluations of its equations of motion */
+class CountingOscillator : public DynamicObject {
+  public:
+    CountingOscillator()
+    {
+        this->position = this->dynManager.registerState<Eigen::Vector2d>("position");
+        this->velocity = this->dynManager.registerState<Eigen::Vector2d>("velocity");
+        this->position->setState(Eigen::Vector2d(1.0, 0.0));
+        this->velocity->setState(Eigen::Vector2d(0.0, 1.0));
+    }
+
+    void UpdateState(uint64_t) override {}
+    void preIntegration(double) override {}
+    void postIntegration(double) override {}
+
+    void equationsOfMotion(double t, double) override
+    {
+        this->position->setDerivative(this->velocity->getStateAs<Eigen::Vector2d>());
+        this->velocity->setDerivative(-this->position->getStateAs<Eigen::Vector2d>());
+        this->evaluations++;
+        this->lastEvaluationTime = t;
+        this->lastEvaluationPosition = this->position->getStateAs<Eigen::Vector2d>();
+    }
+
+    StateData* position;
+    StateData* velocity;
+    size_t evaluations = 0;
+    double lastEvaluationTime = 0;
+    Eigen::Vector2d lastEvaluationPosition;
+};
+
+/** Bogacki-Shampine method, propagating the third order solution, whose last stage is at the end of the step */
+static RKAdaptiveCoefficients<4> getBogackiShampineCoefficients()
+{
+    RKAdaptiveCoefficients<4> coefficients;
+    coefficients.aMatrix[1] = {1.0 / 2.0, 0.0, 0.0, 0.0};
+    coefficients.aMatrix[2] = {0.0, 3.0 / 4.0, 0.0, 0.0};
+    coefficients.aMatrix[3] = {2.0 / 9.0, 1.0 / 3.0, 4.0 / 9.0, 0.0};
+    coefficients.bArray = {2.0 / 9.0, 1.0 / 3.0, 4.0 / 9.0, 0.0};
+    coefficients.bStarArray = {7.0 / 24.0, 1.0 / 4.0, 1.0 / 3.0, 1.0 / 8.0};
+    coefficients.cArray = {0.0, 1.0 / 2.0, 3.0 / 4.0, 1.0};
+    return coefficients;
+}
+
+/** Returns the number of evaluations of the equations of motion made by ten calls to integrate */
+static size_t countEvaluations(StateVecIntegrator& integrator, CountingOscillator& oscillator)
+{
+    for (size_t callIndex = 0; callIndex < 10; callIndex++) {
+        integrator.integrate(callIndex * 0.5, 0.5);
+    }
+    return oscillator.evaluations;
+}
+
+TEST(integratorDenseOutput, testLastStageReused) {
+    CountingOscillator oscillator;
+    svIntegratorAdaptiveRungeKutta<4> integrator(&oscillator, getBogackiShampineCoefficients(), 3.0);
+    integrator.setDenseOutput(true);
+    CountingOscillator reference;
+    svIntegratorAdaptiveRungeKutta<4> referenceIntegrator(&reference, getBogackiShampineCoefficients(), 3.0);
+
+    EXPECT_EQ(countEvaluations(integrator, oscillator), countEvaluations(referenceIntegrator, reference));
+
+    // The end of the last step interpolates to the final states
+    Eigen::MatrixXd velocity;
+    ASSERT_TRUE(integrator.getInterpolatedState(oscillator, "velocity", 5.0, velocity));
+    EXPECT_TRUE(velocity.isApprox(oscillator.velocity->getState(), 1e-12));
+
+    // Within the last step, the interpolation uses the reused end derivatives
+    ASSERT_TRUE(integrator.getInterpolatedState(oscillator, "velocity", 4.9, velocity));
+    Eigen::Vector2d trueVelocity(-std::sin(4.9), std::cos(4.9));
+    EXPECT_LT((velocity - trueVelocity).norm(), 1e-3);
+}
+
+TEST(integratorDenseOutput, testEndDerivativeEvaluated) {
+    CountingOscillator oscillator;
+    svIntegratorRK4 integrator(&oscillator);
+    integrator.setDenseOutput(true);
+    CountingOscillator reference;
+    svIntegratorRK4 referenceIntegrator(&reference);
+
+    // RK4 does not evaluate its last stage at the end of the step
+    EXPECT_EQ(countEvaluations(integrator, oscillator), countEvaluations(referenceIntegrator, reference) + 10);
+}
+
+TEST(integratorCoasting, testEquationsOfMotionRefreshed) {
+    CountingOscillator oscillator;
+    svIntegratorAdaptiveRungeKutta<4> integrator(&oscillator, getBogackiShampineCoefficients(), 3.0);
+    integrator.maximumCoastTimeStep = 2.0;
+
+    for (size_t callIndex = 0; callIndex < 20; callIndex++) {
+        double endTime = (callIndex + 1) * 0.1;
+        size_t evaluations = oscillator.evaluations;
+        integrator.integrate(callIndex * 0.1, 0.1);
+
+        // Calls within the last step only evaluate the equations of motion at the end of the call
+        if (callIndex > 0) {
+            EXPECT_GE(oscillator.evaluations, evaluations + 1);
+        }
+        EXPECT_DOUBLE_EQ(oscillator.lastEvaluationTime, endTime);
+        EXPECT_TRUE(oscillator.lastEvaluationPosition.isApprox(
+            oscillator.position->getStateAs<Eigen::Vector2d>(), 1e-14));
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include <Eigen/Dense>
+#include "simulation/dynamics/_GeneralModuleFiles/dynParamManager.h"
+#include <gtest/gtest.h>
+
+
+TEST(stateData, testRegisterFixedSize) {
+    DynParamManager manager;
+    StateData* state = manager.registerState<Eigen::Vector3d>("position");
+
+    EXPECT_EQ(state->getRowSize(), 3);
+    EXPECT_EQ(state->getColumnSize(), 1);
+    EXPECT_EQ(state->getStateDeriv().rows(), 3);
+}
+
+TEST(stateData, testStateView) {
+    DynParamManager manager;
+    StateData* state = manager.registerState<Eigen::Vector3d>("position");
+    Eigen::Vector3d position(1.0, -2.0, 3.0);
+    state->setState(position);
+
+    Eigen::Map<const Eigen::Vector3d> view = state->getStateAs<Eigen::Vector3d>();
+    EXPECT_TRUE(view.isApprox(position));
+    EXPECT_EQ(view.data(), state->getState().data());
+
+    // the view follows the state storage
+    state->setState(2.0*position);
+    EXPECT_TRUE(view.isApprox(2.0*position));
+}
+
+TEST(stateData, testStateDerivView) {
+    DynParamManager manager;
+    StateData* state = manager.registerState<Eigen::Vector4d>("quaternion");
+    Eigen::Vector4d derivative(0.1, 0.2, -0.3, 0.4);
+    state->setDerivative(derivative);
+
+    Eigen::Map<const Eigen::Vector4d> view = state->getStateDerivAs<Eigen::Vector4d>();
+    EXPECT_TRUE(view.isApprox(derivative));
+    EXPECT_EQ(view.data(), state->getStateDeriv().data());
+}
+
+TEST(stateData, testScalarState) {
+    DynParamManager manager;
+    using Scalar = Eigen::Matrix<double, 1, 1>;
+    StateData* state = manager.registerState<Scalar>("mass");
+    state->setState(Scalar(100.0));
+
+    EXPECT_EQ(state->getStateAs<Scalar>()(0), 100.0);
+}
@@ -0,0 +1,393 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "chebyshevEphemerisCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+namespace {
+    const char fileMagic[8] = {'B', 'S', 'K', 'C', 'H', 'E', 'B', '1'};
+
+    /*! Evaluates the Chebyshev series of the given coefficients at x in [-1, 1] with the Clenshaw recurrence */
+    double evaluateChebyshev(const double *coefficients, uint32_t count, double x)
+    {
+        double b1 = 0.0;
+        double b2 = 0.0;
+        for (uint32_t j = count - 1; j > 0; j--) {
+            double b0 = 2.0 * x * b1 - b2 + coefficients[j];
+            b2 = b1;
+            b1 = b0;
+        }
+        return x * b1 - b2 + coefficients[0];
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream &file, const T &value)
+    {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::ifstream &file, T &value)
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+}
+
+/*! The constructor sets the default fit parameters.  The tolerance is above the round-off of the SPICE planet
+ orientations, whose rotation angles are large numbers of radians, which cannot be fitted more accurately. */
+ChebyshevEphemerisCache::ChebyshevEphemerisCache()
+{
+    this->coefficientCount = 16;
+    this->relativeTolerance = 1e-11;
+    this->maximumSegmentLength = 8.0 * 86400.0;
+    this->minimumSegmentLength = 60.0;
+}
+
+ChebyshevEphemerisCache::~ChebyshevEphemerisCache()
+{
+}
+
+/*! Fits a series over a time span, replacing any series of the same name.  The time span is divided into segments
+ no longer than maximumSegmentLength, which are bisected until the fit is within relativeTolerance.
+ @param name name of the series
+ @param componentCount number of values written by the sampler
+ @param startTime [s] start of the time span
+ @param endTime [s] end of the time span
+ @param sampler function writing the values of the series at a time
+ @return false if some segments shorter than minimumSegmentLength do not meet the tolerance.  The series is
+ still stored, with the error of these segments.
+ */
+bool ChebyshevEphemerisCache::fitSeries(const std::string &name, uint32_t componentCount, double startTime,
+                                        double endTime, const Sampler &sampler)
+{
+    if (componentCount == 0 || this->coefficientCount < 2 || !(endTime > startTime)) {
+        this->bskLogger.bskLog(BSK_ERROR, "ChebyshevEphemerisCache: cannot fit %s with %u components and %u "
+                               "coefficients over [%f, %f].", name.c_str(), componentCount,
+                               this->coefficientCount, startTime, endTime);
+        return false;
+    }
+
+    Series fitted;
+    fitted.name = name;
+    fitted.componentCount = componentCount;
+    fitted.coefficientCount = this->coefficientCount;
+    fitted.boundaries.push_back(startTime);
+
+    // Segments still to fit, the first one at the back
+    std::vector<std::pair<double, double>> pending;
+    size_t initialCount = (size_t) std::ceil((endTime - startTime) / this->maximumSegmentLength);
+    initialCount = std::max(initialCount, (size_t) 1);
+    for (size_t i = initialCount; i > 0; i--) {
+        double segmentStart = startTime + (endTime - startTime) * double(i - 1) / double(initialCount);
+        double segmentEnd = (i == initialCount) ? endTime
+                            : startTime + (endTime - startTime) * double(i) / double(initialCount);
+        pending.emplace_back(segmentStart, segmentEnd);
+    }
+
+    bool withinTolerance = true;
+    std::vector<double> segmentCoefficients;
+    while (!pending.empty()) {
+        std::pair<double, double> segment = pending.back();
+        pending.pop_back();
+        bool accurate = this->fitSegment(fitted, segment.first, segment.second, sampler, segmentCoefficients);
+        double halfLength = 0.5 * (segment.second - segment.first);
+        if (!accurate && halfLength >= this->minimumSegmentLength) {
+            double middle = segment.first + halfLength;
+            pending.emplace_back(middle, segment.second);
+            pending.emplace_back(segment.first, middle);
+            continue;
+        }
+        withinTolerance = withinTolerance && accurate;
+        fitted.boundaries.push_back(segment.second);
+        fitted.coefficients.insert(fitted.coefficients.end(), segmentCoefficients.begin(), segmentCoefficients.end());
+    }
+
+    if (!withinTolerance) {
+        this->bskLogger.bskLog(BSK_WARNING, "ChebyshevEphemerisCache: %s is not fitted within the relative "
+                               "tolerance %g by segments of %f seconds.", name.c_str(), this->relativeTolerance,
+                               this->minimumSegmentLength);
+    }
+
+    int64_t index = this->findSeries(name);
+    if (index >= 0) {
+        this->series[index] = std::move(fitted);
+    } else {
+        this->series.push_back(std::move(fitted));
+    }
+    return withinTolerance;
+}
+
+/*! Computes the coefficients of one segment from samples at the Chebyshev nodes, and checks them at the extrema
+ of the first neglected polynomial, which lie between the nodes and include the ends of the segment.
+ @return true if the fit is within relativeTolerance
+ */
+bool ChebyshevEphemerisCache::fitSegment(Series &fitted, double startTime, double endTime, const Sampler &sampler,
+                                         std::vector<double> &segmentCoefficients)
+{
+    const uint32_t n = fitted.coefficientCount;
+    const uint32_t m = fitted.componentCount;
+    const double middle = 0.5 * (endTime + startTime);
+    const double radius = 0.5 * (endTime - startTime);
+
+    std::vector<double> samples((size_t) n * m);
+    for (uint32_t k = 0; k < n; k++) {
+        double x = std::cos(M_PI * (k + 0.5) / n);
+        sampler(middle + radius * x, &samples[(size_t) k * m]);
+    }
+
+    // Coefficients are stored by component, as the records of chebyPosEphem
+    segmentCoefficients.assign((size_t) n * m, 0.0);
+    for (uint32_t c = 0; c < m; c++) {
+        double *coefficients = &segmentCoefficients[(size_t) c * n];
+        for (uint32_t j = 0; j < n; j++) {
+            double sum = 0.0;
+            for (uint32_t k = 0; k < n; k++) {
+                sum += samples[(size_t) k * m + c] * std::cos(M_PI * j * (k + 0.5) / n);
+            }
+            coefficients[j] = 2.0 * sum / n;
+        }
+        coefficients[0] *= 0.5;
+    }
+
+    std::vector<double> values(m);
+    std::vector<double> groupScale((m + 2) / 3, 0.0);
+    std::vector<double> groupError((m + 2) / 3, 0.0);
+    for (uint32_t k = 0; k <= n; k++) {
+        double x = std::cos(M_PI * k / n);
+        sampler(middle + radius * x, values.data());
+        for (uint32_t group = 0; 3 * group < m; group++) {
+            double norm = 0.0;
+            double error = 0.0;
+            for (uint32_t c = 3 * group; c < std::min(3 * group + 3, m); c++) {
+                double difference = evaluateChebyshev(&segmentCoefficients[(size_t) c * n], n, x) - values[c];
+                norm += values[c] * values[c];
+                error += difference * difference;
+            }
+            groupScale[group] = std::max(groupScale[group], std::sqrt(norm));
+            groupError[group] = std::max(groupError[group], std::sqrt(error));
+        }
+    }
+
+    for (size_t group = 0; group < groupError.size(); group++) {
+        if (groupError[group] > this->relativeTolerance * groupScale[group]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int64_t ChebyshevEphemerisCache::findSeries(const std::string &name) const
+{
+    for (size_t i = 0; i < this->series.size(); i++) {
+        if (this->series[i].name == name) {
+            return (int64_t) i;
+        }
+    }
+    return -1;
+}
+
+bool ChebyshevEphemerisCache::covers(int64_t seriesIndex, double startTime, double endTime) const
+{
+    if (seriesIndex < 0 || (size_t) seriesIndex >= this->series.size()) {
+        return false;
+    }
+    const std::vector<double> &boundaries = this->series[seriesIndex].boundaries;
+    return boundaries.front() <= startTime && endTime <= boundaries.back();
+}
+
+/*! Evaluates a series at a time inside its time span
+ @param seriesIndex index returned by findSeries
+ @param time [s] time at which the series is evaluated
+ @param values output with the componentCount values of the series
+ @return false, leaving the values untouched, if the series does not exist or does not cover the time
+ */
+bool ChebyshevEphemerisCache::evaluate(int64_t seriesIndex, double time, double *values) const
+{
+    if (!this->covers(seriesIndex, time, time)) {
+        return false;
+    }
+    const Series &fitted = this->series[seriesIndex];
+
+    // The last boundary belongs to the last segment
+    auto upper = std::upper_bound(fitted.boundaries.begin(), fitted.boundaries.end() - 1, time);
+    size_t segment = (size_t) (upper - fitted.boundaries.begin()) - 1;
+    double startTime = fitted.boundaries[segment];
+    double endTime = fitted.boundaries[segment + 1];
+    double x = (2.0 * time - startTime - endTime) / (endTime - startTime);
+
+    const size_t n = fitted.coefficientCount;
+    const double *coefficients = &fitted.coefficients[segment * n * fitted.componentCount];
+    for (uint32_t c = 0; c < fitted.componentCount; c++) {
+        values[c] = evaluateChebyshev(coefficients + c * n, fitted.coefficientCount, x);
+    }
+    return true;
+}
+
+uint32_t ChebyshevEphemerisCache::getComponentCount(int64_t seriesIndex) const
+{
+    if (seriesIndex < 0 || (size_t) seriesIndex >= this->series.size()) {
+        return 0;
+    }
+    return this->series[seriesIndex].componentCount;
+}
+
+size_t ChebyshevEphemerisCache::getSegmentCount(int64_t seriesIndex) const
+{
+    if (seriesIndex < 0 || (size_t) seriesIndex >= this->series.size()) {
+        return 0;
+    }
+    return this->series[seriesIndex].boundaries.size() - 1;
+}
+
+size_t ChebyshevEphemerisCache::getSeriesCount() const
+{
+    return this->series.size();
+}
+
+void ChebyshevEphemerisCache::clear()
+{
+    this->series.clear();
+}
+
+/*! Writes the cache to a binary file, in the byte order of the machine.  After a file identifier, the file holds
+ the number of series, then for every series its name, component count, coefficient count, segment count,
+ segment boundaries and coefficients.
+ @param fileName path of the file
+ @return false if the file cannot be written
+ */
+bool ChebyshevEphemerisCache::save(const std::string &fileName) const
+{
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        this->bskLogger.bskLog(BSK_ERROR, "ChebyshevEphemerisCache: cannot open %s for writing.", fileName.c_str());
+        return false;
+    }
+
+    file.write(fileMagic, sizeof(fileMagic));
+    writeValue(file, (uint64_t) this->series.size());
+    for (const Series &fitted : this->series) {
+        writeValue(file, (uint64_t) fitted.name.size());
+        file.write(fitted.name.data(), (std::streamsize) fitted.name.size());
+        writeValue(file, fitted.componentCount);
+        writeValue(file, fitted.coefficientCount);
+        writeValue(file, (uint64_t) (fitted.boundaries.size() - 1));
+        file.write(reinterpret_cast<const char *>(fitted.boundaries.data()),
+                   (std::streamsize) (fitted.boundaries.size() * sizeof(double)));
+        file.write(reinterpret_cast<const char *>(fitted.coefficients.data()),
+                   (std::streamsize) (fitted.coefficients.size() * sizeof(double)));
+    }
+
+    if (!file) {
+        this->bskLogger.bskLog(BSK_ERROR, "ChebyshevEphemerisCache: failed to write %s.", fileName.c_str());
+        return false;
+    }
+    return true;
+}
+
+/*! Replaces the content of the cache by a file written by save.  The sizes read from the file are checked against
+ its length before any memory is allocated.
+ @param fileName path of the file
+ @return false, leaving the cache untouched, if the file cannot be read or is truncated or corrupted
+ */
+bool ChebyshevEphemerisCache::load(const std::string &fileName)
+{
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    const std::streamoff fileSize = file ? (std::streamoff) file.tellg() : 0;
+    file.seekg(0);
+    char magic[sizeof(fileMagic)];
+    if (!file || !file.read(magic, sizeof(magic)) || std::memcmp(magic, fileMagic, sizeof(fileMagic)) != 0) {
+        this->bskLogger.bskLog(BSK_ERROR, "ChebyshevEphemerisCache: %s is not an ephemeris cache file.",
+                               fileName.c_str());
+        return false;
+    }
+
+    std::vector<Series> loaded;
+    uint64_t seriesCount = 0;
+    bool valid = readValue(file, seriesCount);
+    for (uint64_t i = 0; valid && i < seriesCount; i++) {
+        Series fitted;
+        uint64_t nameLength = 0;
+        uint64_t segmentCount = 0;
+        valid = readValue(file, nameLength) && nameLength < 4096;
+        if (valid) {
+            fitted.name.resize(nameLength);
+            valid = static_cast<bool>(file.read(&fitted.name[0], (std::streamsize) nameLength));
+        }
+        valid = valid && readValue(file, fitted.componentCount) && readValue(file, fitted.coefficientCount)
+                && readValue(file, segmentCount);
+        valid = valid && segmentCount > 0 && fitted.componentCount > 0 && fitted.coefficientCount > 1;
+
+        // The counts are checked against the rest of the file before allocating, so that a corrupted count
+        // fails the load instead of allocating an arbitrary amount of memory
+        if (valid) {
+            uint64_t remainingValues = (uint64_t) (fileSize - (std::streamoff) file.tellg()) / sizeof(double);
+            uint64_t segmentValues = (uint64_t) fitted.componentCount * fitted.coefficientCount + 1;
+            valid = remainingValues > 0 && segmentCount <= (remainingValues - 1) / segmentValues;
+        }
+        if (!valid) {
+            break;
+        }
+        fitted.boundaries.resize(segmentCount + 1);
+        fitted.coefficients.resize(segmentCount * fitted.componentCount * fitted.coefficientCount);
+        valid = file.read(reinterpret_cast<char *>(fitted.boundaries.data()),
+                          (std::streamsize) (fitted.boundaries.size() * sizeof(double)))
+                && file.read(reinterpret_cast<char *>(fitted.coefficients.data()),
+                             (std::streamsize) (fitted.coefficients.size() * sizeof(double)));
+        loaded.push_back(std::move(fitted));
+    }
+
+    if (!valid) {
+        this->bskLogger.bskLog(BSK_ERROR, "ChebyshevEphemerisCache: %s is truncated or corrupted.",
+                               fileName.c_str());
+        return false;
+    }
+    this->series = std::move(loaded);
+    return true;
+}
+
+/*! Returns the read-only cache of a file written by save, shared by all the callers of the process.  The file is
+ read by the first caller, and again only after all the previous callers released the cache.
+ @param fileName path of the file
+ @return the shared cache, or nullptr if the file cannot be read
+ */
+std::shared_ptr<const ChebyshevEphemerisCache> ChebyshevEphemerisCache::loadShared(const std::string &fileName)
+{
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<const ChebyshevEphemerisCache>> registry;
+
+    // Callers asking for a file being read wait for it instead of reading it again
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::shared_ptr<const ChebyshevEphemerisCache> cache = registry[fileName].lock();
+    if (!cache) {
+        std::shared_ptr<ChebyshevEphemerisCache> loaded = std::make_shared<ChebyshevEphemerisCache>();
+        if (!loaded->load(fileName)) {
+            registry.erase(fileName);
+            return nullptr;
+        }
+        cache = loaded;
+        registry[fileName] = cache;
+    }
+    return cache;
+}
@@ -0,0 +1,89 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef CHEBYSHEV_EPHEMERIS_CACHE_H
+#define CHEBYSHEV_EPHEMERIS_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "architecture/utilities/bskLogging.h"
+
+/*! @brief Piecewise Chebyshev fits of time series, such as ephemerides, that are expensive to sample.
+
+ A series has a number of components, in groups of three such as a position or a column of a DCM, and is fitted
+ over a time span by segments that each hold coefficientCount Chebyshev coefficients per component.  The segments
+ are bisected until the fit matches the sampled values, between the fit nodes, within relativeTolerance of the
+ largest norm of each group of three components over the segment.  This is the same representation as the
+ records of :ref:`chebyPosEphem`, with segments of variable length.
+
+ Fitted series can be saved to and loaded from a binary file.  A loaded cache can be evaluated without the
+ function that produced the samples.  Evaluating a cache does not modify it, so a cache can be shared by threads
+ once it is filled.  loadShared() reads each file once per process and returns the same read-only cache to all
+ callers, such as the simulations of a Monte Carlo study run in threads.
+ */
+class ChebyshevEphemerisCache {
+public:
+    /*! Function writing the componentCount values of a series at the given time */
+    using Sampler = std::function<void(double time, double *values)>;
+
+    ChebyshevEphemerisCache();
+    ~ChebyshevEphemerisCache();
+
+    bool fitSeries(const std::string &name, uint32_t componentCount, double startTime, double endTime,
+                   const Sampler &sampler);  //!< Fits a series sampled over [startTime, endTime]
+    int64_t findSeries(const std::string &name) const;  //!< Index of the named series, or -1 if not in the cache
+    bool covers(int64_t seriesIndex, double startTime, double endTime) const;  //!< True if the series spans the times
+    bool evaluate(int64_t seriesIndex, double time, double *values) const;  //!< Evaluates a series at a time
+    uint32_t getComponentCount(int64_t seriesIndex) const;  //!< Number of components of a series
+    size_t getSegmentCount(int64_t seriesIndex) const;  //!< Number of segments of a series
+    size_t getSeriesCount() const;  //!< Number of series in the cache
+    void clear();  //!< Removes all series
+
+    bool save(const std::string &fileName) const;  //!< Writes the cache to a binary file
+    bool load(const std::string &fileName);  //!< Replaces the cache by the content of a binary file
+    static std::shared_ptr<const ChebyshevEphemerisCache> loadShared(const std::string &fileName);  //!< Process-wide read-only cache of a file
+
+public:
+    uint32_t coefficientCount;   //!< -- Number of Chebyshev coefficients per component of each segment
+    double relativeTolerance;    //!< -- Largest error of the fit, relative to the norm of each group of components
+    double maximumSegmentLength; //!< [s] Length of the longest segments
+    double minimumSegmentLength; //!< [s] Length below which segments are not bisected further
+    mutable BSKLogger bskLogger; //!< -- BSK Logging
+
+private:
+    /*! Fitted segments of a series */
+    struct Series {
+        std::string name;                  //!< Name of the series
+        uint32_t componentCount;           //!< Number of components
+        uint32_t coefficientCount;         //!< Number of coefficients per component of each segment
+        std::vector<double> boundaries;    //!< [s] Start time of every segment, then end time of the last one
+        std::vector<double> coefficients;  //!< Coefficients of every component of every segment
+    };
+
+    bool fitSegment(Series &series, double startTime, double endTime, const Sampler &sampler,
+                    std::vector<double> &segmentCoefficients);
+
+    std::vector<Series> series;  //!< Fitted series
+};
+
+#endif
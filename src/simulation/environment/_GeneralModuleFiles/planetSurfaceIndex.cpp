@@ -0,0 +1,199 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "planetSurfaceIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Widens the queried caps so that points on a tile edge are not lost to the round-off of their latitude or longitude
+    constexpr double angleMargin = 1e-9;
+
+    /*! Index of the tile of a longitude within a band of tileCount tiles, without wrapping */
+    long longitudeTile(double longitude, size_t tileCount)
+    {
+        return (long) std::floor((longitude + M_PI) * tileCount / (2.0 * M_PI));
+    }
+}
+
+/*! The constructor creates an empty index */
+PlanetSurfaceIndex::PlanetSurfaceIndex()
+{
+    this->pointsPerTile = 32.0;
+    this->clear();
+}
+
+PlanetSurfaceIndex::~PlanetSurfaceIndex()
+{
+}
+
+/*! Removes all points, leaving a single empty tile */
+void PlanetSurfaceIndex::clear()
+{
+    this->bandHeight = M_PI;
+    this->bandFirstTile = {0, 1};
+    this->tileStart = {0, 0};
+    this->order.clear();
+}
+
+/*! Sorts points into tiles.  The tile size is chosen so that a tile holds pointsPerTile points on average, and the
+ points of a tile keep the order in which they are given.
+ @param points_P planet-fixed points or directions.  Only their direction is used.
+ */
+void PlanetSurfaceIndex::build(const std::vector<Eigen::Vector3d> &points_P)
+{
+    this->clear();
+    if (points_P.empty()) {
+        return;
+    }
+
+    //! - Latitude bands of square tiles of the area holding pointsPerTile points on average
+    double tileSize = std::sqrt(4.0 * M_PI * std::max(1.0, this->pointsPerTile) / points_P.size());
+    size_t bandCount = std::max<size_t>(1, (size_t) std::ceil(M_PI / tileSize));
+    this->bandHeight = M_PI / bandCount;
+    this->bandFirstTile.assign(bandCount + 1, 0);
+    for (size_t band = 0; band < bandCount; band++) {
+        double lowerLatitude = -M_PI_2 + band * this->bandHeight;
+        double upperLatitude = lowerLatitude + this->bandHeight;
+        double widestCos = (lowerLatitude <= 0.0 && upperLatitude >= 0.0) ? 1.0 :
+                           std::max(std::cos(lowerLatitude), std::cos(upperLatitude));
+        size_t tileCount = std::max<size_t>(1, (size_t) std::ceil(2.0 * M_PI * widestCos / this->bandHeight));
+        this->bandFirstTile[band + 1] = this->bandFirstTile[band] + tileCount;
+    }
+
+    //! - Counting sort of the points by tile
+    std::vector<size_t> pointTiles(points_P.size());
+    this->tileStart.assign(this->bandFirstTile.back() + 1, 0);
+    for (size_t i = 0; i < points_P.size(); i++) {
+        pointTiles[i] = this->findTile(points_P[i]);
+        this->tileStart[pointTiles[i] + 1]++;
+    }
+    for (size_t tile = 0; tile + 1 < this->tileStart.size(); tile++) {
+        this->tileStart[tile + 1] += this->tileStart[tile];
+    }
+    std::vector<size_t> nextPosition(this->tileStart.begin(), this->tileStart.end() - 1);
+    this->order.resize(points_P.size());
+    for (size_t i = 0; i < points_P.size(); i++) {
+        this->order[nextPosition[pointTiles[i]]++] = (uint32_t) i;
+    }
+}
+
+/*! Finds the tile holding a point
+ @param point_P planet-fixed point
+ @return index of the tile
+ */
+size_t PlanetSurfaceIndex::findTile(const Eigen::Vector3d &point_P) const
+{
+    double latitude = std::atan2(point_P[2], std::hypot(point_P[0], point_P[1]));
+    double longitude = std::atan2(point_P[1], point_P[0]);
+    size_t bandCount = this->bandFirstTile.size() - 1;
+    size_t band = (size_t) std::max(0.0, std::floor((latitude + M_PI_2) / this->bandHeight));
+    band = std::min(band, bandCount - 1);
+    size_t tileCount = this->bandFirstTile[band + 1] - this->bandFirstTile[band];
+    long tile = std::max(0L, std::min((long) tileCount - 1, longitudeTile(longitude, tileCount)));
+    return this->bandFirstTile[band] + tile;
+}
+
+/*! Finds the points of the tiles overlapping a spherical cap, as ranges of positions in the ordered points.  The
+ ranges are sorted and do not overlap.  getOrder() gives the index of the point at each position.
+ @param capCenter_P planet-fixed direction of the center of the cap
+ @param capAngle [rad] angle between the center and the edge of the cap.  Caps of pi or more hold all points, and
+ negative angles none.
+ @param ranges ranges of the candidate points, replaced by the call
+ */
+void PlanetSurfaceIndex::findCandidates(const Eigen::Vector3d &capCenter_P, double capAngle,
+                                        std::vector<IndexRange> &ranges) const
+{
+    ranges.clear();
+    if (this->order.empty() || capAngle < 0.0) {
+        return;
+    }
+
+    //! - Adds the points of the tiles [firstTile, lastTile), merging the range with the previous one if they touch
+    auto addTiles = [&](size_t firstTile, size_t lastTile) {
+        size_t begin = this->tileStart[firstTile];
+        size_t end = this->tileStart[lastTile];
+        if (begin == end) {
+            return;
+        }
+        if (!ranges.empty() && ranges.back().end == begin) {
+            ranges.back().end = end;
+        }
+        else {
+            ranges.push_back({begin, end});
+        }
+    };
+
+    double angle = capAngle + angleMargin;
+    if (angle >= M_PI || capCenter_P.isZero()) {
+        addTiles(0, this->bandFirstTile.back());
+        return;
+    }
+
+    //! - Bands overlapping the latitudes of the cap
+    double latitude = std::atan2(capCenter_P[2], std::hypot(capCenter_P[0], capCenter_P[1]));
+    double longitude = std::atan2(capCenter_P[1], capCenter_P[0]);
+    long bandCount = (long) this->bandFirstTile.size() - 1;
+    long firstBand = std::max(0L, (long) std::floor((latitude - angle + M_PI_2) / this->bandHeight));
+    long lastBand = std::min(bandCount - 1, (long) std::floor((latitude + angle + M_PI_2) / this->bandHeight));
+
+    //! - Largest longitude difference from the center in the cap, unless it holds a pole
+    bool holdsPole = latitude + angle >= M_PI_2 || latitude - angle <= -M_PI_2;
+    double halfWidth = holdsPole ? M_PI : std::asin(std::min(1.0, std::sin(angle) / std::cos(latitude)));
+
+    for (long band = firstBand; band <= lastBand; band++) {
+        size_t firstTile = this->bandFirstTile[band];
+        long tileCount = (long) (this->bandFirstTile[band + 1] - firstTile);
+        long westTile = longitudeTile(longitude - halfWidth, tileCount);
+        long eastTile = longitudeTile(longitude + halfWidth, tileCount);
+        long count = eastTile - westTile + 1;
+        if (holdsPole || count >= tileCount) {
+            addTiles(firstTile, firstTile + tileCount);
+            continue;
+        }
+        long start = ((westTile % tileCount) + tileCount) % tileCount;
+        if (start + count <= tileCount) {
+            addTiles(firstTile + start, firstTile + start + count);
+        }
+        else {
+            //! - The tiles wrap around the band, the ranges are added in the order of the points
+            addTiles(firstTile, firstTile + start + count - tileCount);
+            addTiles(firstTile + start, firstTile + tileCount);
+        }
+    }
+}
+
+/*! @return index of the point at each position of the ordered points */
+const std::vector<uint32_t> &PlanetSurfaceIndex::getOrder() const
+{
+    return this->order;
+}
+
+/*! @return number of indexed points */
+size_t PlanetSurfaceIndex::getPointCount() const
+{
+    return this->order.size();
+}
+
+/*! @return number of tiles */
+size_t PlanetSurfaceIndex::getTileCount() const
+{
+    return this->bandFirstTile.back();
+}
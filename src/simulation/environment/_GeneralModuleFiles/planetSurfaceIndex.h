@@ -0,0 +1,67 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef PLANET_SURFACE_INDEX_H
+#define PLANET_SURFACE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <Eigen/Dense>
+
+/*! @brief Spatial index of points on a planet surface, such as albedo grid cells or ground mapping points.
+
+ The points are sorted into tiles of latitude bands, each band being split into longitude tiles of about the band
+ height.  findCandidates() returns the points of the tiles overlapping a spherical cap as ranges of the ordered
+ points, so the cost of a query scales with the area of the cap instead of the number of points.  The candidates
+ are a superset of the points in the cap, which the caller still tests exactly.  The index does not keep the
+ points, so build() must be called again after any of them changes.
+ */
+class PlanetSurfaceIndex {
+public:
+    /*! Range [begin, end) of positions in the ordered points */
+    struct IndexRange {
+        size_t begin;  //!< position of the first point of the range
+        size_t end;    //!< position after the last point of the range
+    };
+
+    PlanetSurfaceIndex();
+    ~PlanetSurfaceIndex();
+
+    void build(const std::vector<Eigen::Vector3d> &points_P);  //!< Sorts the planet-fixed points into tiles
+    void findCandidates(const Eigen::Vector3d &capCenter_P, double capAngle,
+                        std::vector<IndexRange> &ranges) const;  //!< Ranges of the points that may lie in a cap
+    const std::vector<uint32_t> &getOrder() const;  //!< Index of the point at each position of the ordered points
+    size_t getPointCount() const;  //!< Number of indexed points
+    size_t getTileCount() const;  //!< Number of tiles
+    void clear();  //!< Removes all points
+
+public:
+    double pointsPerTile;  //!< -- Average number of points per tile aimed at by build()
+
+private:
+    size_t findTile(const Eigen::Vector3d &point_P) const;
+
+    double bandHeight;                   //!< [rad] latitude extent of the bands
+    std::vector<size_t> bandFirstTile;   //!< index of the first tile of each band, then the number of tiles
+    std::vector<size_t> tileStart;       //!< position of the first point of each tile, then the number of points
+    std::vector<uint32_t> order;         //!< index of the point at each position, sorted by tile
+};
+
+#endif
@@ -74,7 +74,23 @@ def test_unitAlbedo(show_plots, planetCase, modelType, useEclipse):
     assert testResults < 1, testMessage
 
 
-def unitAlbedo(show_plots, planetCase, modelType, useEclipse):
+@pytest.mark.parametrize("planetCase", ['earth', 'mars'])
+@pytest.mark.parametrize("useEclipse", [True, False])
+def test_unitAlbedoThreads(show_plots, planetCase, useEclipse):
+    """
+    **Validation Test Description**
+
+    The grid cells of the ``ALBEDO_AVG_EXPLICIT`` case are summed by 4 threads.
+
+    **Description of Variables Being Tested**
+
+    ``albedoAtInstrument`` must match the same truth values as the single threaded case.
+    """
+    [testResults, testMessage] = unitAlbedo(show_plots, planetCase, 'ALBEDO_AVG_EXPLICIT', useEclipse, threadCount=4)
+    assert testResults < 1, testMessage
+
+
+def unitAlbedo(show_plots, planetCase, modelType, useEclipse, threadCount=1):
     __tracebackhide__ = True
     testFailCount = 0
     testMessages = []
@@ -112,6 +128,7 @@ def unitAlbedo(show_plots, planetCase, modelType, useEclipse):
 
     if useEclipse:
         albModule.eclipseCase = True
+    albModule.threadCount = threadCount
     # Create dummy sun message
     sunPositionMsg = messaging.SpicePlanetStateMsgPayload()
 
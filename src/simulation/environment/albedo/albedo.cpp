@@ -18,6 +18,15 @@
  */
 
 #include "albedo.h"
+#include "architecture/utilities/threadPool.h"
+#include <algorithm>
+
+namespace {
+    // Below this number of cells per thread, the cost of waking a thread is larger than the work it takes over
+    constexpr size_t minimumCellsPerThread = 8192;
+    // Cells are culled and summed in batches small enough to keep their indices on the stack
+    constexpr size_t cellBatchSize = 256;
+}
 
 /*! Albedo module constructor
  @return void
@@ -57,6 +66,8 @@ Albedo::Albedo()
     this->eclipseCase = false;
     this->shadowFactorAtdA = 1.0;
     this->altitudeRateLimit = -1.0;
+    this->threadCount = 1;
+    this->albedoGrids.clear();
     return;
 }
 
@@ -229,7 +240,7 @@ void Albedo::UpdateState(uint64_t CurrentSimNanos)
         double outData[4] = {};
         for (planetIt = this->planetMsgData.begin(); planetIt != this->planetMsgData.end(); planetIt++)
         {
-            this->computeAlbedo(idx, instIdx, *planetIt, albArray.at(idx), outData);
+            this->computeAlbedo(idx, instIdx, *planetIt, outData);
             tmpTot[0] += outData[0]; tmpTot[1] += outData[1];
             tmpTot[2] += outData[2]; tmpTot[3] += outData[3];
             idx++;
@@ -263,6 +274,7 @@ void Albedo::Reset(uint64_t CurrentSimNanos)
     this->gdlat.clear(); this->gdlon.clear();
     this->latDiff.clear(); this->lonDiff.clear();
     this->REQ_planets.clear();  this->RP_planets.clear();
+    this->albedoGrids.assign(this->planetMsgData.size(), AlbedoGrid());
     std::vector<SpicePlanetStateMsgPayload>::iterator planetIt;
     for (planetIt = this->planetMsgData.begin(); planetIt != this->planetMsgData.end(); planetIt++)
     {
@@ -271,6 +283,7 @@ void Albedo::Reset(uint64_t CurrentSimNanos)
         std::string plName(planetIt->PlanetName);
         this->getPlanetRadius(plName);  //! - [m] get the planet radius
         this->evaluateAlbedoModel(idx);
+        this->computeAlbedoGrid(idx);
         idx++;
     }
 }
@@ -498,10 +511,91 @@ void Albedo::evaluateAlbedoModel(int idx)
     this->numLats.at(idx) = numLat;
 }
 
+/*! This method computes the planet-fixed geometry of the albedo grid cells of a planet, which does not change
+ during the simulation: the cell normals, the cell areas on the sphere of authalic radius and the albedo coefficients.
+ @return void
+ */
+void Albedo::computeAlbedoGrid(int idx)
+{
+    AlbedoGrid &grid = this->albedoGrids.at(idx);
+    if (idx >= (int) this->REQ_planets.size() || this->gdlat[idx].empty() || this->gdlon[idx].empty()) {
+        return;
+    }
+    //! - Calculate the authalic radius, if the polar radius available
+    double t[3], t_aut[3], e;
+    bool authalicLatitude = this->RP_planets.at(idx) > 0.0;
+    if (authalicLatitude) {
+        e = sqrt(1 - pow(this->RP_planets.at(idx), 2) / pow(this->REQ_planets.at(idx), 2));
+        t[0] = pow(this->REQ_planets.at(idx), 2) * 0.5;
+        t[1] = (1 - e * e) / 2.0 / e;
+        t[2] = log((1 + e) / (1 - e));
+        grid.radius = sqrt(t[0] * (1 + t[1] * t[2]));  //! - Autalic radius of the planet
+        //! - Truncated series expansion for geodetic to authalic latitude
+        t_aut[0] = pow(e, 2) / 3.0 + 31.0 * pow(e, 4) / 180.0 + 59.0 * pow(e, 6) / 560.0;
+        t_aut[1] = 17.0 * pow(e, 4) / 360.0 + 61.0 * pow(e, 6) / 1260.0;
+        t_aut[2] = 383.0 * pow(e, 6) / 45360.0;
+    }
+    else {
+        grid.radius = this->REQ_planets.at(idx);
+        v3SetZero(t_aut);
+    }
+
+    const int numLat = this->numLats.at(idx);
+    const int numLon = this->numLons.at(idx);
+    const size_t cellCount = (size_t) numLat * numLon;
+    grid.nHat_x.resize(cellCount);
+    grid.nHat_y.resize(cellCount);
+    grid.nHat_z.resize(cellCount);
+    grid.area.resize(cellCount);
+    grid.albedo.resize(cellCount);
+
+    //! - The area of a cell only depends on its latitude
+    std::vector<double> latitudeArea(numLat);
+    for (int ilat = 0; ilat < numLat; ilat++) {
+        double lat1 = this->gdlat[idx][ilat] + 0.5 * this->latDiff[idx];
+        double lat2 = this->gdlat[idx][ilat] - 0.5 * this->latDiff[idx];
+        if (authalicLatitude) {
+            //! - Truncated series expansion relating geodetic to authalic latitude
+            lat1 -= t_aut[0] * sin(2.0 * lat1) - t_aut[1] * sin(4.0 * lat1) + t_aut[2] * sin(6.0 * lat1);
+            lat2 -= t_aut[0] * sin(2.0 * lat2) - t_aut[1] * sin(4.0 * lat2) + t_aut[2] * sin(6.0 * lat2);
+        }
+        latitudeArea[ilat] = fabs(this->lonDiff[idx]) * fabs(sin(lat1) - sin(lat2)) * grid.radius * grid.radius;
+    }
+
+    //! - The cell normals assume that the planet is a sphere, as LLA2PCI with the authalic radius
+    for (int ilon = 0; ilon < numLon; ilon++) {
+        double lon = this->gdlon[idx][ilon];
+        for (int ilat = 0; ilat < numLat; ilat++) {
+            double lat = this->gdlat[idx][ilat];
+            size_t cell = (size_t) ilon * numLat + ilat;
+            grid.nHat_x[cell] = cos(lat) * cos(lon);
+            grid.nHat_y[cell] = cos(lat) * sin(lon);
+            grid.nHat_z[cell] = sin(lat);
+            grid.area[cell] = latitudeArea[ilat];
+            grid.albedo[cell] = this->albArray.at(idx) ? this->ALB[idx][ilat][ilon] : this->ALB_avgs.at(idx);
+        }
+    }
+
+    //! - Sort the cells by tile of the cell index, so that the cells above a horizon form a few contiguous ranges
+    std::vector<Eigen::Vector3d> normals(cellCount);
+    for (size_t cell = 0; cell < cellCount; cell++) {
+        normals[cell] = Eigen::Vector3d(grid.nHat_x[cell], grid.nHat_y[cell], grid.nHat_z[cell]);
+    }
+    grid.cellIndex.build(normals);
+    const std::vector<uint32_t> &order = grid.cellIndex.getOrder();
+    for (std::vector<double> *values : {&grid.nHat_x, &grid.nHat_y, &grid.nHat_z, &grid.area, &grid.albedo}) {
+        std::vector<double> ordered(cellCount);
+        for (size_t position = 0; position < cellCount; position++) {
+            ordered[position] = (*values)[order[position]];
+        }
+        values->swap(ordered);
+    }
+}
+
 /*! This method calculates the albedo at instrument
  @return void
  */
-void Albedo::computeAlbedo(int idx, int instIdx, SpicePlanetStateMsgPayload planetMsg, bool albArray, double outData[]) {
+void Albedo::computeAlbedo(int idx, int instIdx, SpicePlanetStateMsgPayload planetMsg, double outData[]) {
     //! - Letters denoting the frames:
     //! - P: planet frame
     //! - B: spacecraft body frame
@@ -518,35 +612,16 @@ void Albedo::computeAlbedo(int idx, int instIdx, SpicePlanetStateMsgPayload plan
     Eigen::Matrix3d dcm_BN = this->sigma_BN.toRotationMatrix().transpose(); //! - inertial to sc body transformation
     this->nHat_N = dcm_BN.transpose() * nHat_B;                             //! - instrument's normal vector (inertial)
     //! - [m] sun's position wrt planet (inertial)
-    auto r_SP_N = this->r_SN_N - this->r_PN_N;
+    Eigen::Vector3d r_SP_N = this->r_SN_N - this->r_PN_N;
     //! - Vectors related to spacecraft
-    auto r_BP_N = this->r_BN_N - this->r_PN_N;        //! - [m] spacecraft's position wrt planet (inertial)
+    Eigen::Vector3d r_BP_N = this->r_BN_N - this->r_PN_N;  //! - [m] spacecraft's position wrt planet (inertial)
     //! - Vectors related to instrument
-    auto r_IB_N = dcm_BN.transpose() * r_IB_B;        //! - [m] instrument's position vector wrt spacecraft (inertial)
-    auto r_IP_N = r_IB_N + r_BP_N;                    //! - [m] instrument's position vector wrt planet (inertial)
-    this->rHat_PI_N = -r_IP_N / r_IP_N.norm();        //! - [-] direction vector from instrument to planet (inertial)
-    auto r_SI_N = r_SP_N - r_IP_N;                    //! - [m] sun's position wrt instrument (inertial)
-    //! - Calculate the authalic radius, if the polar radius available
-    double t[3], t_aut[3], e, RA_planet, shadowFactorAtdA;
-    if (this->RP_planets.at(idx) > 0.0) {
-        e = sqrt(1 - pow(this->RP_planets.at(idx), 2) / pow(this->REQ_planets.at(idx), 2));
-        t[0] = pow(this->REQ_planets.at(idx), 2) * 0.5;
-        t[1] = (1 - e * e) / 2.0 / e;
-        t[2] = log((1 + e) / (1 - e));
-        RA_planet = sqrt(t[0] * (1 + t[1] * t[2]));  //! - Autalic radius of the planet
-        //! - Truncated series expansion for geodetic to authalic latitude
-        t_aut[0] = pow(e, 2) / 3.0 + 31.0 * pow(e, 4) / 180.0 + 59.0 * pow(e, 6) / 560.0;
-        t_aut[1] = 17.0 * pow(e, 4) / 360.0 + 61.0 * pow(e, 6) / 1260.0;
-        t_aut[2] = 383.0 * pow(e, 6) / 45360.0;
-    }
-    else {
-        RA_planet = this->REQ_planets.at(idx);
-        v3SetZero(t_aut);
-    }
-    //! - Spacecraft's lla position (lat [rad], lon[rad], alti[m])
-    auto LLA_B = PCI2LLA(r_BP_N, planetMsg.J20002Pfix, RA_planet);
-    this->scLat = LLA_B[0] * 180 / M_PI;
-    this->scLon = LLA_B[1] * 180 / M_PI;
+    Eigen::Vector3d r_IB_N = dcm_BN.transpose() * r_IB_B;  //! - [m] instrument's position vector wrt spacecraft (inertial)
+    Eigen::Vector3d r_IP_N = r_IB_N + r_BP_N;              //! - [m] instrument's position vector wrt planet (inertial)
+    this->rHat_PI_N = -r_IP_N / r_IP_N.norm();             //! - [-] direction vector from instrument to planet (inertial)
+    Eigen::Vector3d r_SI_N = r_SP_N - r_IP_N;              //! - [m] sun's position wrt instrument (inertial)
+    const AlbedoGrid &grid = this->albedoGrids.at(idx);
+    double RA_planet = grid.radius;                        //! - [m] authalic radius of the planet
     //! - [m] altitude of the instrument
     auto alti_I = r_IP_N.norm() - RA_planet;
     /* Return zeross if the rate of the instrument's altitude
@@ -559,85 +634,56 @@ void Albedo::computeAlbedo(int idx, int instIdx, SpicePlanetStateMsgPayload plan
         outData[3] = 0.0;
     }
     else {
-        //! - Variable definitions needed for the albedo calculations
-        Eigen::Vector3d gdlla;
-        Eigen::Vector3d r_dAP_N, r_SdA_N, r_IdA_N;
-        Eigen::Vector3d rHat_dAP_N, sHat_SdA_N, rHat_IdA_N;
-        int ilat = 0, ilon = 0, IIdx = 0;  // index
-        double lon1 = 0.0, lon2 = 0.0, lat1 = 0.0, lat2 = 0.0, tempmax = 0.0, tempfov = 0.0;
-        double f1 = 0.0, f2 = 0.0, f3 = 0.0;
-        double dArea = 0.0, alb_I = 0.0, alb_Imax = 0.0;
-        std::vector< double > albLon1, albLat1;
-        for (ilon = 0; ilon < this->numLons.at(idx); ilon++) {
-            lon1 = this->gdlon[idx][ilon] + 0.5 * this->lonDiff[idx];
-            lon2 = this->gdlon[idx][ilon] - 0.5 * this->lonDiff[idx];
-            for (ilat = 0; ilat < this->numLats.at(idx); ilat++) {
-                lat1 = this->gdlat[idx][ilat] + 0.5 * this->latDiff[idx];
-                lat2 = this->gdlat[idx][ilat] - 0.5 * this->latDiff[idx];
-                if (this->RP_planets.at(idx) > 0.0) {
-                    //! - Truncated series expansion relating geodetic to authalic latitude
-                    lat1 -= t_aut[0] * sin(2.0 * lat1) - t_aut[1] * sin(4.0 * lat1) + t_aut[2] * sin(6.0 * lat1);
-                    lat2 -= t_aut[0] * sin(2.0 * lat2) - t_aut[1] * sin(4.0 * lat2) + t_aut[2] * sin(6.0 * lat2);
-                }
-                gdlla[0] = this->gdlat[idx][ilat]; gdlla[1] = this->gdlon[idx][ilon]; gdlla[2] = 0.0;
-                //! - Vectors related to incremental area
-                //! - [m] position of the incremental area (inertial)
-                r_dAP_N = LLA2PCI(gdlla, planetMsg.J20002Pfix, RA_planet); //! - Assumes that the planet is a sphere.
-                r_SdA_N = r_SP_N - r_dAP_N;            //! - [m] position vector from dA to Sun (inertial)
-                r_IdA_N = r_IP_N - r_dAP_N;            //! - [m] position vector from dA to instrument (inertial)
-                rHat_dAP_N = r_dAP_N / r_dAP_N.norm(); //! - [-] -assuming- dA normal vector (inertial) 
-                sHat_SdA_N = r_SdA_N / r_SdA_N.norm(); //! - [-] sun direction vector from dA (inertial)
-                rHat_IdA_N = r_IdA_N / r_IdA_N.norm(); //! - [-] dA to instrument direction vector (inertial)
-                //! - Portions of the planet
-                f1 = rHat_dAP_N.dot(sHat_SdA_N);       //! - for sunlit
-                f2 = rHat_dAP_N.dot(rHat_IdA_N);       //! - for instrument's max fov
-                f3 = this->nHat_N.dot(-rHat_IdA_N);    //! - for instrument's config fov
-                //! - Detect the sunlit region of the planet seen by the instrument
-                if (f1 > 0 && f2 > 0) {
-                    //! - Sunlit portion of the planet seen by the instrument's position (max)
-                    //! - Shadow factor at dA (optional)
-                    shadowFactorAtdA = this->shadowFactorAtdA;
-                    if (this->eclipseCase) { shadowFactorAtdA = computeEclipseAtdA(RA_planet, r_dAP_N, r_SP_N); }
-                    //! - Area of the incremental area
-                    dArea = (fabs(lon1 - lon2) * fabs(sin(lat1) - sin(lat2)) * pow(r_dAP_N.norm(), 2));
-                    //! - Maximum albedo flux ratio at instrument's position [-]
-                    tempmax = f1 * f2 * dArea / (pow(r_IdA_N.norm(), 2) * M_PI);
-                    //if (this->ALB_data >= 0.0) { tempmax = this->ALB_data * tempmax; }
-                    if (albArray == false) {
-                        tempmax = this->ALB_avgs.at(idx) * tempmax;
-                    }
-                    else {
-                        tempmax = this->ALB[idx][ilat][ilon] * tempmax;
-                    }
-                    alb_Imax = alb_Imax + tempmax * shadowFactorAtdA;
-
-                    if (f3 >= cos(fov)) {
-                        //! - Sunlit portion of the planet seen by the instrument (fov)
-                        //! - Albedo flux ratio at instrument's position [-]
-                        tempfov = f1 * f2 * f3 * dArea / (pow(r_IdA_N.norm(), 2) * M_PI);
-                        if (albArray == false) {
-                            tempfov = this->ALB_avgs.at(idx) * tempfov;
-                        }
-                        else {
-                            tempfov = this->ALB[idx][ilat][ilon] * tempfov;
-                        }
-                        alb_I = alb_I + tempfov * shadowFactorAtdA;
-                        albLon1.push_back(this->gdlon[idx][ilon] * 180 / M_PI);
-                        albLat1.push_back(this->gdlat[idx][ilat] * 180 / M_PI);
-                        IIdx++;
-                    }
+        //! - The cells are fixed in the planet frame, so the instrument, sun and instrument normal are rotated
+        //!   into the planet frame instead of rotating every cell into the inertial frame
+        Eigen::Matrix3d dcm_PN = c2DArray2EigenMatrix3d(planetMsg.J20002Pfix);
+        Eigen::Vector3d r_IP_P = dcm_PN * r_IP_N;
+        Eigen::Vector3d r_SP_P = dcm_PN * r_SP_N;
+        Eigen::Vector3d nHat_P = dcm_PN * this->nHat_N;
+        double cosFov = cos(fov);
+
+        //! - Only the cells in the cap above the instrument's horizon can contribute
+        double horizonAngle = r_IP_P.norm() > RA_planet ? acos(RA_planet / r_IP_P.norm()) : M_PI;
+        grid.cellIndex.findCandidates(r_IP_P, horizonAngle, this->candidateRanges);
+        size_t candidateCount = 0;
+        for (const auto& range : this->candidateRanges) {
+            candidateCount += range.end - range.begin;
+        }
+        //! - Sums the candidate cells [first, last), counted over the candidate ranges
+        auto sumCandidates = [&](size_t first, size_t last, double &sumImax, double &sumI) {
+            size_t offset = 0;
+            for (const auto& range : this->candidateRanges) {
+                size_t begin = std::max(first, offset);
+                size_t end = std::min(last, offset + range.end - range.begin);
+                if (begin < end) {
+                    this->addCellContributions(idx, range.begin + begin - offset, range.begin + end - offset,
+                                               r_IP_P, r_SP_P, nHat_P, cosFov, sumImax, sumI);
                 }
+                offset += range.end - range.begin;
             }
+        };
+
+        double alb_Imax = 0.0, alb_I = 0.0;
+        const size_t threads = std::max<size_t>(1, std::min<size_t>(this->threadCount, candidateCount / minimumCellsPerThread));
+        if (threads == 1) {
+            sumCandidates(0, candidateCount, alb_Imax, alb_I);
         }
-        //! - The sunlit area seen by the instrument fov
-        auto num1 = new double[IIdx];
-        auto num2 = new double[IIdx];
-        for (int i = 0; i < IIdx; i++) {
-            num1[i] = albLon1[i];
-            num2[i] = albLat1[i];
+        else {
+            /* Each thread sums a contiguous block of candidate cells. Partial sums are added in block order,
+               so that the result does not depend on thread timing. The threads are kept between updates. */
+            if (!this->threadPool || this->threadPool->getThreadCount() != this->threadCount) {
+                this->threadPool = std::make_unique<ThreadPool>(this->threadCount);
+            }
+            std::vector<double> partialImax(threads, 0.0), partialI(threads, 0.0);
+            this->threadPool->parallelFor(threads, [&](size_t block) {
+                sumCandidates(candidateCount * block / threads, candidateCount * (block + 1) / threads,
+                              partialImax[block], partialI[block]);
+            });
+            for (size_t block = 0; block < threads; block++) {
+                alb_Imax += partialImax[block];
+                alb_I += partialI[block];
+            }
         }
-        this->albLon = cArray2EigenMatrixXd(num1, 1, IIdx);
-        this->albLat = cArray2EigenMatrixXd(num2, 1, IIdx);
         //! - Total albedo flux ratio [-]
         auto albedoAtInstrumentMax = alb_Imax;
         auto albedoAtInstrument = alb_I;
@@ -654,10 +700,63 @@ void Albedo::computeAlbedo(int idx, int instIdx, SpicePlanetStateMsgPayload plan
     return;
 }
 
+/*! This method adds the albedo of the grid cells [firstCell, lastCell) of a planet seen by the instrument.  All
+ vectors are in the planet frame.
+ @return void
+ */
+void Albedo::addCellContributions(int idx, size_t firstCell, size_t lastCell, const Eigen::Vector3d &r_IP_P,
+                                  const Eigen::Vector3d &r_SP_P, const Eigen::Vector3d &nHat_P, double cosFov,
+                                  double &alb_Imax, double &alb_I) const
+{
+    const AlbedoGrid &grid = this->albedoGrids[idx];
+    const double RA_planet = grid.radius;
+    const double *nHat_x = grid.nHat_x.data();
+    const double *nHat_y = grid.nHat_y.data();
+    const double *nHat_z = grid.nHat_z.data();
+    uint32_t visibleCells[cellBatchSize];
+
+    for (size_t batchStart = firstCell; batchStart < lastCell; batchStart += cellBatchSize) {
+        const size_t batchEnd = std::min(batchStart + cellBatchSize, lastCell);
+        //! - Cull the cells below the horizon of the instrument or of the sun, whose heights above the cell
+        //!   plane are the dot products of the cell normal with the instrument and sun positions minus the radius
+        size_t visibleCount = 0;
+        for (size_t cell = batchStart; cell < batchEnd; cell++) {
+            double heightI = nHat_x[cell] * r_IP_P[0] + nHat_y[cell] * r_IP_P[1] + nHat_z[cell] * r_IP_P[2] - RA_planet;
+            double heightS = nHat_x[cell] * r_SP_P[0] + nHat_y[cell] * r_SP_P[1] + nHat_z[cell] * r_SP_P[2] - RA_planet;
+            visibleCells[visibleCount] = (uint32_t) (cell - batchStart);
+            visibleCount += (heightI > 0.0) & (heightS > 0.0);
+        }
+
+        for (size_t v = 0; v < visibleCount; v++) {
+            const size_t cell = batchStart + visibleCells[v];
+            Eigen::Vector3d rHat_dAP_P(nHat_x[cell], nHat_y[cell], nHat_z[cell]);  //! - [-] dA normal vector
+            Eigen::Vector3d r_dAP_P = RA_planet * rHat_dAP_P;  //! - [m] position of the incremental area
+            Eigen::Vector3d r_SdA_P = r_SP_P - r_dAP_P;        //! - [m] position vector from dA to Sun
+            Eigen::Vector3d r_IdA_P = r_IP_P - r_dAP_P;        //! - [m] position vector from dA to instrument
+            double distanceIdA2 = r_IdA_P.squaredNorm();
+            double distanceIdA = sqrt(distanceIdA2);
+            //! - Portions of the planet
+            double f1 = rHat_dAP_P.dot(r_SdA_P) / r_SdA_P.norm();  //! - for sunlit
+            double f2 = rHat_dAP_P.dot(r_IdA_P) / distanceIdA;    //! - for instrument's max fov
+            double f3 = -nHat_P.dot(r_IdA_P) / distanceIdA;       //! - for instrument's config fov
+            //! - Shadow factor at dA (optional)
+            double shadowFactorAtdA = this->shadowFactorAtdA;
+            if (this->eclipseCase) { shadowFactorAtdA = computeEclipseAtdA(RA_planet, r_dAP_P, r_SP_P); }
+            //! - Maximum albedo flux ratio at instrument's position [-]
+            double tempmax = grid.albedo[cell] * f1 * f2 * grid.area[cell] / (distanceIdA2 * M_PI);
+            alb_Imax += tempmax * shadowFactorAtdA;
+            if (f3 >= cosFov) {
+                //! - Albedo flux ratio at instrument's position [-]
+                alb_I += tempmax * f3 * shadowFactorAtdA;
+            }
+        }
+    }
+}
+
 /*! This method computes eclipse at the incremental area if eclipseCase is defined true
  @return double
  */
-double Albedo::computeEclipseAtdA(double Rplanet, Eigen::Vector3d r_dAP_N, Eigen::Vector3d r_SP_N)
+double Albedo::computeEclipseAtdA(double Rplanet, Eigen::Vector3d r_dAP_N, Eigen::Vector3d r_SP_N) const
 {
     //! - Compute the shadow factor at incremental area
     //! - Note that the eclipse module computes the shadow factor at the spacecraft position
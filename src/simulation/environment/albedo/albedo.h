@@ -28,6 +28,7 @@
 #include <inttypes.h>
 #include <vector>
 #include <string>
+#include <memory>
 #include "architecture/_GeneralModuleFiles/sys_model.h"
 // Utilities
 #include "architecture/utilities/astroConstants.h"
@@ -43,6 +44,7 @@
 #include "architecture/messaging/messaging.h"
 
 #include "architecture/utilities/macroDefinitions.h"
+#include "simulation/environment/_GeneralModuleFiles/planetSurfaceIndex.h"
 
 /*! albedo instrument configuration class */
 typedef class Config {
@@ -55,6 +57,8 @@ public:
 } instConfig_t;
 
 /*! @brief albedo class */
+class ThreadPool;
+
 class Albedo : public SysModel {
 public:
     Albedo();
@@ -75,8 +79,12 @@ private:
     void writeMessages(uint64_t CurrentSimNanos);             //!< writes the outpus messages
     void getPlanetRadius(std::string planetSpiceName);        //!< gets the planet's radius
     void evaluateAlbedoModel(int idx);                        //!< evaluates the ALB model
-    void computeAlbedo(int idx, int instIdx, SpicePlanetStateMsgPayload planetMsg, bool AlbArray, double outData[]); //!< computes the albedo at instrument's location
-    double computeEclipseAtdA(double Rplanet, Eigen::Vector3d r_dAP_N, Eigen::Vector3d r_SP_N); //!< computes the shadow factor at dA
+    void computeAlbedoGrid(int idx);                          //!< computes the planet-fixed geometry of the grid cells
+    void computeAlbedo(int idx, int instIdx, SpicePlanetStateMsgPayload planetMsg, double outData[]); //!< computes the albedo at instrument's location
+    void addCellContributions(int idx, size_t firstCell, size_t lastCell, const Eigen::Vector3d &r_IP_P,
+                              const Eigen::Vector3d &r_SP_P, const Eigen::Vector3d &nHat_P, double cosFov,
+                              double &alb_Imax, double &alb_I) const; //!< sums the albedo of a range of grid cells
+    double computeEclipseAtdA(double Rplanet, Eigen::Vector3d r_dAP_N, Eigen::Vector3d r_SP_N) const; //!< computes the shadow factor at dA
 
 public:
     std::vector<Message<AlbedoMsgPayload>*> albOutMsgs;         //!< vector of output messages for albedo data
@@ -92,15 +100,26 @@ public:
     bool eclipseCase;                           //!< consider eclipse at dA, if true
     double shadowFactorAtdA;                    //!< [-] shadow factor at incremental area
     double altitudeRateLimit;                   //!< [-] rate limit of the instrument's altitude to the planet's radius for albedo calculations
+    size_t threadCount;                         //!< [-] number of threads summing the grid cells of a planet, 1 by default
 
 private:
+    /*! Planet-fixed geometry of the albedo grid cells of a planet, stored one array per quantity in the order of
+     the tiles of the cell index */
+    struct AlbedoGrid {
+        double radius = 0.0;                //!< [m] authalic radius of the planet
+        std::vector<double> nHat_x;         //!< [-] x component of the unit normal of the cells (planet-fixed)
+        std::vector<double> nHat_y;         //!< [-] y component of the unit normal of the cells (planet-fixed)
+        std::vector<double> nHat_z;         //!< [-] z component of the unit normal of the cells (planet-fixed)
+        std::vector<double> area;           //!< [m^2] area of the cells
+        std::vector<double> albedo;         //!< [-] albedo coefficient of the cells
+        PlanetSurfaceIndex cellIndex;       //!< spatial index of the cell normals
+    };
+
     std::vector<std::string> dataPaths;           //!< string with the path to the ALB coefficient folder
     std::vector<std::string> fileNames;           //!< file names containing the ALB coefficients
     std::vector<std::string> modelNames;          //!< albedo model names
     std::vector<double> ALB_avgs;                 //!< [-] albedo average value vector for each planet defined
     std::vector<double> REQ_planets, RP_planets;  //!< [m] equatorial and polar radius of the planets
-    Eigen::MatrixXd albLon, albLat;          //!< sunlit area seen by the instroment fov
-    double scLon, scLat;                     //!< [deg, deg] spaceccraft footprint
     std::vector<int> numLats, numLons;       //!< [-] vector of latitude and longitude number
     double albedoAtInstrument;               //!< [-] total albedo at instrument location
     double albedoAtInstrumentMax;            //!< [-] max total albedo at instrument location
@@ -116,6 +135,9 @@ private:
     std::map < int, double > latDiff;               //!< [rad] latitude difference between grid points
     std::map < int, double > lonDiff;               //!< [rad] longitude difference between grid points
     std::map < int, std::vector < std::vector < double > > > ALB; //!< [-] ALB coefficients
+    std::vector<AlbedoGrid> albedoGrids;    //!< planet-fixed geometry of the grid cells of each planet
+    std::vector<PlanetSurfaceIndex::IndexRange> candidateRanges;  //!< cells of a planet above the instrument's horizon
+    std::unique_ptr<ThreadPool> threadPool;  //!< threads summing the grid cells, kept between updates, null if serial
     bool readFile;                          //!< defines if there is a need for reading an albedo model file or not
     std::vector<bool> albArray;             //!< defines if the albedo data is formatted as array or not
     Eigen::Vector3d r_PN_N;                 //!< [m] planet position (inertial)
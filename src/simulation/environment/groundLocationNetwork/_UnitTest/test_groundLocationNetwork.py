@@ -0,0 +1,177 @@
+# ISC License
+#
+# Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+import numpy as np
+import pytest
+from Basilisk.simulation import groundLocation
+from Basilisk.simulation import groundLocationNetwork
+from Basilisk.simulation import spacecraft
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import orbitalMotion
+from Basilisk.utilities import simIncludeGravBody
+
+locations = [[np.radians(0.), np.radians(0.), 0.],
+             [np.radians(20.), np.radians(30.), 500.],
+             [np.radians(-35.), np.radians(-10.), 0.],
+             [np.radians(45.), np.radians(60.), 1000.]]
+orbits = [[7000e3, 0.001, 10.], [6900e3, 0.01, 45.], [7200e3, 0.0, 60.]]
+simulationTime = 6000.
+
+
+def runNetwork(timeStep, maximumRange, onlyWriteAccessChanges=False):
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(timeStep)))
+
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createEarth()
+    earth.isCentralBody = True
+
+    scObjects = []
+    for i, (a, e, inc) in enumerate(orbits):
+        scObject = spacecraft.Spacecraft()
+        scObject.ModelTag = "sc" + str(i)
+        gravFactory.addBodiesTo(scObject)
+        oe = orbitalMotion.ClassicElements()
+        oe.a = a
+        oe.e = e
+        oe.i = np.radians(inc)
+        oe.Omega = np.radians(10. * i)
+        oe.omega = 0.
+        oe.f = np.radians(-20. * i)
+        rN, vN = orbitalMotion.elem2rv(earth.mu, oe)
+        scObject.hub.r_CN_NInit = rN
+        scObject.hub.v_CN_NInit = vN
+        scSim.AddModelToTask("simTask", scObject)
+        scObjects.append(scObject)
+
+    network = groundLocationNetwork.GroundLocationNetwork()
+    network.ModelTag = "network"
+    network.minimumElevation = np.radians(10.)
+    network.maximumRange = maximumRange
+    network.onlyWriteAccessChanges = onlyWriteAccessChanges
+    for lat, lon, alt in locations:
+        network.addLocation(lat, lon, alt)
+    for scObject in scObjects:
+        network.addSpacecraftToModel(scObject.scStateOutMsg)
+    scSim.AddModelToTask("simTask", network)
+
+    # one groundLocation per location as the reference of the access messages
+    references = []
+    for i, (lat, lon, alt) in enumerate(locations):
+        groundTarget = groundLocation.GroundLocation()
+        groundTarget.ModelTag = "groundTarget" + str(i)
+        groundTarget.minimumElevation = np.radians(10.)
+        groundTarget.maximumRange = maximumRange
+        groundTarget.specifyLocation(lat, lon, alt)
+        for scObject in scObjects:
+            groundTarget.addSpacecraftToModel(scObject.scStateOutMsg)
+        scSim.AddModelToTask("simTask", groundTarget)
+        references.append(groundTarget)
+
+    networkLogs = [[network.getAccessOutMsg(l, s).recorder() for s in range(len(orbits))]
+                   for l in range(len(locations))]
+    referenceLogs = [[ref.accessOutMsgs[s].recorder() for s in range(len(orbits))] for ref in references]
+    for logs in networkLogs + referenceLogs:
+        for dataLog in logs:
+            scSim.AddModelToTask("simTask", dataLog)
+
+    # the events of each update are read after it
+    events = []
+    scSim.InitializeSimulation()
+    for step in range(int(simulationTime / timeStep) + 1):
+        scSim.ConfigureStopTime(macros.sec2nano(step * timeStep))
+        scSim.ExecuteSimulation()
+        eventsMsg = network.accessEventsOutMsg.read()
+        events += list(zip(eventsMsg.locationIndex, eventsMsg.spacecraftIndex, eventsMsg.hasAccess,
+                           eventsMsg.eventTimes))
+
+    return networkLogs, referenceLogs, events
+
+
+@pytest.mark.parametrize("maximumRange", [-1., 1500e3])
+def test_groundLocationNetwork(maximumRange):
+    r"""
+    **Validation Test Description**
+
+    Three spacecraft in low Earth orbits pass over four ground locations.  The access of every pair is computed by a
+    ground location network, and by one groundLocation module per location.  The network is run with a 10 second
+    and a 1 second time step, with and without a maximum range.
+
+    **Description of Variables Being Tested**
+
+    The access messages of the network must match those of groundLocation within 1e-6 relative accuracy, with the same
+    ``hasAccess``.  The access events must alternate between starts and ends for each pair, must agree with the
+    changes of ``hasAccess``, and the event times found with a 10 second step must match those found with a 1 second
+    step within 0.01 seconds.
+    """
+    networkLogs, referenceLogs, events = runNetwork(10., maximumRange)
+    _, _, fineEvents = runNetwork(1., maximumRange)
+
+    for l in range(len(locations)):
+        for s in range(len(orbits)):
+            networkLog = networkLogs[l][s]
+            referenceLog = referenceLogs[l][s]
+            np.testing.assert_array_equal(networkLog.hasAccess, referenceLog.hasAccess)
+            np.testing.assert_allclose(networkLog.slantRange, referenceLog.slantRange, rtol=1e-6)
+            np.testing.assert_allclose(networkLog.elevation, referenceLog.elevation, rtol=0, atol=1e-6)
+            np.testing.assert_allclose(networkLog.r_BL_L, referenceLog.r_BL_L, rtol=0, atol=1e-3)
+            np.testing.assert_allclose(networkLog.v_BL_L, referenceLog.v_BL_L, rtol=0, atol=1e-6)
+
+            # the events of the pair follow the changes of hasAccess
+            times = networkLog.times() * macros.NANO2SEC
+            pairEvents = [(hasAccess, t) for (el, es, hasAccess, t) in events if el == l and es == s]
+            changes = np.flatnonzero(np.diff(np.concatenate(([0], networkLog.hasAccess))))
+            assert len(pairEvents) == len(changes)
+            for (hasAccess, eventTime), change in zip(pairEvents, changes):
+                assert hasAccess == networkLog.hasAccess[change]
+                assert times[max(change - 1, 0)] <= eventTime <= times[change]
+
+    assert len(events) > 0
+    assert len(events) == len(fineEvents)
+    for event, fineEvent in zip(sorted(events), sorted(fineEvents)):
+        assert event[:3] == fineEvent[:3]
+        assert event[3] == pytest.approx(fineEvent[3], abs=0.01)
+
+
+def test_groundLocationNetworkAccessChanges():
+    r"""
+    **Validation Test Description**
+
+    The network of the previous test is run with ``onlyWriteAccessChanges`` set.
+
+    **Description of Variables Being Tested**
+
+    The access message of each pair must only be written at the first update and when ``hasAccess`` changes, and each
+    write must hold the same ``hasAccess`` as groundLocation.
+    """
+    networkLogs, referenceLogs, _ = runNetwork(10., -1., onlyWriteAccessChanges=True)
+
+    for l in range(len(locations)):
+        for s in range(len(orbits)):
+            networkLog = networkLogs[l][s]
+            referenceLog = referenceLogs[l][s]
+            referenceAccess = np.array(referenceLog.hasAccess)
+            changes = np.concatenate(([0], np.flatnonzero(np.diff(referenceAccess)) + 1))
+            writeTimes, writeRecords = np.unique(networkLog.timesWritten(), return_index=True)
+            np.testing.assert_array_equal(writeTimes, referenceLog.times()[changes])
+            np.testing.assert_array_equal(np.array(networkLog.hasAccess)[writeRecords], referenceAccess[changes])
+
+
+if __name__ == "__main__":
+    test_groundLocationNetwork(1500e3)
+    test_groundLocationNetworkAccessChanges()
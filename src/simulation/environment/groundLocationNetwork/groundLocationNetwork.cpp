@@ -0,0 +1,416 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "simulation/environment/groundLocationNetwork/groundLocationNetwork.h"
+#include "architecture/utilities/avsEigenSupport.h"
+#include "architecture/utilities/linearAlgebra.h"
+#include "architecture/utilities/macroDefinitions.h"
+#include <algorithm>
+
+namespace {
+    // Number of bisections locating an access start or end, which brings the error below 1e-15 of the update period
+    constexpr int crossingBisections = 50;
+
+    /*! Finds the zero of a function between two updates from its values g0, g1 and rates gdot0, gdot1 at the
+     updates, which differ in sign.  The function is interpolated by the cubic Hermite polynomial of these values.
+     @return fraction of the update period at which the function crosses zero
+     */
+    double findCrossing(double g0, double gdot0, double g1, double gdot1, double dt)
+    {
+        auto hermite = [&](double tau) {
+            double tau2 = tau * tau;
+            double tau3 = tau2 * tau;
+            return (2.0 * tau3 - 3.0 * tau2 + 1.0) * g0 + (tau3 - 2.0 * tau2 + tau) * dt * gdot0
+                   + (-2.0 * tau3 + 3.0 * tau2) * g1 + (tau3 - tau2) * dt * gdot1;
+        };
+        double lower = 0.0;
+        double upper = 1.0;
+        bool lowerPositive = g0 > 0.0;
+        for (int i = 0; i < crossingBisections; i++) {
+            double middle = 0.5 * (lower + upper);
+            if ((hermite(middle) > 0.0) == lowerPositive) {
+                lower = middle;
+            }
+            else {
+                upper = middle;
+            }
+        }
+        return 0.5 * (lower + upper);
+    }
+}
+
+/*! @brief Creates an instance of the GroundLocationNetwork class with a minimum elevation of 10 degrees,
+ @return void
+ */
+GroundLocationNetwork::GroundLocationNetwork()
+{
+    //! - Set some default initial conditions:
+    this->minimumElevation = 10.*D2R; // [rad] minimum elevation above the local horizon needed to see a spacecraft; defaults to 10 degrees
+    this->maximumRange = -1; // [m] Maximum range for the locations to compute access.
+    this->onlyWriteAccessChanges = false;
+
+    this->planetRadius = REQ_EARTH*1e3;
+
+    this->planetState = this->planetInMsg.zeroMsgPayload;
+    this->planetState.J20002Pfix[0][0] = 1;
+    this->planetState.J20002Pfix[1][1] = 1;
+    this->planetState.J20002Pfix[2][2] = 1;
+
+    this->previousClock = 0;
+    this->hasPreviousStates = false;
+}
+
+/*! Module destructor, deleting the output messages
+ @return void
+ */
+GroundLocationNetwork::~GroundLocationNetwork()
+{
+    for (auto& locationMsgs : this->accessOutMsgs) {
+        for (auto msg : locationMsgs) {
+            delete msg;
+        }
+    }
+    for (auto msg : this->currentGroundStateOutMsgs) {
+        delete msg;
+    }
+}
+
+/*! Sizes the arrays of the access quantities
+ @param pairCount number of location and spacecraft pairs
+ */
+void GroundLocationNetwork::PairStates::resize(size_t pairCount)
+{
+    for (std::vector<double> *values : {&this->slantRange, &this->elevation, &this->azimuth, &this->range_dot,
+                                        &this->el_dot, &this->az_dot}) {
+        values->resize(pairCount);
+    }
+    for (int i = 0; i < 3; i++) {
+        this->r_BL_L[i].resize(pairCount);
+        this->v_BL_L[i].resize(pairCount);
+    }
+    this->hasAccess.resize(pairCount);
+}
+
+/*! Resets the access history, so that no access ends are reported at the first update.*/
+void GroundLocationNetwork::Reset(uint64_t CurrentSimNanos)
+{
+    if (this->planetRadius < 0) {
+        bskLogger.bskLog(BSK_ERROR, "GroundLocationNetwork module must have planetRadius set.");
+    }
+    this->hasPreviousStates = false;
+}
+
+/*! Adds a location from its planet-centered latitude, longitude and altitude, with an access message for each
+ * spacecraft and a ground state message.
+ *
+ * @param lat [rad] latitude
+ * @param longitude [rad] longitude
+ * @param alt [m] altitude
+ */
+void GroundLocationNetwork::addLocation(double lat, double longitude, double alt)
+{
+    Eigen::Vector3d tmpLLAPosition(lat, longitude, alt);
+    Eigen::Vector3d r_LP_P_Loc = LLA2PCPF(tmpLLAPosition, this->planetRadius);
+    this->addLocationPCPF(r_LP_P_Loc);
+}
+
+/*! Adds a location from its planet-centered, planet-fixed coordinates, with an access message for each spacecraft
+ * and a ground state message.
+ * @param r_LP_P_Loc [m] location relative to the planet center in planet frame coordinates
+ */
+void GroundLocationNetwork::addLocationPCPF(Eigen::Vector3d& r_LP_P_Loc)
+{
+    this->r_LP_P.push_back(r_LP_P_Loc);
+
+    /* Convert to LLA to compute dcm_LP */
+    Eigen::Vector3d tmpLLAPosition = PCPF2LLA(r_LP_P_Loc, this->planetRadius);
+    this->dcm_LP.push_back(C_PCPF2SEZ(tmpLLAPosition[0], tmpLLAPosition[1]));
+
+    /* create output messages */
+    this->currentGroundStateOutMsgs.push_back(new Message<GroundStateMsgPayload>);
+    this->currentGroundStateBuffer.push_back(this->currentGroundStateOutMsgs.back()->zeroMsgPayload);
+    this->accessOutMsgs.emplace_back();
+    for (size_t c = 0; c < this->scStateInMsgs.size(); c++) {
+        this->accessOutMsgs.back().push_back(new Message<AccessMsgPayload>);
+    }
+}
+
+/*! Adds a scState message to the vector of spacecraft to track, and creates the corresponding access message of
+ * each location.
+ */
+void GroundLocationNetwork::addSpacecraftToModel(Message<SCStatesMsgPayload> *tmpScMsg)
+{
+    this->scStateInMsgs.push_back(tmpScMsg->addSubscriber());
+
+    /* create output messages */
+    for (auto& locationMsgs : this->accessOutMsgs) {
+        locationMsgs.push_back(new Message<AccessMsgPayload>);
+    }
+}
+
+/*! Returns the access message of a location and a spacecraft
+ * @param locationIndex index of the location, in the order the locations were added
+ * @param scIndex index of the spacecraft, in the order the spacecraft were added
+ * @return access message, or a null pointer if an index is out of range
+ */
+Message<AccessMsgPayload> *GroundLocationNetwork::getAccessOutMsg(size_t locationIndex, size_t scIndex)
+{
+    if (locationIndex >= this->accessOutMsgs.size() || scIndex >= this->scStateInMsgs.size()) {
+        bskLogger.bskLog(BSK_ERROR, "GroundLocationNetwork has no access message for location %zu and spacecraft %zu.",
+                         locationIndex, scIndex);
+        return nullptr;
+    }
+    return this->accessOutMsgs[locationIndex][scIndex];
+}
+
+/*! @return number of locations */
+size_t GroundLocationNetwork::getNumLocations() const
+{
+    return this->r_LP_P.size();
+}
+
+/*! @return number of spacecraft */
+size_t GroundLocationNetwork::getNumSpacecraft() const
+{
+    return this->scStateInMsgs.size();
+}
+
+/*! Read module messages
+*/
+bool GroundLocationNetwork::ReadMessages()
+{
+    /* clear out the vector of spacecraft states.  This is created freshly below. */
+    this->scStatesBuffer.clear();
+
+    //! - read in the spacecraft state messages
+    bool scRead;
+    if(!this->scStateInMsgs.empty())
+    {
+        scRead = true;
+        for (auto& scStateInMsg : this->scStateInMsgs) {
+            this->scStatesBuffer.push_back(scStateInMsg());
+            scRead = scRead && scStateInMsg.isWritten();
+        }
+    } else {
+        bskLogger.bskLog(BSK_ERROR, "Ground location network has no spacecraft to track.");
+        scRead = false;
+    }
+    //! - Read in the optional planet message.  if no planet message is set, then a zero planet position, velocity and orientation is assumed
+    bool planetRead = true;
+    if(this->planetInMsg.isLinked())
+    {
+        planetRead = this->planetInMsg.isWritten();
+        this->planetState = this->planetInMsg();
+    }
+
+    return(planetRead && scRead);
+}
+
+/*! Writes the ground states, the access of each pair and the access events.  If onlyWriteAccessChanges is set, the
+ access message of a pair is only written at the first update and when its access changes.
+*/
+void GroundLocationNetwork::WriteMessages(uint64_t CurrentClock)
+{
+    const size_t numSc = this->scStatesBuffer.size();
+    for (size_t l = 0; l < this->r_LP_P.size(); l++) {
+        this->currentGroundStateOutMsgs[l]->write(&this->currentGroundStateBuffer[l], this->moduleID, CurrentClock);
+
+        for (size_t c = 0; c < numSc; c++) {
+            size_t k = l * numSc + c;
+            if (this->onlyWriteAccessChanges && this->hasPreviousStates
+                && this->pairStates.hasAccess[k] == this->previousPairStates.hasAccess[k]) {
+                continue;
+            }
+            AccessMsgPayload accessMsg = this->accessOutMsgs[l][c]->zeroMsgPayload;
+            accessMsg.hasAccess = this->pairStates.hasAccess[k];
+            accessMsg.slantRange = this->pairStates.slantRange[k];
+            accessMsg.elevation = this->pairStates.elevation[k];
+            accessMsg.azimuth = this->pairStates.azimuth[k];
+            accessMsg.range_dot = this->pairStates.range_dot[k];
+            accessMsg.el_dot = this->pairStates.el_dot[k];
+            accessMsg.az_dot = this->pairStates.az_dot[k];
+            for (int i = 0; i < 3; i++) {
+                accessMsg.r_BL_L[i] = this->pairStates.r_BL_L[i][k];
+                accessMsg.v_BL_L[i] = this->pairStates.v_BL_L[i][k];
+            }
+            this->accessOutMsgs[l][c]->write(&accessMsg, this->moduleID, CurrentClock);
+        }
+    }
+    this->accessEventsOutMsg.write(&this->accessEventsBuffer, this->moduleID, CurrentClock);
+}
+
+/*! Updates the planet orientation and the inertial positions of the locations */
+void GroundLocationNetwork::updateInertialPositions()
+{
+    // First, get the rotation matrix from the inertial to planet frame from SPICE:
+    this->dcm_PN = cArray2EigenMatrix3d(*this->planetState.J20002Pfix);
+    this->dcm_PN_dot = cArray2EigenMatrix3d(*this->planetState.J20002Pfix_dot);
+    this->r_PN_N = cArray2EigenVector3d(this->planetState.PositionVector);
+    // Get planet frame angular velocity vector
+    Eigen::Matrix3d w_tilde_PN = - this->dcm_PN_dot * this->dcm_PN.transpose();
+    this->w_PN << w_tilde_PN(2,1), w_tilde_PN(0,2), w_tilde_PN(1,0);
+    //  Stash updated positions in the groundState messages
+    for (size_t l = 0; l < this->r_LP_P.size(); l++) {
+        Eigen::Vector3d r_LP_N = this->dcm_PN.transpose() * this->r_LP_P[l];
+        Eigen::Vector3d r_LN_N = this->r_PN_N + r_LP_N;
+        eigenVector3d2CArray(r_LN_N, this->currentGroundStateBuffer[l].r_LN_N);
+        eigenVector3d2CArray(r_LP_N, this->currentGroundStateBuffer[l].r_LP_N);
+    }
+}
+
+/*! Computes the access quantities of all location and spacecraft pairs */
+void GroundLocationNetwork::computeAccess()
+{
+    // Update the locations' inertial positions
+    this->updateInertialPositions();
+
+    //! - Spacecraft positions relative to the planet, and velocities relative to the planet frame
+    const size_t numSc = this->scStatesBuffer.size();
+    for (int i = 0; i < 3; i++) {
+        this->r_BP_N[i].resize(numSc);
+        this->v_BP_N[i].resize(numSc);
+    }
+    for (size_t c = 0; c < numSc; c++) {
+        Eigen::Vector3d r_BP_N = cArray2EigenVector3d(this->scStatesBuffer[c].r_BN_N) - this->r_PN_N;
+        Eigen::Vector3d v_BP_N = cArray2EigenVector3d(this->scStatesBuffer[c].v_BN_N) - this->w_PN.cross(r_BP_N);
+        for (int i = 0; i < 3; i++) {
+            this->r_BP_N[i][c] = r_BP_N[i];
+            this->v_BP_N[i][c] = v_BP_N[i];
+        }
+    }
+
+    const size_t pairCount = this->r_LP_P.size() * numSc;
+    if (this->previousPairStates.hasAccess.size() != pairCount) {
+        // locations or spacecraft were added since the previous update
+        this->hasPreviousStates = false;
+    }
+    this->pairStates.resize(pairCount);
+
+    //! - Loop over the locations, then over the spacecraft arrays
+    PairStates &pairs = this->pairStates;
+    for (size_t l = 0; l < this->r_LP_P.size(); l++) {
+        Eigen::Vector3d r_LP_N = this->dcm_PN.transpose() * this->r_LP_P[l];
+        Eigen::Vector3d rhat_LP_N = r_LP_N / r_LP_N.norm();
+        Eigen::Matrix3d dcm_LN = this->dcm_LP[l] * this->dcm_PN;
+        const double *r_B[3] = {this->r_BP_N[0].data(), this->r_BP_N[1].data(), this->r_BP_N[2].data()};
+        const double *v_B[3] = {this->v_BP_N[0].data(), this->v_BP_N[1].data(), this->v_BP_N[2].data()};
+
+        for (size_t c = 0; c < numSc; c++) {
+            size_t k = l * numSc + c;
+            //! - Relative position of the spacecraft to the location in the planet-centered inertial frame
+            double r_BL_N[3], v_BL_N[3];
+            for (int i = 0; i < 3; i++) {
+                r_BL_N[i] = r_B[i][c] - r_LP_N[i];
+                v_BL_N[i] = v_B[i][c];
+            }
+            double r_BL_mag = sqrt(r_BL_N[0]*r_BL_N[0] + r_BL_N[1]*r_BL_N[1] + r_BL_N[2]*r_BL_N[2]);
+            double viewAngle = M_PI_2 - safeAcos((rhat_LP_N[0]*r_BL_N[0] + rhat_LP_N[1]*r_BL_N[1]
+                                                  + rhat_LP_N[2]*r_BL_N[2]) / r_BL_mag);
+
+            //! - Position and velocity in the SEZ frame of the location
+            double r_BL_L[3], v_BL_L[3];
+            for (int i = 0; i < 3; i++) {
+                r_BL_L[i] = dcm_LN(i, 0)*r_BL_N[0] + dcm_LN(i, 1)*r_BL_N[1] + dcm_LN(i, 2)*r_BL_N[2];
+                v_BL_L[i] = dcm_LN(i, 0)*v_BL_N[0] + dcm_LN(i, 1)*v_BL_N[1] + dcm_LN(i, 2)*v_BL_N[2];
+                pairs.r_BL_L[i][k] = r_BL_L[i];
+                pairs.v_BL_L[i][k] = v_BL_L[i];
+            }
+            double xy_norm2 = r_BL_L[0]*r_BL_L[0] + r_BL_L[1]*r_BL_L[1];
+            double xy_norm = sqrt(xy_norm2);
+
+            pairs.slantRange[k] = r_BL_mag;
+            pairs.elevation[k] = viewAngle;
+            pairs.azimuth[k] = atan2(r_BL_L[1]/xy_norm, -r_BL_L[0]/xy_norm);
+            pairs.range_dot[k] = (v_BL_L[0]*r_BL_L[0] + v_BL_L[1]*r_BL_L[1] + v_BL_L[2]*r_BL_L[2])/r_BL_mag;
+            pairs.az_dot[k] = (-r_BL_L[0]*v_BL_L[1] + r_BL_L[1]*v_BL_L[0])/xy_norm2;
+            pairs.el_dot[k] = (v_BL_L[2]/xy_norm - r_BL_L[2]*(r_BL_L[0]*v_BL_L[0] + r_BL_L[1]*v_BL_L[1])/(xy_norm2*xy_norm))
+                              /(1 + r_BL_L[2]*r_BL_L[2]/xy_norm2);
+            pairs.hasAccess[k] = (viewAngle > this->minimumElevation)
+                                 && (r_BL_mag <= this->maximumRange || this->maximumRange < 0);
+        }
+    }
+}
+
+/*! Lists the pairs whose access changed since the previous update.  The time of the change is the zero of the
+ elevation above the minimum elevation, or of the range below the maximum range, interpolated between the updates.
+ At the first update, the pairs with access are listed as starting at the update time.
+ @param CurrentClock [ns] time of the update
+ */
+void GroundLocationNetwork::findAccessEvents(uint64_t CurrentClock)
+{
+    this->accessEventsBuffer.locationIndex.clear();
+    this->accessEventsBuffer.spacecraftIndex.clear();
+    this->accessEventsBuffer.hasAccess.clear();
+    this->accessEventsBuffer.eventTimes.clear();
+
+    const size_t numSc = this->scStatesBuffer.size();
+    const PairStates &now = this->pairStates;
+    const PairStates &before = this->previousPairStates;
+    const double dt = (CurrentClock - this->previousClock) * NANO2SEC;
+    for (size_t k = 0; k < now.hasAccess.size(); k++) {
+        double eventTime = CurrentClock * NANO2SEC;
+        bool starts = now.hasAccess[k] == 1;
+        if (this->hasPreviousStates) {
+            if (now.hasAccess[k] == before.hasAccess[k]) {
+                continue;
+            }
+            //! - An access starts when the last of its conditions is met, and ends when the first is not
+            double tau = starts ? 0.0 : 1.0;
+            double gElevation0 = before.elevation[k] - this->minimumElevation;
+            double gElevation1 = now.elevation[k] - this->minimumElevation;
+            if ((gElevation0 > 0.0) != (gElevation1 > 0.0)) {
+                double crossing = findCrossing(gElevation0, before.el_dot[k], gElevation1, now.el_dot[k], dt);
+                tau = starts ? std::max(tau, crossing) : std::min(tau, crossing);
+            }
+            if (this->maximumRange >= 0) {
+                double gRange0 = this->maximumRange - before.slantRange[k];
+                double gRange1 = this->maximumRange - now.slantRange[k];
+                if ((gRange0 >= 0.0) != (gRange1 >= 0.0)) {
+                    double crossing = findCrossing(gRange0, -before.range_dot[k], gRange1, -now.range_dot[k], dt);
+                    tau = starts ? std::max(tau, crossing) : std::min(tau, crossing);
+                }
+            }
+            eventTime = this->previousClock * NANO2SEC + tau * dt;
+        }
+        else if (!starts) {
+            continue;
+        }
+        this->accessEventsBuffer.locationIndex.push_back((int) (k / numSc));
+        this->accessEventsBuffer.spacecraftIndex.push_back((int) (k % numSc));
+        this->accessEventsBuffer.hasAccess.push_back(starts ? 1 : 0);
+        this->accessEventsBuffer.eventTimes.push_back(eventTime);
+    }
+}
+
+/*!
+ update module
+ @param CurrentSimNanos
+ */
+void GroundLocationNetwork::UpdateState(uint64_t CurrentSimNanos)
+{
+    this->ReadMessages();
+    this->computeAccess();
+    this->findAccessEvents(CurrentSimNanos);
+    this->WriteMessages(CurrentSimNanos);
+
+    // the states of this update are the previous states of the next one
+    std::swap(this->pairStates, this->previousPairStates);
+    this->previousClock = CurrentSimNanos;
+    this->hasPreviousStates = true;
+}
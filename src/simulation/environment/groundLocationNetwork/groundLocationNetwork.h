@@ -0,0 +1,114 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef GROUND_LOCATION_NETWORK_H
+#define GROUND_LOCATION_NETWORK_H
+
+#include <Eigen/Dense>
+#include <vector>
+#include <string>
+#include "architecture/_GeneralModuleFiles/sys_model.h"
+
+#include "architecture/msgPayloadDefC/SpicePlanetStateMsgPayload.h"
+#include "architecture/msgPayloadDefC/SCStatesMsgPayload.h"
+#include "architecture/msgPayloadDefC/AccessMsgPayload.h"
+#include "architecture/msgPayloadDefC/GroundStateMsgPayload.h"
+#include "architecture/msgPayloadDefCpp/AccessEventsMsgPayload.h"
+#include "architecture/messaging/messaging.h"
+
+#include "architecture/utilities/geodeticConversion.h"
+#include "architecture/utilities/astroConstants.h"
+#include "architecture/utilities/bskLogging.h"
+
+/*! @brief Network of ground locations computing the access of many spacecraft at once.
+
+ The access of every location and spacecraft pair is computed as in :ref:`groundLocation`, with the pair quantities
+ stored one array per quantity.  The start and end times of the accesses are found between updates and written to an
+ access events message.
+ */
+class GroundLocationNetwork:  public SysModel {
+public:
+    GroundLocationNetwork();
+    ~GroundLocationNetwork();
+    void UpdateState(uint64_t CurrentSimNanos);
+    void Reset(uint64_t CurrentSimNanos);
+    bool ReadMessages();
+    void WriteMessages(uint64_t CurrentClock);
+    void addSpacecraftToModel(Message<SCStatesMsgPayload> *tmpScMsg);
+    void addLocation(double lat, double longitude, double alt);
+    void addLocationPCPF(Eigen::Vector3d& r_LP_P_Loc);
+    Message<AccessMsgPayload> *getAccessOutMsg(size_t locationIndex, size_t scIndex);
+    size_t getNumLocations() const;
+    size_t getNumSpacecraft() const;
+
+private:
+    void updateInertialPositions();
+    void computeAccess();
+    void findAccessEvents(uint64_t CurrentClock);
+
+public:
+    double planetRadius; //!< [m] Planet radius in meters.
+    double minimumElevation; //!< [rad] minimum elevation above the local horizon needed to see a spacecraft; defaults to 10 degrees equivalent.
+    double maximumRange; //!< [m] (optional) Maximum slant range to compute access for; defaults to -1, which represents no maximum range.
+    bool onlyWriteAccessChanges; //!< (optional) Only write the access message of a pair when its access changes; defaults to false.
+
+    ReadFunctor<SpicePlanetStateMsgPayload> planetInMsg;            //!< planet state input message
+    std::vector<ReadFunctor<SCStatesMsgPayload>> scStateInMsgs;     //!< vector of sc state input messages
+    std::vector<Message<GroundStateMsgPayload>*> currentGroundStateOutMsgs;  //!< vector of ground location output messages
+    Message<AccessEventsMsgPayload> accessEventsOutMsg;             //!< access starts and ends since the previous update
+    BSKLogger bskLogger;         //!< -- BSK Logging
+
+private:
+    /*! Access quantities of all location and spacecraft pairs, the spacecraft index varying fastest */
+    struct PairStates {
+        std::vector<double> slantRange;     //!< [m] range from the location to the spacecraft
+        std::vector<double> elevation;      //!< [rad] elevation of the spacecraft
+        std::vector<double> azimuth;        //!< [rad] azimuth of the spacecraft
+        std::vector<double> range_dot;      //!< [m/s] range rate in the SEZ frame
+        std::vector<double> el_dot;         //!< [rad/s] elevation rate in the SEZ frame
+        std::vector<double> az_dot;         //!< [rad/s] azimuth rate in the SEZ frame
+        std::vector<double> r_BL_L[3];      //!< [m] spacecraft position relative to the location in the SEZ frame
+        std::vector<double> v_BL_L[3];      //!< [m/s] SEZ relative velocity of the spacecraft in the SEZ frame
+        std::vector<uint64_t> hasAccess;    //!< [-] 1 when the location has access to the spacecraft
+        void resize(size_t pairCount);      //!< sizes all the arrays
+    };
+
+    std::vector<std::vector<Message<AccessMsgPayload>*>> accessOutMsgs;  //!< access messages of each location, per spacecraft
+    std::vector<SCStatesMsgPayload> scStatesBuffer;                 //!< buffer of spacecraft states
+    SpicePlanetStateMsgPayload planetState;                         //!< buffer of planet data
+    std::vector<GroundStateMsgPayload> currentGroundStateBuffer;    //!< buffer of ground state output data
+    AccessEventsMsgPayload accessEventsBuffer;                      //!< buffer of access events output data
+
+    std::vector<Eigen::Vector3d> r_LP_P;   //!< [m] location positions relative to the planet in planet frame coordinates
+    std::vector<Eigen::Matrix3d> dcm_LP;   //!< rotation matrices from the planet frame P to the SEZ frame L of the locations
+    Eigen::Matrix3d dcm_PN; //!< Rotation matrix from inertial frame N to planet-centered to planet-fixed frame P.
+    Eigen::Matrix3d dcm_PN_dot; //!< Rotation matrix derivative from inertial frame N to planet-centered to planet-fixed frame P.
+    Eigen::Vector3d w_PN; //!< [rad/s] Angular velocity of planet-fixed frame P relative to inertial frame N.
+    Eigen::Vector3d r_PN_N; //!< [m] Planet position vector relative to inertial frame origin.
+    std::vector<double> r_BP_N[3];        //!< [m] spacecraft positions relative to the planet (inertial)
+    std::vector<double> v_BP_N[3];        //!< [m/s] spacecraft velocities relative to the planet frame (inertial)
+
+    PairStates pairStates;                //!< access quantities at this update
+    PairStates previousPairStates;        //!< access quantities at the previous update
+    uint64_t previousClock;               //!< [ns] time of the previous update
+    bool hasPreviousStates;               //!< true if previousPairStates holds the pairs of an earlier update
+};
+
+
+#endif
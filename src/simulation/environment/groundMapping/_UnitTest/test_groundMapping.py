@@ -118,5 +118,64 @@ def groundMappingTestFunction():
     return [testFailCount, "".join(testMessages)]
 
 
+def test_groundMappingVisiblePointsOnly():
+    r"""
+    This test checks that computing only the mapping points that may see the spacecraft gives the same access as
+    computing all of them.  A few thousand points are spread over a sphere and seen by a spacecraft pointing its
+    instrument at the planet center.  The access of every point and the elevation of the points with access must
+    match those of a module computing all points, while most points are not computed.
+    """
+    planetRadius = 6378.1363e3
+    numPoints = 3000
+    # Fibonacci sphere of mapping points
+    indices = np.arange(numPoints) + 0.5
+    latitudes = np.arcsin(1. - 2. * indices / numPoints)
+    longitudes = np.pi * (1. + 5. ** 0.5) * indices
+    points = planetRadius * np.column_stack([np.cos(latitudes) * np.cos(longitudes),
+                                             np.cos(latitudes) * np.sin(longitudes),
+                                             np.sin(latitudes)])
+
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    testProc = unitTestSim.CreateNewProcess("TestProcess")
+    testProc.addTask(unitTestSim.CreateNewTask("unitTask", macros.sec2nano(1.)))
+
+    scStateInMsgData = messaging.SCStatesMsgPayload()
+    scStateInMsgData.r_BN_N = [0., -planetRadius - 600e3, 0.]
+    scStateInMsgData.sigma_BN = [0., 0., 0.]
+    scStateInMsg = messaging.SCStatesMsg().write(scStateInMsgData)
+
+    mapLogs = []
+    for visiblePointsOnly in [False, True]:
+        groundMap = groundMapping.GroundMapping()
+        groundMap.ModelTag = "groundMapping" + str(visiblePointsOnly)
+        for point in points:
+            groundMap.addPointToModel(point)
+        groundMap.minimumElevation = np.radians(10.)
+        groundMap.maximumRange = 1e9
+        groundMap.nHat_B = [0, 1, 0]
+        groundMap.halfFieldOfView = np.radians(60.)
+        groundMap.visiblePointsOnly = visiblePointsOnly
+        groundMap.scStateInMsg.subscribeTo(scStateInMsg)
+        unitTestSim.AddModelToTask("unitTask", groundMap)
+        mapLogs.append([msg.recorder() for msg in groundMap.accessOutMsgs])
+        for mapLog in mapLogs[-1]:
+            unitTestSim.AddModelToTask("unitTask", mapLog)
+
+    unitTestSim.InitializeSimulation()
+    unitTestSim.ConfigureStopTime(macros.sec2nano(1.0))
+    unitTestSim.ExecuteSimulation()
+
+    allAccess = np.array([mapLog.hasAccess[-1] for mapLog in mapLogs[0]])
+    visibleAccess = np.array([mapLog.hasAccess[-1] for mapLog in mapLogs[1]])
+    allElevation = np.array([mapLog.elevation[-1] for mapLog in mapLogs[0]])
+    visibleElevation = np.array([mapLog.elevation[-1] for mapLog in mapLogs[1]])
+    assert np.sum(allAccess) > 0
+    np.testing.assert_array_equal(visibleAccess, allAccess)
+    np.testing.assert_array_equal(visibleElevation[allAccess == 1], allElevation[allAccess == 1])
+    # only the points near the spacecraft are computed
+    assert np.count_nonzero(visibleElevation) < numPoints / 4
+
+
 if __name__ == "__main__":
     test_groundMapping()
+    test_groundMappingVisiblePointsOnly()
@@ -22,6 +22,7 @@
 #include "architecture/utilities/avsEigenSupport.h"
 #include "architecture/utilities/linearAlgebra.h"
 #include "architecture/utilities/rigidBodyKinematics.h"
+#include <algorithm>
 #include <iostream>
 #include <math.h>
 
@@ -35,6 +36,9 @@ GroundMapping::GroundMapping()
     this->halfFieldOfView = 10.*D2R;  // [rad] half-angle field-of-view of the instrument
     this->cameraPos_B.setZero(3);  // Default to zero
     this->nHat_B.setZero(3);  // Default to zero
+    this->visiblePointsOnly = false;
+    this->minimumPointRadius = 0.0;
+    this->pointIndexStale = true;
 
     this->planetInMsgBuffer = this->planetInMsg.zeroMsgPayload;
     this->planetInMsgBuffer.J20002Pfix[0][0] = 1;
@@ -67,6 +71,12 @@ void GroundMapping::Reset(uint64_t CurrentSimNanos)
     if (this->nHat_B.isZero()){
         bskLogger.bskLog(BSK_ERROR, "GroundMapping.nHat_B vector not set.");
     }
+
+    // the mapping points are indexed again at the first update
+    this->pointIndexStale = true;
+    this->visiblePoints.clear();
+    this->hiddenPoints.clear();
+    this->isVisiblePoint.clear();
 }
 
 /*! Read module messages
@@ -85,8 +95,9 @@ void GroundMapping::ReadMessages(){
  * @param r_LP_P_init: mapping point in planet-fixed frame
  */
 void GroundMapping::addPointToModel(Eigen::Vector3d& r_LP_P_init){
-    /* Add the mapping point */
+    /* Add the mapping point, which the point index does not hold yet */
     this->mappingPoints.push_back(r_LP_P_init);
+    this->pointIndexStale = true;
 
     /* Create buffer output messages */
     Message<AccessMsgPayload> *msg;
@@ -202,14 +213,82 @@ uint64_t GroundMapping::checkInstrumentFOV(){
     }
 }
 
+/*! Method to find the mapping points that may see the spacecraft above the minimum elevation.  These points lie in
+ a cap of the planet surface around the spacecraft, which is widest for the mapping point closest to the planet center.
+ The points of the tiles of the point index that overlap this cap are kept in visiblePoints, and the points that left
+ them since the previous update in hiddenPoints.
+ */
+void GroundMapping::findVisiblePoints()
+{
+    //! - Index the mapping points, again if they changed since the last update
+    if (this->pointIndexStale) {
+        this->pointIndex.build(this->mappingPoints);
+        this->pointIndexStale = false;
+        this->minimumPointRadius = INFINITY;
+        for (const auto& point : this->mappingPoints) {
+            this->minimumPointRadius = std::min(this->minimumPointRadius, point.norm());
+        }
+        this->isVisiblePoint.assign(this->mappingPoints.size(), false);
+        this->visiblePoints.clear();
+    }
+
+    //! - Central angle between the spacecraft and the farthest point seeing it at the minimum elevation
+    Eigen::Vector3d r_BP_P = this->dcm_PN * this->r_BP_N;
+    double capAngle = M_PI;
+    double cosCapEdge = this->minimumPointRadius * cos(this->minimumElevation) / r_BP_P.norm();
+    if (this->minimumElevation > -M_PI_2 && cosCapEdge < 1.0) {
+        capAngle = safeAcos(cosCapEdge) - this->minimumElevation;
+    }
+
+    this->previousVisiblePoints.swap(this->visiblePoints);
+    this->visiblePoints.clear();
+    for (auto c : this->previousVisiblePoints) {
+        this->isVisiblePoint[c] = false;
+    }
+    this->pointIndex.findCandidates(r_BP_P, capAngle, this->candidateRanges);
+    const std::vector<uint32_t> &order = this->pointIndex.getOrder();
+    for (const auto& range : this->candidateRanges) {
+        for (size_t position = range.begin; position < range.end; position++) {
+            this->visiblePoints.push_back(order[position]);
+            this->isVisiblePoint[order[position]] = true;
+        }
+    }
+    this->hiddenPoints.clear();
+    for (auto c : this->previousVisiblePoints) {
+        if (!this->isVisiblePoint[c]) {
+            this->hiddenPoints.push_back(c);
+        }
+    }
+}
+
+/*! write the access and ground state messages of a mapping point
+ * @param c: index of the given location
+ * @param CurrentClock: [ns] current simulation time
+*/
+void GroundMapping::writePointMessages(uint64_t c, uint64_t CurrentClock)
+{
+    this->accessOutMsgs.at(c)->write(&this->accessMsgBuffer.at(c), this->moduleID, CurrentClock);
+    this->currentGroundStateOutMsgs.at(c)->write(&this->currentGroundStateMsgBuffer.at(c), this->moduleID, CurrentClock);
+}
+
 /*! write module messages
 */
 void GroundMapping::WriteMessages(uint64_t CurrentClock)
 {
+    if (this->visiblePointsOnly) {
+        //! - write the messages of the points in the visible cap, and of the points that just left it
+        for (auto c : this->visiblePoints) {
+            this->writePointMessages(c, CurrentClock);
+        }
+        for (auto c : this->hiddenPoints) {
+            this->writePointMessages(c, CurrentClock);
+        }
+        return;
+    }
+
     //! - write access message for each spacecraft
     for (long unsigned int c=0; c< this->accessMsgBuffer.size(); c++) {
-        this->accessOutMsgs.at(c)->write(&this->accessMsgBuffer.at(c), this->moduleID, CurrentClock);
-        this->currentGroundStateOutMsgs.at(c)->write(&this->currentGroundStateMsgBuffer.at(c), this->moduleID, CurrentClock);
+        this->writePointMessages(c, CurrentClock);
     }
 
 }
@@ -225,9 +304,22 @@ void GroundMapping::UpdateState(uint64_t CurrentSimNanos)
     // Update the inertial positions
     this->updateInertialPositions();
 
-    // Loop through each mapping point and perform computations
-    for (long unsigned int c = 0; c < this->mappingPoints.size(); c++) {
-        this->computeAccess(c);
+    if (this->visiblePointsOnly) {
+        // Only compute the points that may see the spacecraft, and zero the messages of the points that left them
+        this->findVisiblePoints();
+        for (auto c : this->visiblePoints) {
+            this->computeAccess(c);
+        }
+        for (auto c : this->hiddenPoints) {
+            this->accessMsgBuffer.at(c) = this->accessOutMsgs.at(c)->zeroMsgPayload;
+            this->currentGroundStateMsgBuffer.at(c) = this->currentGroundStateOutMsgs.at(c)->zeroMsgPayload;
+        }
+    }
+    else {
+        // Loop through each mapping point and perform computations
+        for (long unsigned int c = 0; c < this->mappingPoints.size(); c++) {
+            this->computeAccess(c);
+        }
     }
 
     // Write output messages
@@ -35,6 +35,7 @@
 
 #include "architecture/utilities/geodeticConversion.h"
 #include "architecture/utilities/astroConstants.h"
+#include "simulation/environment/_GeneralModuleFiles/planetSurfaceIndex.h"
 
 /*! @brief This module checks that a vector of mapping points are visible to a spacecraft's imager, outputting a vector
  * of accessMessages for each mapping point
@@ -54,6 +55,8 @@ private:
     void WriteMessages(uint64_t CurrentClock);
     void updateInertialPositions();
     uint64_t checkInstrumentFOV();
+    void findVisiblePoints();
+    void writePointMessages(uint64_t c, uint64_t CurrentClock);
 
 public:
     double minimumElevation; //!< [rad] (optional) minimum elevation above the local horizon needed to see a spacecraft; defaults to 10 degrees equivalent.
@@ -61,6 +64,7 @@ public:
     Eigen::Vector3d cameraPos_B;  //!< [m] (optional) Instrument position in body frame, defaults to (0,0,0)
     double halfFieldOfView;  //!< [r] Instrument half-fov, defaults to 10 degrees
     Eigen::Vector3d nHat_B;  //!< [-] Instrument unit direction vector in body frame components
+    bool visiblePointsOnly;  //!< (optional) Only compute and write the points above the minimum elevation cap, defaults to false
 
     BSKLogger bskLogger;              //!< -- BSK Logging
 
@@ -76,6 +80,14 @@ private:
     SpicePlanetStateMsgPayload planetInMsgBuffer;                         //!< buffer of planet data
 
     std::vector<Eigen::Vector3d> mappingPoints;  //!< Vector of mapping points
+    PlanetSurfaceIndex pointIndex;  //!< Spatial index of the mapping points
+    bool pointIndexStale;  //!< True if the mapping points changed since the point index was built
+    double minimumPointRadius;  //!< [m] Smallest distance of the mapping points to the planet center
+    std::vector<PlanetSurfaceIndex::IndexRange> candidateRanges;  //!< Ranges of the indexed points in the visible cap
+    std::vector<uint64_t> visiblePoints;  //!< Points in the visible cap at this update
+    std::vector<uint64_t> previousVisiblePoints;  //!< Points in the visible cap at the previous update
+    std::vector<uint64_t> hiddenPoints;  //!< Points that left the visible cap at this update
+    std::vector<bool> isVisiblePoint;  //!< True for the points in the visible cap
     Eigen::Matrix3d dcm_LP; //!< Rotation matrix from planet-centered, planet-fixed frame P to site-local topographic (SEZ) frame L coordinates.
     Eigen::Matrix3d dcm_PN; //!< Rotation matrix from inertial frame N to planet-centered to planet-fixed frame P.
     Eigen::Matrix3d dcm_PN_dot; //!< Rotation matrix derivative from inertial frame N to planet-centered to planet-fixed frame P.
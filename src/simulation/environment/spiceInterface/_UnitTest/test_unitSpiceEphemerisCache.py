@@ -0,0 +1,140 @@
+# ISC License
+#
+# Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+from Basilisk import __path__
+from Basilisk.simulation import spiceInterface
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+bskPath = __path__[0]
+
+planetNames = ["earth", "moon", "sun"]
+simulationHours = 24.
+startTime = "2021 March 12, 04:30:00.0 TDB"
+
+
+def runSpice(cacheDuration=0., loadFile=None, saveFile=None, utcCalInit=startTime, hours=simulationHours):
+    scSim = SimulationBaseClass.SimBaseClass()
+    process = scSim.CreateNewProcess("spiceProcess")
+    process.addTask(scSim.CreateNewTask("spiceTask", macros.sec2nano(60.)))
+
+    spiceObject = spiceInterface.SpiceInterface()
+    spiceObject.ModelTag = "spice"
+    spiceObject.SPICEDataPath = bskPath + '/supportData/EphemerisData/'
+    spiceObject.addPlanetNames(spiceInterface.StringVector(planetNames))
+    spiceObject.UTCCalInit = utcCalInit
+    spiceObject.ephemerisCacheDuration = cacheDuration
+    if loadFile is not None:
+        assert spiceObject.loadEphemerisCache(loadFile)
+    scSim.AddModelToTask("spiceTask", spiceObject)
+
+    dataLogs = [msg.recorder() for msg in spiceObject.planetStateOutMsgs]
+    for dataLog in dataLogs:
+        scSim.AddModelToTask("spiceTask", dataLog)
+    timeLog = spiceObject.logger("julianDateCurrent")
+    scSim.AddModelToTask("spiceTask", timeLog)
+
+    scSim.InitializeSimulation()
+    if saveFile is not None:
+        assert spiceObject.saveEphemerisCache(saveFile)
+    scSim.ConfigureStopTime(macros.hour2nano(hours))
+    scSim.ExecuteSimulation()
+
+    return dataLogs, timeLog
+
+
+def test_unitSpiceEphemerisCache(tmp_path):
+    r"""
+    **Validation Test Description**
+
+    The states of the Earth, Moon and Sun and the orientation of the Earth are read from SPICE over a day, then
+    from an ephemeris cache fitted at Reset, and from the same cache saved to and loaded from a file.
+
+    **Description of Variables Being Tested**
+
+    The cached positions must match SPICE within 1e-11 of their distance to the solar system barycenter, the
+    velocities within 1e-6 m/s and the Earth orientation within 1e-10.  The states read from the loaded file must
+    match the fitted cache exactly.
+    """
+    cacheFile = str(tmp_path / "ephemerides.bin")
+    spiceLogs, _ = runSpice()
+    cacheLogs, _ = runSpice(cacheDuration=simulationHours * 3600., saveFile=cacheFile)
+    fileLogs, _ = runSpice(loadFile=cacheFile)
+
+    for spiceLog, cacheLog, fileLog in zip(spiceLogs, cacheLogs, fileLogs):
+        distance = np.max(np.linalg.norm(spiceLog.PositionVector, axis=1))
+        np.testing.assert_allclose(cacheLog.PositionVector, spiceLog.PositionVector, rtol=0, atol=1e-11 * distance)
+        np.testing.assert_allclose(cacheLog.VelocityVector, spiceLog.VelocityVector, rtol=0, atol=1e-6)
+        np.testing.assert_array_equal(fileLog.PositionVector, cacheLog.PositionVector)
+        np.testing.assert_array_equal(fileLog.VelocityVector, cacheLog.VelocityVector)
+
+    np.testing.assert_allclose(cacheLogs[0].J20002Pfix, spiceLogs[0].J20002Pfix, rtol=0, atol=1e-10)
+    np.testing.assert_allclose(cacheLogs[0].J20002Pfix_dot, spiceLogs[0].J20002Pfix_dot, rtol=0, atol=1e-14)
+    np.testing.assert_array_equal(fileLogs[0].J20002Pfix, cacheLogs[0].J20002Pfix)
+
+
+def test_unitSpiceEphemerisCacheThreads(tmp_path):
+    r"""
+    **Validation Test Description**
+
+    Several simulations load the same ephemeris cache file and run in parallel threads.
+
+    **Description of Variables Being Tested**
+
+    The states and orientations of every simulation must match those of a simulation run alone with the file.
+    """
+    cacheFile = str(tmp_path / "ephemerides.bin")
+    runSpice(cacheDuration=simulationHours * 3600., saveFile=cacheFile)
+    referenceLogs, _ = runSpice(loadFile=cacheFile)
+
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        threadLogs = list(executor.map(lambda _: runSpice(loadFile=cacheFile)[0], range(4)))
+
+    for dataLogs in threadLogs:
+        for dataLog, referenceLog in zip(dataLogs, referenceLogs):
+            np.testing.assert_array_equal(dataLog.PositionVector, referenceLog.PositionVector)
+            np.testing.assert_array_equal(dataLog.VelocityVector, referenceLog.VelocityVector)
+            np.testing.assert_array_equal(dataLog.J20002Pfix, referenceLog.J20002Pfix)
+
+
+def test_unitSpiceEphemerisCacheLeapSecond(tmp_path):
+    r"""
+    **Validation Test Description**
+
+    A simulation starting half an hour before the leap second of the end of 2016 reads its ephemerides from a
+    cache file, so that its Julian date is computed without SPICE.
+
+    **Description of Variables Being Tested**
+
+    The Julian date must match the one computed by SPICE within 1e-8 days, before and after the leap second.
+    """
+    cacheFile = str(tmp_path / "ephemerides.bin")
+    utcCalInit = "2016 December 31, 23:30:30.0 (UTC)"
+    _, spiceLog = runSpice(cacheDuration=3600., saveFile=cacheFile, utcCalInit=utcCalInit, hours=1.)
+    _, fileLog = runSpice(loadFile=cacheFile, utcCalInit=utcCalInit, hours=1.)
+
+    np.testing.assert_allclose(fileLog.julianDateCurrent, spiceLog.julianDateCurrent, rtol=0, atol=1e-8)
+
+
+if __name__ == "__main__":
+    import pathlib
+    import tempfile
+    test_unitSpiceEphemerisCache(pathlib.Path(tempfile.mkdtemp()))
+    test_unitSpiceEphemerisCacheThreads(pathlib.Path(tempfile.mkdtemp()))
+    test_unitSpiceEphemerisCacheLeapSecond(pathlib.Path(tempfile.mkdtemp()))
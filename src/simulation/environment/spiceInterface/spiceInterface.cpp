@@ -17,13 +17,21 @@
 
  */
 #include "simulation/environment/spiceInterface/spiceInterface.h"
+#include <algorithm>
 #include <sstream>
+#include <mutex>
 #include "../libs/cspice/include/SpiceUsr.h"
 #include <string.h>
 #include "architecture/utilities/simDefinitions.h"
 #include "architecture/utilities/macroDefinitions.h"
 #include "architecture/utilities/rigidBodyKinematics.h"
 
+namespace {
+    /*! CSPICE holds its kernel pool and error status in global variables, so the SPICE calls of all the
+     SpiceInterface instances of a process are made one at a time */
+    std::recursive_mutex spiceMutex;
+}
+
 /*! This constructor initializes the variables that spice uses.  Most of them are
  not intended to be changed, but a couple are user configurable.
  */
@@ -44,6 +52,14 @@ SpiceInterface::SpiceInterface()
     timeDataInit = false;
     JDGPSEpoch = 0.0;
     GPSEpochTime = "1980 January 6, 00:00:00.0";
+    ephemerisCacheDuration = 0.0;
+    ephemerisCacheTolerance = 1e-11;
+    ephemerisCacheLoaded = false;
+    deltetDeltaTA = 0.0;
+    deltetK = 0.0;
+    deltetEB = 0.0;
+    deltetM[0] = 0.0;
+    deltetM[1] = 0.0;
 
     referenceBase = "j2000";
     zeroBase = "SSB";
@@ -83,6 +99,7 @@ SpiceInterface::~SpiceInterface()
 
 void SpiceInterface::clearKeeper()
 {
+    std::lock_guard<std::recursive_mutex> lock(spiceMutex);
     kclear_c();
 }
 
@@ -98,8 +115,17 @@ void SpiceInterface::Reset(uint64_t CurrenSimNanos)
         bskLogger.bskLog(BSK_ERROR, "SPICE data path was not set.  No SPICE.");
         return;
     }
-    //!- Load the SPICE kernels if they haven't already been loaded
-    if(!this->SPICELoaded)
+    std::lock_guard<std::recursive_mutex> lock(spiceMutex);
+    //!- Load the SPICE kernels if they haven't already been loaded.  A loaded ephemeris cache replaces all
+    //!  kernels but the leap seconds, which are still used to convert the UTC times.
+    if(!this->SPICELoaded && this->ephemerisCacheLoaded)
+    {
+        if(loadSpiceKernel((char *)"naif0012.tls", this->SPICEDataPath.c_str())) {
+            bskLogger.bskLog(BSK_ERROR, "Unable to load %s", "naif0012.tls");
+        }
+        this->SPICELoaded = true;
+    }
+    else if(!this->SPICELoaded)
     {
         if(loadSpiceKernel((char *)"naif0012.tls", this->SPICEDataPath.c_str())) {
             bskLogger.bskLog(BSK_ERROR, "Unable to load %s", "naif0012.tls");
@@ -148,6 +174,9 @@ void SpiceInterface::Reset(uint64_t CurrenSimNanos)
     }
     delete [] name;
 
+    //! - Fit or look up the ephemerides of the bodies in the ephemeris cache
+    this->prepareEphemerisCache(this->J2000ETInit + CurrenSimNanos*NANO2SEC);
+
     // - Call Update state so that the spice bodies are inputted into the messaging system on reset
     this->UpdateState(CurrenSimNanos);
 }
@@ -161,6 +190,7 @@ void SpiceInterface::Reset(uint64_t CurrenSimNanos)
 void SpiceInterface::initTimeData()
 {
     double EpochDelteET;
+    std::lock_guard<std::recursive_mutex> lock(spiceMutex);
 
     /* set epoch information.  If provided, then the epoch message information should be used.  */
     if (this->epochInMsg.isLinked()) {
@@ -184,6 +214,49 @@ void SpiceInterface::initTimeData()
     //! - Take the JD epoch and get the elapsed time for it
     deltet_c(this->JDGPSEpoch, "ET", &EpochDelteET);
 
+    //! - Get the terms of ET - UTC from the leap seconds kernel, used to compute the Julian date without SPICE
+    SpiceInt valueCount;
+    SpiceBoolean found;
+    SpiceChar valueType;
+    gdpool_c("DELTET/DELTA_T_A", 0, 1, &valueCount, &this->deltetDeltaTA, &found);
+    gdpool_c("DELTET/K", 0, 1, &valueCount, &this->deltetK, &found);
+    gdpool_c("DELTET/EB", 0, 1, &valueCount, &this->deltetEB, &found);
+    gdpool_c("DELTET/M", 0, 2, &valueCount, this->deltetM, &found);
+    dtpool_c("DELTET/DELTA_AT", &found, &valueCount, &valueType);
+    std::vector<double> deltaAT(found ? valueCount : 0);
+    if (!deltaAT.empty()) {
+        gdpool_c("DELTET/DELTA_AT", 0, valueCount, &valueCount, deltaAT.data(), &found);
+    }
+
+    //! - The kernel lists TAI - UTC with the UTC at which it starts, which is converted to ET as deltet_c does
+    this->leapSeconds.clear();
+    for (size_t i = 0; i + 1 < deltaAT.size(); i += 2) {
+        this->leapSeconds.emplace_back(deltaAT[i + 1] + deltaAT[i] + this->deltetDeltaTA, deltaAT[i]);
+    }
+}
+
+/*! This method computes the UTC Julian date of an ephemeris time as deltet_c and et2utc_c, with the
+ leap seconds of the kernel read at initTimeData, so that the date stays correct across a leap second.
+ It does not call SPICE, so simulations using a loaded ephemeris cache can run in parallel threads.
+ @return double Julian date
+ @param ephemerisTime [s] ephemeris time
+ */
+double SpiceInterface::computeJulianDate(double ephemerisTime) const
+{
+    double meanAnomaly = this->deltetM[0] + this->deltetM[1]*ephemerisTime;
+    double eccentricAnomaly = meanAnomaly + this->deltetEB*sin(meanAnomaly);
+
+    // TAI - UTC of the last leap second before the time, or of the first one for earlier times
+    double taiMinusUtc = 0.0;
+    if (!this->leapSeconds.empty()) {
+        auto next = std::upper_bound(this->leapSeconds.begin(), this->leapSeconds.end(), ephemerisTime,
+                                     [](double time, const std::pair<double, double> &leapSecond) {
+                                         return time < leapSecond.first;
+                                     });
+        taiMinusUtc = (next == this->leapSeconds.begin() ? next : next - 1)->second;
+    }
+    double deltaET = this->deltetDeltaTA + taiMinusUtc + this->deltetK*sin(eccentricAnomaly);
+    return 2451545.0 + (ephemerisTime - deltaET)/86400.0;
 }
 
 /*! This method computes the GPS time data for the current elapsed time.  It uses
@@ -265,15 +338,21 @@ void SpiceInterface::UpdateState(uint64_t CurrentSimNanos)
     //! - Increment the J2000 elapsed time based on init value and Current sim
     this->J2000Current = this->J2000ETInit + CurrentSimNanos*NANO2SEC;
 
-    //! - Compute the current Julian Date string and cast it over to the double
-    et2utc_c(this->J2000Current, "J", 14, this->charBufferSize - 1, reinterpret_cast<SpiceChar*>
-             (this->spiceBuffer));
-    std::string localString = reinterpret_cast<char*> (&this->spiceBuffer[3]);
-    this->julianDateCurrent = std::stod(localString);
+    //! - Compute the current Julian Date string and cast it over to the double.  With a loaded ephemeris
+    //!   cache, it is computed without SPICE.
+    if (this->ephemerisCacheLoaded) {
+        this->julianDateCurrent = this->computeJulianDate(this->J2000Current);
+    } else {
+        std::lock_guard<std::recursive_mutex> lock(spiceMutex);
+        et2utc_c(this->J2000Current, "J", 14, this->charBufferSize - 1, reinterpret_cast<SpiceChar*>
+                 (this->spiceBuffer));
+        std::string localString = reinterpret_cast<char*> (&this->spiceBuffer[3]);
+        this->julianDateCurrent = std::stod(localString);
+    }
     //! Get GPS and Planet data and then write the message outputs
     this->computeGPSData();
-    this->pullSpiceData(&this->planetData);
-    this->pullSpiceData(&this->scData);
+    this->pullSpiceData(&this->planetData, &this->planetSeries);
+    this->pullSpiceData(&this->scData, &this->scSeries);
     this->writeOutputMessages(CurrentSimNanos);
 }
 
@@ -313,6 +392,7 @@ void SpiceInterface::addPlanetNames(std::vector<std::string> planetNames) {
     spacecraft state output messages and the vector of spacecraft state message payloads */
 void SpiceInterface::addSpacecraftNames(std::vector<std::string> spacecraftNames) {
     std::vector<std::string>::iterator it;
+    std::lock_guard<std::recursive_mutex> lock(spiceMutex);
     SpiceChar *name = new SpiceChar[this->charBufferSize];
     SpiceBoolean frmFound;
     SpiceInt frmCode;
@@ -371,61 +451,258 @@ void SpiceInterface::addSpacecraftNames(std::vector<std::string> spacecraftNames
  @return void
  */
 void SpiceInterface::pullSpiceData(std::vector<SpicePlanetStateMsgPayload> *spiceData)
+{
+    this->pullSpiceData(spiceData, nullptr);
+}
+
+/*! This method gets the state of each spice item from the ephemeris cache, or from the
+ SPICE kernels if the cache does not hold the item at the current time.
+ @return void
+ @param spiceData bodies to update
+ @param cachedSeries cache series of the bodies, or nullptr to only use the SPICE kernels
+ */
+void SpiceInterface::pullSpiceData(std::vector<SpicePlanetStateMsgPayload> *spiceData,
+                                   const std::vector<CachedSeries> *cachedSeries)
 {
     std::vector<SpicePlanetStateMsgPayload>::iterator planit;
 
     /*! - Loop over the vector of Spice objects and compute values.
 
-     -# Call the Ephemeris file (spkezr)
+     -# Evaluate the ephemeris cache, which is in meters, or call the Ephemeris file (spkezr)
      -# Copy out the position and velocity values (default in km)
      -# Convert the pos/vel over to meters.
      -# Time stamp the message appropriately
      */
-    int c = 0; // celestial body counter
+    // The cache is read-only and may be shared with other modules, so it is evaluated without a lock
+    const ChebyshevEphemerisCache *cache = this->ephemerisCache.get();
+    size_t c = 0; // celestial body counter
     for(planit = spiceData->begin(); planit != spiceData->end(); planit++)
     {
         double lighttime;
         double localState[6];
-        std::string planetFrame = "";
-
-        spkezr_c(planit->PlanetName, this->J2000Current, this->referenceBase.c_str(),
-            "NONE", this->zeroBase.c_str(), localState, &lighttime);
-        v3Copy(&localState[0], planit->PositionVector);
-        v3Copy(&localState[3], planit->VelocityVector);
-        v3Scale(1000., planit->PositionVector, planit->PositionVector);
-        v3Scale(1000., planit->VelocityVector, planit->VelocityVector);
-        planit->J2000Current = this->J2000Current;
-        /* use default IAU planet frame name */
-        planetFrame = "IAU_";
-        planetFrame += planit->PlanetName;
+        CachedSeries series;
+        if (cachedSeries != nullptr && c < cachedSeries->size()) {
+            series = cachedSeries->at(c);
+        }
 
-        /* use specific planet frame if specified */
-        if (this->planetFrames.size() > 0) {
-            if (c < this->planetFrames.size()) {
-                if (this->planetFrames[c].length() > 0){
-                    /* use custom planet frame name */
-                    planetFrame = this->planetFrames[c];
-                }
-            }
+        if (cache != nullptr && cache->evaluate(series.state, this->J2000Current, localState)) {
+            v3Copy(&localState[0], planit->PositionVector);
+            v3Copy(&localState[3], planit->VelocityVector);
+        } else {
+            std::lock_guard<std::recursive_mutex> lock(spiceMutex);
+            spkezr_c(planit->PlanetName, this->J2000Current, this->referenceBase.c_str(),
+                "NONE", this->zeroBase.c_str(), localState, &lighttime);
+            v3Copy(&localState[0], planit->PositionVector);
+            v3Copy(&localState[3], planit->VelocityVector);
+            v3Scale(1000., planit->PositionVector, planit->PositionVector);
+            v3Scale(1000., planit->VelocityVector, planit->VelocityVector);
         }
+        planit->J2000Current = this->J2000Current;
 
         if(planit->computeOrient)
         {
             //pxform_c ( referenceBase.c_str(), planetFrame.c_str(), J2000Current,
             //    planit->second.J20002Pfix);
 
-            double aux[6][6];
+            double orientation[18];
+            if (cache != nullptr && cache->evaluate(series.orientation, this->J2000Current, orientation)) {
+                memcpy(planit->J20002Pfix, &orientation[0], sizeof(planit->J20002Pfix));
+                memcpy(planit->J20002Pfix_dot, &orientation[9], sizeof(planit->J20002Pfix_dot));
+            } else {
+                double aux[6][6];
+                std::string planetFrame = this->getFrameName(c, *planit);
+                std::lock_guard<std::recursive_mutex> lock(spiceMutex);
 
-            sxform_c(this->referenceBase.c_str(), planetFrame.c_str(), this->J2000Current, aux); //returns attitude of planet (i.e. IAU_EARTH) wrt "j2000". note j2000 is actually ICRF in Spice.
+                sxform_c(this->referenceBase.c_str(), planetFrame.c_str(), this->J2000Current, aux); //returns attitude of planet (i.e. IAU_EARTH) wrt "j2000". note j2000 is actually ICRF in Spice.
 
-            m66Get33Matrix(0, 0, aux, planit->J20002Pfix);
+                m66Get33Matrix(0, 0, aux, planit->J20002Pfix);
 
-            m66Get33Matrix(1, 0, aux, planit->J20002Pfix_dot);
+                m66Get33Matrix(1, 0, aux, planit->J20002Pfix_dot);
+            }
         }
         c++;
     }
 }
 
+/*! This method returns the name of the frame of a body, which is IAU_ + body name unless
+ a frame name is set in planetFrames.
+ @return std::string frame name
+ @param bodyIndex index of the body in its vector of bodies
+ @param body body state
+ */
+std::string SpiceInterface::getFrameName(size_t bodyIndex, const SpicePlanetStateMsgPayload &body) const
+{
+    /* use specific planet frame if specified */
+    if (bodyIndex < this->planetFrames.size() && this->planetFrames[bodyIndex].length() > 0) {
+        return this->planetFrames[bodyIndex];
+    }
+    /* use default IAU planet frame name */
+    return std::string("IAU_") + body.PlanetName;
+}
+
+/*! This method returns the name of the ephemeris cache series holding the state of a body, which
+ depends on the zero point and reference frame of the states.
+ @return std::string series name
+ @param body body state
+ */
+std::string SpiceInterface::getStateSeriesName(const SpicePlanetStateMsgPayload &body) const
+{
+    return std::string(body.PlanetName) + "@" + this->zeroBase + "/" + this->referenceBase;
+}
+
+/*! This method returns the name of the ephemeris cache series holding the orientation of a frame.
+ @return std::string series name
+ @param frameName name of the frame
+ */
+std::string SpiceInterface::getOrientationSeriesName(const std::string &frameName) const
+{
+    return this->referenceBase + "->" + frameName;
+}
+
+/*! This method fits the ephemerides of the bodies over ephemerisCacheDuration, unless the cache
+ already holds them or was loaded from a file, and looks up the cache series used by pullSpiceData.
+ @return void
+ @param startTime [s] ephemeris time of the start of the simulation
+ */
+void SpiceInterface::prepareEphemerisCache(double startTime)
+{
+    this->planetSeries.assign(this->planetData.size(), CachedSeries());
+    this->scSeries.assign(this->scData.size(), CachedSeries());
+    if (!this->ephemerisCacheLoaded) {
+        if (this->ephemerisCacheDuration <= 0.0) {
+            return;
+        }
+        // A cache is never modified once it is used, the fits are added to a copy
+        std::shared_ptr<ChebyshevEphemerisCache> cache = this->ephemerisCache
+            ? std::make_shared<ChebyshevEphemerisCache>(*this->ephemerisCache)
+            : std::make_shared<ChebyshevEphemerisCache>();
+        cache->relativeTolerance = this->ephemerisCacheTolerance;
+        double endTime = startTime + this->ephemerisCacheDuration;
+        this->fitEphemerides(*cache, this->planetData, startTime, endTime);
+        this->fitEphemerides(*cache, this->scData, startTime, endTime);
+        this->ephemerisCache = cache;
+    }
+    this->findCachedSeries(this->planetData, this->planetSeries, startTime);
+    this->findCachedSeries(this->scData, this->scSeries, startTime);
+}
+
+/*! This method fits the states and orientations of the bodies that the cache does not hold over the
+ time span.
+ @return void
+ @param cache cache receiving the fits
+ @param spiceData bodies to fit
+ @param startTime [s] ephemeris time of the start of the fits
+ @param endTime [s] ephemeris time of the end of the fits
+ */
+void SpiceInterface::fitEphemerides(ChebyshevEphemerisCache &cache,
+                                    const std::vector<SpicePlanetStateMsgPayload> &spiceData,
+                                    double startTime, double endTime)
+{
+    for (size_t c = 0; c < spiceData.size(); c++) {
+        const SpicePlanetStateMsgPayload &body = spiceData[c];
+        std::string stateName = this->getStateSeriesName(body);
+        if (!cache.covers(cache.findSeries(stateName), startTime, endTime)) {
+            std::string planetName = body.PlanetName;
+            cache.fitSeries(stateName, 6, startTime, endTime, [&](double et, double *values) {
+                double lighttime;
+                spkezr_c(planetName.c_str(), et, this->referenceBase.c_str(), "NONE", this->zeroBase.c_str(),
+                         values, &lighttime);
+                for (int i = 0; i < 6; i++) {
+                    values[i] *= 1000.;
+                }
+            });
+        }
+
+        if (!body.computeOrient) {
+            continue;
+        }
+        std::string frameName = this->getFrameName(c, body);
+        std::string orientationName = this->getOrientationSeriesName(frameName);
+        if (!cache.covers(cache.findSeries(orientationName), startTime, endTime)) {
+            cache.fitSeries(orientationName, 18, startTime, endTime, [&](double et, double *values) {
+                double aux[6][6];
+                sxform_c(this->referenceBase.c_str(), frameName.c_str(), et, aux);
+                for (int i = 0; i < 3; i++) {
+                    for (int j = 0; j < 3; j++) {
+                        values[3*i + j] = aux[i][j];
+                        values[9 + 3*i + j] = aux[3 + i][j];
+                    }
+                }
+            });
+        }
+    }
+}
+
+/*! This method looks up the cache series of the bodies, and reports the bodies missing from a
+ loaded cache.
+ @return void
+ @param spiceData bodies to look up
+ @param cachedSeries cache series of the bodies
+ @param startTime [s] ephemeris time of the start of the simulation
+ */
+void SpiceInterface::findCachedSeries(const std::vector<SpicePlanetStateMsgPayload> &spiceData,
+                                      std::vector<CachedSeries> &cachedSeries, double startTime)
+{
+    for (size_t c = 0; c < spiceData.size(); c++) {
+        const SpicePlanetStateMsgPayload &body = spiceData[c];
+        std::string stateName = this->getStateSeriesName(body);
+        cachedSeries[c].state = this->ephemerisCache->findSeries(stateName);
+        if (this->ephemerisCacheLoaded && !this->ephemerisCache->covers(cachedSeries[c].state, startTime, startTime)) {
+            bskLogger.bskLog(BSK_WARNING, "spiceInterface: the ephemeris cache does not hold %s at the start of the "
+                             "simulation.  Its state is read from the SPICE kernels, which are not loaded.",
+                             stateName.c_str());
+        }
+
+        if (!body.computeOrient) {
+            continue;
+        }
+        std::string orientationName = this->getOrientationSeriesName(this->getFrameName(c, body));
+        cachedSeries[c].orientation = this->ephemerisCache->findSeries(orientationName);
+        if (this->ephemerisCacheLoaded &&
+            !this->ephemerisCache->covers(cachedSeries[c].orientation, startTime, startTime)) {
+            bskLogger.bskLog(BSK_WARNING, "spiceInterface: the ephemeris cache does not hold %s at the start of the "
+                             "simulation.  It is read from the SPICE kernels, which are not loaded.",
+                             orientationName.c_str());
+        }
+    }
+}
+
+/*! This method writes the ephemeris cache to a file, which can replace the SPICE kernels
+ in other simulations through loadEphemerisCache.  The cache is fitted at Reset if
+ ephemerisCacheDuration is positive.
+ @return bool true if the file was written
+ @param fileName path of the file
+ */
+bool SpiceInterface::saveEphemerisCache(std::string fileName)
+{
+    if (!this->ephemerisCache) {
+        bskLogger.bskLog(BSK_ERROR, "spiceInterface: the ephemeris cache is empty.  Set ephemerisCacheDuration "
+                         "and reset the simulation before saving the cache.");
+        return false;
+    }
+    return this->ephemerisCache->save(fileName);
+}
+
+/*! This method loads an ephemeris cache written by saveEphemerisCache.  The states and
+ orientations are then read from the cache, and only the leap seconds kernel is loaded at Reset.
+ The cache must hold the bodies, zeroBase, referenceBase and frames of this module.  A file is read
+ once per process, and its cache is shared read-only by all the modules loading it.
+ @return bool true if the file was read
+ @param fileName path of the file
+ */
+bool SpiceInterface::loadEphemerisCache(std::string fileName)
+{
+    std::shared_ptr<const ChebyshevEphemerisCache> cache = ChebyshevEphemerisCache::loadShared(fileName);
+    if (!cache) {
+        bskLogger.bskLog(BSK_WARNING, "spiceInterface: %s is not used.  The ephemerides are read from the SPICE "
+                         "kernels, and fitted at Reset if ephemerisCacheDuration is positive.", fileName.c_str());
+        return false;
+    }
+    this->ephemerisCache = cache;
+    this->ephemerisCacheLoaded = true;
+    return true;
+}
+
 /*! This method loads a requested SPICE kernel into the system memory.  It is
  its own method because we have to load several SPICE kernels in for our
  application.  Note that they are stored in the SPICE library and are not
@@ -436,6 +713,7 @@ void SpiceInterface::pullSpiceData(std::vector<SpicePlanetStateMsgPayload> *spic
  */
 int SpiceInterface::loadSpiceKernel(char *kernelName, const char *dataPath)
 {
+    std::lock_guard<std::recursive_mutex> lock(spiceMutex);
     char *fileName = new char[this->charBufferSize];
     SpiceChar *name = new SpiceChar[this->charBufferSize];
 
@@ -468,6 +746,7 @@ int SpiceInterface::loadSpiceKernel(char *kernelName, const char *dataPath)
  */
 int SpiceInterface::unloadSpiceKernel(char *kernelName, const char *dataPath)
 {
+    std::lock_guard<std::recursive_mutex> lock(spiceMutex);
     char *fileName = new char[this->charBufferSize];
     SpiceChar *name = new SpiceChar[this->charBufferSize];
 
@@ -499,6 +778,7 @@ std::string SpiceInterface::getCurrentTimeString()
 		return("");
 	}
 
+	std::lock_guard<std::recursive_mutex> lock(spiceMutex);
 	spiceOutputBuffer = new char[allowedOutputLength];
 	timout_c(this->J2000Current, this->timeOutPicture.c_str(), (SpiceInt) allowedOutputLength,
 		spiceOutputBuffer);
@@ -22,10 +22,13 @@
 
 #include <vector>
 #include <map>
+#include <memory>
+#include <utility>
 #include "architecture/_GeneralModuleFiles/sys_model.h"
 #include "architecture/utilities/linearAlgebra.h"
 #include "architecture/utilities/bskLogging.h"
 #include "architecture/utilities/avsEigenSupport.h"
+#include "simulation/environment/_GeneralModuleFiles/chebyshevEphemerisCache.h"
 
 #include "architecture/msgPayloadDefC/SpicePlanetStateMsgPayload.h"
 #include "architecture/msgPayloadDefC/SpiceTimeMsgPayload.h"
@@ -53,6 +56,8 @@ public:
     void clearKeeper();                         //!< class method
     void addPlanetNames(std::vector<std::string> planetNames);
     void addSpacecraftNames(std::vector<std::string> spacecraftNames);
+    bool saveEphemerisCache(std::string fileName);   //!< Writes the ephemeris cache fitted at Reset to a file
+    bool loadEphemerisCache(std::string fileName);   //!< Uses a cache file instead of the SPICE ephemeris kernels
 
 public:
     Message<SpiceTimeMsgPayload> spiceTimeOutMsg;    //!< spice time sampling output message
@@ -81,15 +86,46 @@ public:
     uint16_t GPSWeek;           //!< -- Current GPS week value
     uint64_t GPSRollovers;      //!< -- Count on the number of GPS rollovers
 
+    double ephemerisCacheDuration;  //!< [s] Time span fitted by the ephemeris cache at Reset, 0 to not use a cache
+    double ephemerisCacheTolerance; //!< -- Relative error of the positions and orientations of the ephemeris cache
+
     BSKLogger bskLogger;                      //!< -- BSK Logging
 
 private:
+    /*! Indices of the ephemeris cache series of a body, -1 if a series is not cached */
+    struct CachedSeries {
+        int64_t state = -1;        //!< Series of the position and velocity
+        int64_t orientation = -1;  //!< Series of J20002Pfix and J20002Pfix_dot
+    };
+
+    void pullSpiceData(std::vector<SpicePlanetStateMsgPayload> *spiceData,
+                       const std::vector<CachedSeries> *cachedSeries);
+    std::string getFrameName(size_t bodyIndex, const SpicePlanetStateMsgPayload &body) const;
+    std::string getStateSeriesName(const SpicePlanetStateMsgPayload &body) const;
+    std::string getOrientationSeriesName(const std::string &frameName) const;
+    void prepareEphemerisCache(double startTime);
+    void fitEphemerides(ChebyshevEphemerisCache &cache, const std::vector<SpicePlanetStateMsgPayload> &spiceData,
+                        double startTime, double endTime);
+    void findCachedSeries(const std::vector<SpicePlanetStateMsgPayload> &spiceData,
+                          std::vector<CachedSeries> &cachedSeries, double startTime);
+    double computeJulianDate(double ephemerisTime) const;
+
     std::string GPSEpochTime;   //!< -- String for the GPS epoch
     double JDGPSEpoch;          //!< s Epoch for GPS time.  Saved for efficiency
 
     std::vector<SpicePlanetStateMsgPayload> planetData;
     std::vector<SpicePlanetStateMsgPayload> scData;
 
+    std::shared_ptr<const ChebyshevEphemerisCache> ephemerisCache;  //!< Fitted or shared read-only ephemerides
+    bool ephemerisCacheLoaded;               //!< True if the ephemeris cache was loaded from a file
+    std::vector<CachedSeries> planetSeries;  //!< Cache series of the planets
+    std::vector<CachedSeries> scSeries;      //!< Cache series of the spacecraft
+    std::vector<std::pair<double, double>> leapSeconds;  //!< [s, s] ET at which each TAI - UTC starts, and its value
+    double deltetDeltaTA;                    //!< [s] Difference of TDT and TAI
+    double deltetK;                          //!< [s] Amplitude of the periodic term of ET - UTC
+    double deltetEB;                         //!< -- Eccentricity of the Earth-Moon barycenter orbit
+    double deltetM[2];                       //!< [rad, rad/s] Mean anomaly of the Earth-Moon barycenter at J2000 and its rate
+
 };
 
 
@@ -0,0 +1,158 @@
+/*
+ ISC License
+
+ Copyright (c) 2024, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include <cmath>
+#include <vector>
+#include <Eigen/Dense>
+#include "simulation/environment/_GeneralModuleFiles/planetSurfaceIndex.h"
+#include <gtest/gtest.h>
+
+namespace {
+    Eigen::Vector3d surfacePoint(double latitude, double longitude, double radius = 1.0)
+    {
+        return radius * Eigen::Vector3d(std::cos(latitude) * std::cos(longitude),
+                                        std::cos(latitude) * std::sin(longitude),
+                                        std::sin(latitude));
+    }
+
+    /*! Points every step radians of latitude and longitude, including the poles and the longitude of +-180 deg */
+    std::vector<Eigen::Vector3d> gridPoints(double step, double radius = 1.0)
+    {
+        std::vector<Eigen::Vector3d> points;
+        long latitudeCount = std::lround(M_PI / step);
+        long longitudeCount = std::lround(2.0 * M_PI / step);
+        for (long i = 0; i <= latitudeCount; i++) {
+            for (long j = 0; j <= longitudeCount; j++) {
+                points.push_back(surfacePoint(-M_PI_2 + i * step, -M_PI + j * step, radius));
+            }
+        }
+        return points;
+    }
+
+    /*! Marks the points returned by findCandidates, and checks that the ranges are sorted and do not overlap */
+    std::vector<bool> findCandidates(const PlanetSurfaceIndex &index, const Eigen::Vector3d &capCenter_P,
+                                     double capAngle)
+    {
+        std::vector<PlanetSurfaceIndex::IndexRange> ranges;
+        index.findCandidates(capCenter_P, capAngle, ranges);
+        std::vector<bool> isCandidate(index.getPointCount(), false);
+        size_t previousEnd = 0;
+        for (const auto &range : ranges) {
+            EXPECT_LT(range.begin, range.end);
+            EXPECT_LE(previousEnd, range.begin);
+            EXPECT_LE(range.end, index.getPointCount());
+            previousEnd = range.end;
+            for (size_t position = range.begin; position < range.end; position++) {
+                isCandidate[index.getOrder()[position]] = true;
+            }
+        }
+        return isCandidate;
+    }
+
+    /*! Checks that every point in the cap is a candidate, and returns the number of candidates */
+    size_t checkCap(const PlanetSurfaceIndex &index, const std::vector<Eigen::Vector3d> &points,
+                    const Eigen::Vector3d &capCenter_P, double capAngle)
+    {
+        std::vector<bool> isCandidate = findCandidates(index, capCenter_P, capAngle);
+        size_t candidateCount = 0;
+        for (size_t i = 0; i < points.size(); i++) {
+            double angle = std::acos(std::min(1.0, points[i].normalized().dot(capCenter_P.normalized())));
+            if (angle <= capAngle) {
+                EXPECT_TRUE(isCandidate[i]) << "point " << i << " at " << angle << " rad from the cap center";
+            }
+            candidateCount += isCandidate[i];
+        }
+        return candidateCount;
+    }
+}
+
+TEST(planetSurfaceIndex, testWrapAround) {
+    std::vector<Eigen::Vector3d> points = gridPoints(M_PI / 180.0);
+    PlanetSurfaceIndex index;
+    index.build(points);
+    ASSERT_EQ(index.getPointCount(), points.size());
+    ASSERT_GT(index.getTileCount(), 1u);
+
+    // Caps centered on both sides of the longitude of +-180 deg hold the points of both sides
+    for (double longitude : {M_PI - 0.01, -M_PI + 0.01, M_PI}) {
+        for (double latitude : {0.0, 0.7, -1.2}) {
+            size_t candidateCount = checkCap(index, points, surfacePoint(latitude, longitude), 0.1);
+            EXPECT_LT(candidateCount, points.size() / 10);
+        }
+    }
+}
+
+TEST(planetSurfaceIndex, testPolarCaps) {
+    std::vector<Eigen::Vector3d> points = gridPoints(M_PI / 180.0, 6378.0e3);
+    PlanetSurfaceIndex index;
+    index.build(points);
+
+    // Caps centered on the poles, and caps reaching over a pole from a lower latitude
+    checkCap(index, points, Eigen::Vector3d(0.0, 0.0, 1.0), 0.05);
+    checkCap(index, points, Eigen::Vector3d(0.0, 0.0, -1.0), 0.05);
+    checkCap(index, points, surfacePoint(M_PI_2 - 0.02, 2.0), 0.05);
+    checkCap(index, points, surfacePoint(-M_PI_2 + 0.02, -2.0), 0.05);
+
+    // A cap of pi holds all the points
+    EXPECT_EQ(checkCap(index, points, surfacePoint(0.3, 0.3), M_PI), points.size());
+}
+
+TEST(planetSurfaceIndex, testEmptyCaps) {
+    std::vector<PlanetSurfaceIndex::IndexRange> ranges;
+    PlanetSurfaceIndex index;
+    index.findCandidates(Eigen::Vector3d(1.0, 0.0, 0.0), M_PI, ranges);
+    EXPECT_TRUE(ranges.empty());
+
+    // Points of the northern hemisphere only
+    std::vector<Eigen::Vector3d> points;
+    for (const auto &point : gridPoints(M_PI / 90.0)) {
+        if (point[2] > 0.1) {
+            points.push_back(point);
+        }
+    }
+    index.build(points);
+    index.findCandidates(Eigen::Vector3d(0.0, 0.0, 1.0), -0.1, ranges);
+    EXPECT_TRUE(ranges.empty());
+    index.findCandidates(Eigen::Vector3d(0.0, 0.0, -1.0), 0.5, ranges);
+    EXPECT_TRUE(ranges.empty());
+
+    // A cap of no width holds the point at its center
+    EXPECT_GE(checkCap(index, points, points[points.size() / 2], 0.0), 1u);
+}
+
+TEST(planetSurfaceIndex, testRebuild) {
+    std::vector<Eigen::Vector3d> points = gridPoints(M_PI / 90.0);
+    PlanetSurfaceIndex index;
+    index.build(points);
+    Eigen::Vector3d capCenter_P = surfacePoint(0.2, 1.0);
+    checkCap(index, points, capCenter_P, 0.1);
+
+    // The same number of points in other places, which the index only finds once built again
+    std::vector<Eigen::Vector3d> movedPoints(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        movedPoints[i] = Eigen::Vector3d(points[i][1], points[i][2], points[i][0]);
+    }
+    index.build(movedPoints);
+    EXPECT_EQ(index.getPointCount(), movedPoints.size());
+    checkCap(index, movedPoints, capCenter_P, 0.1);
+
+    index.clear();
+    EXPECT_EQ(index.getPointCount(), 0u);
+    EXPECT_EQ(index.getTileCount(), 1u);
+}
@@ -410,6 +410,7 @@ class Controller:
 
         # The simulation executor is responsible for executing simulation given a simulation's parameters
         # It is called within worker threads with each worker's simulation parameters
+        # The workers are processes, for the reasons given in executeSimulations
         simulationExecutor = SimulationExecutor()
         #
         progressBar = SimulationProgressBar(len(caseList), self.simParams.showProgressBar)
@@ -614,6 +615,10 @@ class Controller:
 
         # The simulation executor is responsible for executing simulation given a simulation's parameters
         # It is called within worker threads with each worker's simulation parameters
+        # The workers are processes rather than threads of this process, even though the simulations release the
+        # Python interpreter lock while they run: each run seeds the global numpy and random generators that the
+        # dispersions draw from, so runs sharing a process would interleave their draws, and SIGINT can only be
+        # ignored from the main thread.
         simulationExecutor = SimulationExecutor()
 
         progressBar = SimulationProgressBar(numSims, self.simParams.showProgressBar)
@@ -61,11 +61,15 @@ class EventHandlerClass:
     def methodizeEvent(self):
         if self.checkCall != None:
             return
+        # native conditions and actions of sim_model are evaluated next to the Python strings
+        self.nativeConditions = [condValue for condValue in self.conditionList if not isinstance(condValue, str)]
+        self.nativeActions = [actionValue for actionValue in self.actionList if not isinstance(actionValue, str)]
         funcString = 'def EVENT_check_' + self.eventName + '(self):\n'
         funcString += '    if('
         for condValue in self.conditionList:
-            funcString += ' ' + condValue + ' and'
-        funcString = funcString[:-3] + '):\n'
+            if isinstance(condValue, str):
+                funcString += ' ' + condValue + ' and'
+        funcString += ' True):\n'
         funcString += '        return 1\n'
         funcString += '    return 0'
 
@@ -73,8 +77,9 @@ class EventHandlerClass:
         self.checkCall = eval('EVENT_check_' + self.eventName)
         funcString = 'def EVENT_operate_' + self.eventName + '(self):\n'
         for actionValue in self.actionList:
-            funcString += '    '
-            funcString += actionValue + '\n'
+            if isinstance(actionValue, str):
+                funcString += '    '
+                funcString += actionValue + '\n'
         funcString += '    return 0'
         exec (funcString)
         self.operateCall = eval('EVENT_operate_' + self.eventName)
@@ -88,9 +93,11 @@ class EventHandlerClass:
             nextTime = parentSim.TotalSim.CurrentNanos + self.eventRate
             eventCount = self.checkCall(parentSim)
             self.prevTime = parentSim.TotalSim.CurrentNanos
-            if eventCount > 0:
+            if eventCount > 0 and all(condValue.isTrue() for condValue in self.nativeConditions):
                 self.eventActive = False
                 self.operateCall(parentSim)
+                for actionValue in self.nativeActions:
+                    actionValue.execute()
                 self.occurCounter += 1
                 if self.terminal:
                     parentSim.terminate = True
@@ -441,13 +448,17 @@ class SimBaseClass:
         while self.TotalSim.NextTaskTime <= self.StopTime and not self.terminate:
             if self.TotalSim.CurrentNanos >= self.nextEventTime >= 0:
                 self.nextEventTime = self.checkEvents()
-                self.nextEventTime = self.nextEventTime if self.nextEventTime >= self.TotalSim.NextTaskTime else self.TotalSim.NextTaskTime
+                # native events are checked by TotalSim, only stop for the events handled in Python
+                if self.eventList:
+                    self.nextEventTime = self.nextEventTime if self.nextEventTime >= self.TotalSim.NextTaskTime else self.TotalSim.NextTaskTime
             if 0 <= self.nextEventTime < nextStopTime:
                 nextStopTime = self.nextEventTime
                 nextPriority = -1
             if self.terminate:
                 break
             self.TotalSim.StepUntilStop(nextStopTime, nextPriority)
+            if self.TotalSim.terminateSimulation:
+                self.terminate = True
             progressBar.update(self.TotalSim.NextTaskTime)
             nextPriority = -1
             nextStopTime = self.StopTime
@@ -505,16 +516,55 @@ class SimBaseClass:
                        conditionList=[], actionList=[], terminal=False):
         """
         Create an event sequence that contains a series of tasks to be executed.
+
+        The conditions and actions are either Python strings, evaluated with ``self`` being this simulation,
+        or native conditions and actions of ``sim_model``, such as the conditions returned by
+        ``sim_model.messageCondition()`` or the actions returned by :meth:`taskActivityAction`.  When all
+        of them are native, the event is checked by ``TotalSim`` inside the simulation stepping loop,
+        without returning to Python.  Otherwise the event is checked in Python and the native actions
+        are executed after the Python actions.
         """
         if (eventName in list(self.eventMap.keys())):
             return
-        newEvent = EventHandlerClass(eventName, eventRate, eventActive,
-                                     conditionList, actionList, terminal)
+        isNative = (len(conditionList) > 0 and
+                    all(isinstance(condValue, sim_model.EventCondition) for condValue in conditionList) and
+                    all(isinstance(actionValue, sim_model.EventAction) for actionValue in actionList))
+        if isNative:
+            newEvent = sim_model.SimEvent(eventName, eventRate)
+            newEvent.eventActive = eventActive
+            newEvent.terminal = terminal
+            for condValue in conditionList:
+                newEvent.addCondition(condValue)
+            for actionValue in actionList:
+                newEvent.addAction(actionValue)
+            self.TotalSim.addEvent(newEvent)
+        else:
+            newEvent = EventHandlerClass(eventName, eventRate, eventActive,
+                                         conditionList, actionList, terminal)
         self.eventMap.update({eventName: newEvent})
 
+    def taskActivityAction(self, taskName, enable):
+        """
+        Returns a native event action that enables or disables the task of the given name.
+        """
+        for Task in self.TaskList:
+            if Task.Name == taskName:
+                return sim_model.TaskActivityAction(Task.TaskData, enable)
+        raise ValueError("There is no task named " + taskName)
+
+    def eventActivityAction(self, eventName, activityCommand):
+        """
+        Returns a native event action that activates or deactivates the native event of the given name.
+        """
+        if not isinstance(self.eventMap.get(eventName), sim_model.SimEvent):
+            raise ValueError("There is no native event named " + eventName)
+        return sim_model.EventActivityAction(self.eventMap[eventName], activityCommand)
+
     def initializeEventChecks(self):
         self.eventList = []
         for key, value in self.eventMap.items():
+            if isinstance(value, sim_model.SimEvent):
+                continue
             value.methodizeEvent()
             self.eventList.append(value)
         self.nextEventTime = 0